@@ -67,11 +67,19 @@ module.exports = function(grunt) {
             "spec/support/java/function/build.gradle",
           ]
         },
+        buildServerFunctions: {
+          command: 'cd server/ && ./gradlew build',
+          src: [
+            "server/src/**/*.java",
+            "server/build.gradle",
+          ]
+        },
         deployTestFunction: {
           command: 'cd tmp/gemfire && gfsh run --file /vagrant/bin/deployTestFunction.gfsh',
           src: [
             'tmp/gemfire/server/vf.gf.server.pid',
-            'spec/support/java/function/build/libs/function.jar'
+            'spec/support/java/function/build/libs/function.jar',
+            'server/build/libs/node-gemfire-functions.jar'
           ]
         },
         lint: {
@@ -96,6 +104,9 @@ module.exports = function(grunt) {
         jasmine: {
           command: "./node_modules/jasmine/bin/jasmine.js"
         },
+        benchmark: {
+          command: "ls benchmark/*.js | grep -v support.js | xargs -n 1 node --expose-gc"
+        },
         release: {
           command: "./node_modules/.bin/node-pre-gyp rebuild package testpackage publish"
         },
@@ -107,7 +118,7 @@ module.exports = function(grunt) {
         options: {
           jshintrc: true
         },
-        all: ['Gruntfile.js', './*.js', 'spec/**/*.js']
+        all: ['Gruntfile.js', './*.js', 'spec/**/*.js', 'benchmark/**/*.js']
       }
     }
   );
@@ -124,6 +135,7 @@ module.exports = function(grunt) {
   grunt.registerTask('test', ['build', /*'shell:cppUnitTests',*/ 'server:ensure', 'server:deploy', 'shell:jasmine', 'locator:shutdown']);
   grunt.registerTask('lint', ['shell:lint', 'jshint']);
   grunt.registerTask('console', ['build', 'shell:console']);
+  grunt.registerTask('benchmark', ['build', 'server:ensure', 'shell:benchmark']);
   grunt.registerTask('license_finder', ['shell:licenseFinder']);
 
   grunt.registerTask('server:start', ['locator:ensure', 'shell:startServer']);
@@ -137,7 +149,7 @@ module.exports = function(grunt) {
   grunt.registerTask('locator:ensure', ['shell:ensureLocatorRunning']);
   grunt.registerTask('locator:shutdown', ['shell:shutdown']);
 
-  grunt.registerTask('server:deploy', ['newer:shell:buildTestFunction', 'newer:shell:deployTestFunction']);
+  grunt.registerTask('server:deploy', ['newer:shell:buildServerFunctions', 'newer:shell:buildTestFunction', 'newer:shell:deployTestFunction']);
 
   grunt.registerTask('valgrind', function() {
     grunt.log.writeln('Running with valgrind...');
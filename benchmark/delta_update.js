@@ -0,0 +1,75 @@
+#!/usr/bin/env node
+//
+// Compares changing two fields of a 40 field document with a full put() against update(), which
+// sends only the changed fields: the serialized size of what each one sends, and its throughput.
+// update() needs the UpdateFields function from server/ deployed.
+//
+// Usage: node --expose-gc benchmark/delta_update.js [entries] [iterations]
+
+const async = require("async");
+const support = require("./support.js");
+
+const entries = parseInt(process.argv[2] || "1000", 10);
+const iterations = parseInt(process.argv[3] || "5", 10);
+const fieldCount = 40;
+
+const cache = support.cache;
+const region = cache.getRegion("exampleProxyRegion");
+
+function document(i) {
+  const value = { id: "document" + i, version: 0 };
+  for (var field = 2; field < fieldCount; field++) {
+    value["field" + field] = "value of field " + field + " in document " + i;
+  }
+  return value;
+}
+
+function changes(i, version) {
+  return { version: version, field2: "changed in version " + version + " of document " + i };
+}
+
+const documents = [];
+for (var i = 0; i < entries; i++) {
+  documents.push(document(i));
+}
+
+console.log(JSON.stringify({
+  putSerializedSizeBytes: support.gemfire.serializedSize(documents[0]),
+  updateSerializedSizeBytes: support.gemfire.serializedSize(changes(0, 1))
+}));
+
+var version = 0;
+
+function eachDocument(fn, done) {
+  version++;
+  async.timesLimit(entries, 64, fn, done);
+}
+
+async.series([
+  function(next) { region.clear(next); },
+  function(next) {
+    async.timesLimit(entries, 64, function(i, done) {
+      region.put(i, documents[i], done);
+    }, next);
+  },
+  function(next) {
+    support.measure("full put", iterations, function(done) {
+      eachDocument(function(i, putDone) {
+        const value = documents[i];
+        Object.assign(value, changes(i, version));
+        region.put(i, value, putDone);
+      }, done);
+    }, function() { next(); });
+  },
+  function(next) {
+    support.measure("update", iterations, function(done) {
+      eachDocument(function(i, updateDone) {
+        region.update(i, changes(i, version), updateDone);
+      }, done);
+    }, function() { next(); });
+  },
+  function(next) { region.clear(next); }
+], function(error) {
+  if (error) { throw error; }
+  cache.close();
+});
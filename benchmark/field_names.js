@@ -0,0 +1,56 @@
+#!/usr/bin/env node
+//
+// Measures GC pressure while materializing large getAll() and query() results. Every object
+// shares one PDX type, so its field names are interned once and reused for every row.
+//
+// Usage: node --expose-gc benchmark/field_names.js [entries] [iterations]
+
+const async = require("async");
+const support = require("./support.js");
+
+const entries = parseInt(process.argv[2] || "100000", 10);
+const iterations = parseInt(process.argv[3] || "5", 10);
+const fieldCount = 40;
+
+const region = support.cache.getRegion("exampleProxyRegion");
+
+function document(i) {
+  const value = {};
+  for (var field = 0; field < fieldCount; field++) {
+    value["field" + field] = i + field;
+  }
+  return value;
+}
+
+const keys = [];
+const batch = {};
+for (var i = 0; i < entries; i++) {
+  const key = "fieldNames" + i;
+  keys.push(key);
+  batch[key] = document(i);
+}
+
+async.series([
+  function(next) { region.clear(next); },
+  function(next) { region.putAll(batch, next); },
+  function(next) {
+    support.measure("getAll", iterations, function(done) {
+      region.getAll(keys, done);
+    }, function() { next(); });
+  },
+  function(next) {
+    support.measure("query", iterations, function(done) {
+      region.query("field0 >= 0", function(error, response) {
+        if (!error) { response.toArray(); }
+        done(error);
+      });
+    }, function() { next(); });
+  },
+  function(next) {
+    console.log(JSON.stringify(support.gemfire.conversionStats()));
+    region.clear(next);
+  }
+], function(error) {
+  if (error) { throw error; }
+  support.cache.close();
+});
@@ -0,0 +1,80 @@
+#!/usr/bin/env node
+//
+// Compares getAsync() with and without the near cache on a skewed key distribution: most reads go
+// to a few hot keys, and the rest scan a key space larger than the cache.
+//
+// Usage: node --expose-gc benchmark/near_cache.js [operations] [iterations]
+
+const async = require("async");
+const support = require("./support.js");
+
+const operations = parseInt(process.argv[2] || "20000", 10);
+const iterations = parseInt(process.argv[3] || "5", 10);
+const concurrency = 256;
+const hotKeys = 100;
+const coldKeys = 20000;
+
+const cache = support.cache;
+const region = cache.getRegion("exampleProxyRegion");
+
+// Nine reads in ten go to a hot key.
+function keyOf(i) {
+  return i % 10 === 0 ? "cold" + (i % coldKeys) : "hot" + (i % hotKeys);
+}
+
+function run(done) {
+  var started = 0;
+  var finished = 0;
+  function next() {
+    if (finished === operations) {
+      done();
+      return;
+    }
+    if (started === operations) {
+      return;
+    }
+    region.getAsync(keyOf(started++)).then(function() {
+      finished++;
+      next();
+    }, done);
+  }
+  for (var i = 0; i < concurrency; i++) {
+    next();
+  }
+}
+
+function populate(next) {
+  const entries = {};
+  for (var i = 0; i < hotKeys; i++) {
+    entries["hot" + i] = { name: "hot", index: i, tags: ["a", "b", "c"] };
+  }
+  for (var j = 0; j < coldKeys; j++) {
+    entries["cold" + j] = { name: "cold", index: j, tags: ["a", "b", "c"] };
+  }
+  region.putAll(entries, next);
+}
+
+function measure(name) {
+  return function(next) {
+    support.measure(name, iterations, run, function() { next(); });
+  };
+}
+
+async.series([
+  function(next) { region.clear(next); },
+  populate,
+  measure("getAsync"),
+  function(next) {
+    region.setNearCache({ maxEntries: 1000 });
+    next();
+  },
+  measure("getAsync with near cache"),
+  function(next) {
+    console.log("near cache:", JSON.stringify(region.nearCacheStats()));
+    region.setNearCache(false);
+    region.clear(next);
+  }
+], function(error) {
+  if (error) { throw error; }
+  cache.close();
+});
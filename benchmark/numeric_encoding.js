@@ -0,0 +1,66 @@
+#!/usr/bin/env node
+//
+// Compares the "double" and "compact" number encodings: the serialized size of a numeric
+// document, the CPU time of putting and getting it, and getAll() over Number keys.
+//
+// Usage: node --expose-gc benchmark/numeric_encoding.js [entries] [iterations]
+
+const async = require("async");
+const support = require("./support.js");
+
+const entries = parseInt(process.argv[2] || "10000", 10);
+const iterations = parseInt(process.argv[3] || "5", 10);
+const fieldCount = 20;
+
+const cache = support.cache;
+const region = cache.getRegion("exampleProxyRegion");
+
+function document(i) {
+  const value = { price: i + 0.25 };
+  for (var field = 0; field < fieldCount; field++) {
+    value["field" + field] = i * fieldCount + field;
+  }
+  return value;
+}
+
+const keys = [];
+for (var i = 0; i < entries; i++) {
+  keys.push(i);
+}
+
+function measureEncoding(encoding, callback) {
+  cache.setConversionOptions({ numberEncoding: encoding, keyEncoding: encoding });
+  console.log(JSON.stringify({
+    encoding: encoding,
+    serializedSizeBytes: support.gemfire.serializedSize(document(1))
+  }));
+
+  async.series([
+    function(next) { region.clear(next); },
+    function(next) {
+      support.measure(encoding + " put", iterations, function(done) {
+        for (var i = 0; i < entries; i++) {
+          region.putSync(i, document(i));
+        }
+        done();
+      }, function() { next(); });
+    },
+    function(next) {
+      support.measure(encoding + " getAll", iterations, function(done) {
+        region.getAll(keys, done);
+      }, function() { next(); });
+    }
+  ], callback);
+}
+
+async.series([
+  function(next) { measureEncoding("double", next); },
+  function(next) { measureEncoding("compact", next); },
+  function(next) {
+    cache.setConversionOptions({ numberEncoding: "double", keyEncoding: "double" });
+    region.clear(next);
+  }
+], function(error) {
+  if (error) { throw error; }
+  cache.close();
+});
@@ -0,0 +1,74 @@
+#!/usr/bin/env node
+//
+// Compares get() and put() wrapped in a Promise with the native getAsync() and putAsync(), with a
+// fixed number of operations in flight.
+//
+// Usage: node --expose-gc benchmark/promise_api.js [operations] [iterations]
+
+const async = require("async");
+const support = require("./support.js");
+
+const operations = parseInt(process.argv[2] || "20000", 10);
+const iterations = parseInt(process.argv[3] || "5", 10);
+const concurrency = 256;
+
+const cache = support.cache;
+const region = cache.getRegion("exampleProxyRegion");
+
+function wrappedGet(key) {
+  return new Promise(function(resolve, reject) {
+    region.get(key, function(error, value) {
+      if (error) { reject(error); } else { resolve(value); }
+    });
+  });
+}
+
+function wrappedPut(key, value) {
+  return new Promise(function(resolve, reject) {
+    region.put(key, value, function(error) {
+      if (error) { reject(error); } else { resolve(); }
+    });
+  });
+}
+
+// Runs operation(i) for every i with at most `concurrency` promises pending at a time.
+function run(operation, done) {
+  var started = 0;
+  var finished = 0;
+  function next() {
+    if (finished === operations) {
+      done();
+      return;
+    }
+    if (started === operations) {
+      return;
+    }
+    operation(started++ % 1000).then(function() {
+      finished++;
+      next();
+    }, done);
+  }
+  for (var i = 0; i < concurrency; i++) {
+    next();
+  }
+}
+
+const value = { name: "value", count: 1 };
+
+function measure(name, operation) {
+  return function(next) {
+    support.measure(name, iterations, function(done) { run(operation, done); }, function() { next(); });
+  };
+}
+
+async.series([
+  function(next) { region.clear(next); },
+  measure("wrapped put", function(i) { return wrappedPut("key" + i, value); }),
+  measure("putAsync", function(i) { return region.putAsync("key" + i, value); }),
+  measure("wrapped get", function(i) { return wrappedGet("key" + i); }),
+  measure("getAsync", function(i) { return region.getAsync("key" + i); }),
+  function(next) { region.clear(next); }
+], function(error) {
+  if (error) { throw error; }
+  cache.close();
+});
@@ -0,0 +1,54 @@
+const PerformanceObserver = require("perf_hooks").PerformanceObserver;
+
+const gemfire = require("../spec/support/gemfire.js");
+gemfire.configure("xml/ExampleClient.xml", "./gfcpp.properties");
+
+exports.gemfire = gemfire;
+exports.cache = gemfire.getCache();
+
+// Runs fn(done) `iterations` times in sequence and reports wall time, garbage collections and
+// heap growth over the whole run.
+exports.measure = function measure(name, iterations, fn, callback) {
+  var gcCount = 0;
+  var gcMilliseconds = 0;
+  const observer = new PerformanceObserver(function(list) {
+    list.getEntries().forEach(function(entry) {
+      gcCount++;
+      gcMilliseconds += entry.duration;
+    });
+  });
+  observer.observe({ entryTypes: ["gc"] });
+
+  if (global.gc) { global.gc(); }
+  const heapBefore = process.memoryUsage().heapUsed;
+  const start = process.hrtime();
+
+  var remaining = iterations;
+  function next() {
+    if (remaining-- === 0) {
+      const elapsed = process.hrtime(start);
+      const heapAfter = process.memoryUsage().heapUsed;
+
+      // Give the observer a chance to deliver the last GC entries.
+      setImmediate(function() {
+        observer.disconnect();
+        const result = {
+          name: name,
+          iterations: iterations,
+          milliseconds: (elapsed[0] * 1e3 + elapsed[1] / 1e6).toFixed(1),
+          gcCount: gcCount,
+          gcMilliseconds: gcMilliseconds.toFixed(1),
+          heapGrowthBytes: heapAfter - heapBefore
+        };
+        console.log(JSON.stringify(result));
+        callback(result);
+      });
+      return;
+    }
+    fn(function(error) {
+      if (error) { throw error; }
+      next();
+    });
+  }
+  next();
+};
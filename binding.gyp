@@ -26,10 +26,25 @@
       "src/dependencies.cpp",
       "src/exceptions.cpp",
       "src/conversions.cpp",
+      "src/string_conversions.cpp",
+      "src/pdx_type_cache.cpp",
+      "src/field_name_cache.cpp",
+      "src/schema_registry.cpp",
+      "src/value_codec.cpp",
+      "src/message_pack.cpp",
+      "src/lz4.cpp",
+      "src/pdx_proxy.cpp",
+      "src/field_projection.cpp",
+      "src/decoded_value.cpp",
+      "src/staging_buffer.cpp",
+      "src/json.cpp",
       "src/cache.cpp",
       "src/region.cpp",
+      "src/region_cursor.cpp",
       "src/select_results.cpp",
       "src/gemfire_worker.cpp",
+      "src/gemfire_executor.cpp",
+      "src/promise_worker.cpp",
       "src/streaming_result_collector.cpp",
       "src/result_stream.cpp",
       "src/events.cpp",
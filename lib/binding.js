@@ -1,6 +1,11 @@
 const nodePreGyp = require('node-pre-gyp');
 const path = require('path');
 const EventEmitter = require('events').EventEmitter;
+const bulkChunking = require('./bulk_chunking.js');
+const readCombiner = require('./read_combiner.js');
+const nearCache = require('./near_cache.js');
+const writeBatcher = require('./write_batcher.js');
+const regionStreams = require('./region_streams.js');
 
 function inherits(target, source) {
   for (var key in source.prototype) {
@@ -64,7 +69,16 @@ module.exports = function binding(options) {
   delete gemfire.Cache;
   delete gemfire.CacheFactory;
   inherits(gemfire.Region, EventEmitter);
+  // Write batching wraps read combining, so that reads of buffered writes are answered first. Both
+  // go through bulk chunking for the getAll() and putAll() calls they make. The near cache sits
+  // between them: it only caches values read from the region, and its misses are combined.
+  bulkChunking.install(gemfire.Region);
+  readCombiner.install(gemfire.Region);
+  nearCache.install(gemfire.Region);
+  writeBatcher.install(gemfire.Region);
+  regionStreams.install(gemfire.Region);
   delete gemfire.Region;
+  delete gemfire.RegionCursor;
 
   return gemfire;
 };
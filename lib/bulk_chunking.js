@@ -0,0 +1,262 @@
+// Opt-in chunking of large getAll() and putAll() calls. The keys or entries are split into chunks
+// that run concurrently on the GemFire thread pool, and their results are merged, so that one slow
+// or failing chunk no longer decides the fate of the whole call. See region.setBulkChunking() in
+// doc/region.md.
+
+const defaultOptions = {
+  chunkSize: 5000,
+  concurrency: 4
+};
+
+function validateOptions(options) {
+  const merged = Object.assign({}, defaultOptions, options === true ? {} : options);
+  if (typeof merged.chunkSize !== "number" || !(merged.chunkSize >= 1)) {
+    throw new Error("setBulkChunking: chunkSize must be a positive number.");
+  }
+  if (typeof merged.concurrency !== "number" || !(merged.concurrency >= 1)) {
+    throw new Error("setBulkChunking: concurrency must be a positive number.");
+  }
+  return merged;
+}
+
+function split(items, chunkSize) {
+  const chunks = [];
+  for (var start = 0; start < items.length; start += chunkSize) {
+    chunks.push(items.slice(start, start + chunkSize));
+  }
+  return chunks;
+}
+
+// Runs run(chunk, done) for every chunk, at most `concurrency` at a time, then calls
+// finished(report, results) with the size, time and error of each chunk, and the results of
+// those that succeeded. The first chunk starts synchronously, so that invalid arguments throw as
+// they do without chunking; later chunks that throw report the error instead.
+function runChunks(chunks, concurrency, run, finished) {
+  const report = chunks.map(function(chunk) {
+    return { size: chunk.length, milliseconds: 0 };
+  });
+  const results = new Array(chunks.length);
+  var started = 0;
+  var remaining = chunks.length;
+
+  // A chunk that fails synchronously starts the next one from within the initial loop, which may
+  // then find every chunk started already.
+  function start() {
+    if (started >= chunks.length) {
+      return;
+    }
+    const index = started++;
+    const startTime = process.hrtime();
+
+    function done(error, result) {
+      const elapsed = process.hrtime(startTime);
+      report[index].milliseconds = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+      if (error) {
+        report[index].error = error;
+      } else {
+        results[index] = result;
+      }
+
+      if (started < chunks.length) {
+        start();
+      }
+      if (--remaining === 0) {
+        finished(report, results);
+      }
+    }
+
+    if (index === 0) {
+      run(chunks[index], done);
+      return;
+    }
+    try {
+      run(chunks[index], done);
+    } catch (error) {
+      done(error);
+    }
+  }
+
+  const initial = Math.min(concurrency, chunks.length);
+  for (var i = 0; i < initial; i++) {
+    start();
+  }
+}
+
+function firstError(report) {
+  for (var i = 0; i < report.length; i++) {
+    if (report[i].error) {
+      return report[i].error;
+    }
+  }
+  return undefined;
+}
+
+function mergeValues(results, asMap) {
+  const values = asMap ? new Map() : {};
+  results.forEach(function(result) {
+    if (!result) {
+      return;
+    }
+    if (asMap) {
+      result.forEach(function(value, key) { values.set(key, value); });
+    } else {
+      Object.assign(values, result);
+    }
+  });
+  return values;
+}
+
+function entryCount(entries) {
+  if (entries instanceof Map) {
+    return entries.size;
+  }
+  return Array.isArray(entries) ? entries.length : Object.keys(entries).length;
+}
+
+// Objects are split by key; Maps and arrays of [key, value] pairs are split into arrays of pairs.
+function splitEntries(entries, chunkSize) {
+  if (entries instanceof Map || Array.isArray(entries)) {
+    return split(entries instanceof Map ? Array.from(entries) : entries, chunkSize);
+  }
+
+  return split(Object.keys(entries), chunkSize).map(function(keys) {
+    const chunk = {};
+    keys.forEach(function(key) {
+      chunk[key] = entries[key];
+    });
+    return chunk;
+  });
+}
+
+function lastFunction(args) {
+  const last = args[args.length - 1];
+  return typeof last === "function" ? last : undefined;
+}
+
+function mapRequested(options) {
+  return options !== null && typeof options === "object" && Boolean(options.map);
+}
+
+// Wraps getAll(), putAll() and their promise forms. Regions without chunking options, and calls
+// no larger than one chunk, go straight to the native methods. Options are kept by region path,
+// since getRegion() returns a new Region object every time.
+function install(Region) {
+  const prototype = Region.prototype;
+  const native = {};
+  ["getAll", "getAllAsync", "putAll", "putAllAsync"].forEach(function(name) {
+    native[name] = prototype[name];
+  });
+
+  const regionOptions = new Map();
+
+  function optionsOf(region) {
+    return regionOptions.size === 0 ? undefined : regionOptions.get(region.fullPath);
+  }
+
+  prototype.setBulkChunking = function setBulkChunking(options) {
+    if (options === false || options === null) {
+      regionOptions.delete(this.fullPath);
+    } else {
+      regionOptions.set(this.fullPath, validateOptions(options));
+    }
+    return this;
+  };
+
+  prototype.getAll = function getAll(keys) {
+    const options = optionsOf(this);
+    const callback = lastFunction(arguments);
+    if (!options || !callback || !Array.isArray(keys) || keys.length <= options.chunkSize) {
+      return native.getAll.apply(this, arguments);
+    }
+
+    const region = this;
+    const args = Array.prototype.slice.call(arguments);
+    runChunks(split(keys, options.chunkSize), options.concurrency, function(chunk, done) {
+      const chunkArgs = args.slice();
+      chunkArgs[0] = chunk;
+      chunkArgs[chunkArgs.length - 1] = done;
+      native.getAll.apply(region, chunkArgs);
+    }, function(report, results) {
+      const asMap = args.length > 2 && mapRequested(args[1]);
+      callback(firstError(report), mergeValues(results, asMap), { chunks: report });
+    });
+    return this;
+  };
+
+  prototype.putAll = function putAll(entries, callback) {
+    const options = optionsOf(this);
+    const count = options && entries !== null && typeof entries === "object" ? entryCount(entries) : 0;
+    const validCallback = callback === undefined || typeof callback === "function";
+    if (!options || count <= options.chunkSize || !validCallback) {
+      return native.putAll.apply(this, arguments);
+    }
+
+    const region = this;
+    runChunks(splitEntries(entries, options.chunkSize), options.concurrency, function(chunk, done) {
+      native.putAll.call(region, chunk, done);
+    }, function(report) {
+      const error = firstError(report);
+      if (callback) {
+        callback(error, { chunks: report });
+      } else if (error) {
+        region.emit("error", error);
+      }
+    });
+    return this;
+  };
+
+  // The promise forms reject with the first chunk error, which carries the chunk report in
+  // `chunks`, and for getAllAsync() the values of the chunks that succeeded in `values`.
+  function chunkedAsync(name, chunksOf, settle) {
+    return function(items) {
+      const options = optionsOf(this);
+      const chunkable = options && items !== null && typeof items === "object";
+      const chunks = chunkable ? chunksOf(items, options) : [];
+      if (chunks.length <= 1) {
+        return native[name].apply(this, arguments);
+      }
+
+      const region = this;
+      const args = Array.prototype.slice.call(arguments);
+      return new Promise(function(resolve, reject) {
+        runChunks(chunks, options.concurrency, function(chunk, done) {
+          const chunkArgs = args.slice();
+          chunkArgs[0] = chunk;
+          native[name].apply(region, chunkArgs).then(function(result) { done(undefined, result); }, done);
+        }, function(report, results) {
+          settle(report, results, resolve, reject, args);
+        });
+      });
+    };
+  }
+
+  prototype.getAllAsync = chunkedAsync("getAllAsync", function(keys, options) {
+    return Array.isArray(keys) ? split(keys, options.chunkSize) : [];
+  }, function(report, results, resolve, reject, args) {
+    const error = firstError(report);
+    const values = mergeValues(results, mapRequested(args[1]));
+    if (error) {
+      error.values = values;
+      error.chunks = report;
+      reject(error);
+    } else {
+      resolve(values);
+    }
+  });
+
+  prototype.putAllAsync = chunkedAsync("putAllAsync", function(entries, options) {
+    return entryCount(entries) > options.chunkSize ? splitEntries(entries, options.chunkSize) : [];
+  }, function(report, results, resolve, reject) {
+    const error = firstError(report);
+    if (error) {
+      error.chunks = report;
+      reject(error);
+    } else {
+      resolve();
+    }
+  });
+}
+
+module.exports.validateOptions = validateOptions;
+module.exports.runChunks = runChunks;
+module.exports.install = install;
@@ -0,0 +1,536 @@
+// Opt-in near cache for region.get(). Values read from the region are frozen and kept on the
+// JavaScript heap, so that reads of hot keys skip the native call and the conversion of the value.
+// Entries are admitted with W-TinyLFU: new entries wait in a small LRU window, and only move into
+// the main space if they are read more often than the entry they would evict there. Writes through
+// this process and the region's create, update and destroy events invalidate entries. See
+// region.setNearCache() in doc/region.md.
+
+const defaultOptions = {
+  maxEntries: 10000,
+  maxBytes: 64 * 1024 * 1024
+};
+
+function validateOptions(options) {
+  const merged = Object.assign({}, defaultOptions, options === true ? {} : options);
+  if (typeof merged.maxEntries !== "number" || !(merged.maxEntries >= 1)) {
+    throw new Error("setNearCache: maxEntries must be a positive number.");
+  }
+  if (typeof merged.maxBytes !== "number" || !(merged.maxBytes >= 1)) {
+    throw new Error("setNearCache: maxBytes must be a positive number.");
+  }
+  merged.maxEntries = Math.floor(merged.maxEntries);
+  return merged;
+}
+
+function isCacheableKey(key) {
+  return typeof key === "string" || typeof key === "number";
+}
+
+function hashKey(key) {
+  const text = typeof key === "string" ? key : "#" + key;
+  var hash = 0x811c9dc5;
+  for (var i = 0; i < text.length; i++) {
+    hash ^= text.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+const sketchSeeds = [0x97cb3127, 0xa4f1a3c5, 0x5bd1e995, 0xc2b2ae35];
+
+// A count-min sketch of how often each key has been read, with four bit counters. Counters are
+// halved once every ten reads per entry, so that keys which were popular long ago fade out.
+function FrequencySketch(maxEntries) {
+  var width = 16;
+  while (width < maxEntries) {
+    width *= 2;
+  }
+  this.width = width;
+  this.counters = new Uint8Array(width * sketchSeeds.length);
+  this.additions = 0;
+  this.sampleSize = 10 * maxEntries;
+}
+
+FrequencySketch.prototype.index = function(hash, row) {
+  var mixed = Math.imul(hash ^ sketchSeeds[row], 0x9e3779b1);
+  mixed ^= mixed >>> 15;
+  return row * this.width + (mixed & (this.width - 1));
+};
+
+FrequencySketch.prototype.increment = function(hash) {
+  var added = false;
+  for (var row = 0; row < sketchSeeds.length; row++) {
+    const index = this.index(hash, row);
+    if (this.counters[index] < 15) {
+      this.counters[index]++;
+      added = true;
+    }
+  }
+
+  if (added && ++this.additions >= this.sampleSize) {
+    for (var i = 0; i < this.counters.length; i++) {
+      this.counters[i] >>= 1;
+    }
+    this.additions = Math.floor(this.additions / 2);
+  }
+};
+
+FrequencySketch.prototype.frequency = function(hash) {
+  var frequency = 15;
+  for (var row = 0; row < sketchSeeds.length; row++) {
+    frequency = Math.min(frequency, this.counters[this.index(hash, row)]);
+  }
+  return frequency;
+};
+
+// The approximate heap size of a value, or -1 if it cannot be frozen and is not cached: Buffers,
+// typed arrays, Dates and other objects with a prototype of their own can be changed even when
+// frozen.
+function estimateBytes(value) {
+  switch (typeof value) {
+    case "string":
+      return 16 + 2 * value.length;
+    case "number":
+    case "boolean":
+      return 8;
+    case "bigint":
+      return 16;
+    case "object":
+      break;
+    default:
+      return -1;
+  }
+
+  if (value === null) {
+    return 8;
+  }
+
+  var bytes = 16;
+  if (Array.isArray(value)) {
+    for (var i = 0; i < value.length; i++) {
+      const elementBytes = estimateBytes(value[i]);
+      if (elementBytes < 0) {
+        return -1;
+      }
+      bytes += 8 + elementBytes;
+    }
+    return bytes;
+  }
+
+  const prototype = Object.getPrototypeOf(value);
+  if (prototype !== Object.prototype && prototype !== null) {
+    return -1;
+  }
+  const keys = Object.keys(value);
+  for (var j = 0; j < keys.length; j++) {
+    const fieldBytes = estimateBytes(value[keys[j]]);
+    if (fieldBytes < 0) {
+      return -1;
+    }
+    bytes += 8 + fieldBytes;
+  }
+  return bytes;
+}
+
+function deepFreeze(value) {
+  if (value === null || typeof value !== "object") {
+    return;
+  }
+  Object.keys(value).forEach(function(key) {
+    deepFreeze(value[key]);
+  });
+  Object.freeze(value);
+}
+
+function first(map) {
+  return map.size === 0 ? undefined : map.values().next().value;
+}
+
+function NearCache(options) {
+  this.options = options;
+  this.windowCapacity = Math.max(1, Math.floor(options.maxEntries / 100));
+  this.mainCapacity = options.maxEntries - this.windowCapacity;
+  this.protectedCapacity = Math.floor(this.mainCapacity * 0.8);
+
+  // Each segment is a Map in least to most recently used order.
+  this.entries = new Map();
+  this.window = new Map();
+  this.probation = new Map();
+  this.protected = new Map();
+  this.bytes = 0;
+  this.sketch = new FrequencySketch(options.maxEntries);
+
+  // The latest fetch of each key being read from the region; an invalidation drops it, so that a
+  // value read before a change is not cached after it.
+  this.fetches = new Map();
+
+  this.hits = 0;
+  this.misses = 0;
+  this.evictions = 0;
+  this.rejections = 0;
+  this.invalidations = 0;
+}
+
+// Returns the entry of key, as { value }, or undefined.
+NearCache.prototype.get = function(key) {
+  const entry = this.entries.get(key);
+  this.sketch.increment(entry ? entry.hash : hashKey(key));
+  if (!entry) {
+    this.misses++;
+    return undefined;
+  }
+
+  this.hits++;
+  if (entry.segment === this.probation) {
+    this.probation.delete(key);
+    this.moveTo(entry, this.protected);
+    if (this.protected.size > this.protectedCapacity) {
+      const demoted = first(this.protected);
+      this.protected.delete(demoted.key);
+      this.moveTo(demoted, this.probation);
+    }
+  } else {
+    entry.segment.delete(key);
+    entry.segment.set(key, entry);
+  }
+  return entry;
+};
+
+NearCache.prototype.moveTo = function(entry, segment) {
+  entry.segment = segment;
+  segment.set(entry.key, entry);
+};
+
+NearCache.prototype.beginFetch = function(key) {
+  const fetch = {};
+  this.fetches.set(key, fetch);
+  return fetch;
+};
+
+// Caches the value read by a fetch, unless the key was invalidated since, and returns the value.
+NearCache.prototype.completeFetch = function(key, fetch, value) {
+  if (this.fetches.get(key) !== fetch) {
+    return value;
+  }
+  this.fetches.delete(key);
+  return this.add(key, value);
+};
+
+// Forgets a fetch that failed, unless the key was invalidated or fetched again since.
+NearCache.prototype.cancelFetch = function(key, fetch) {
+  if (this.fetches.get(key) === fetch) {
+    this.fetches.delete(key);
+  }
+};
+
+// Missing keys are not cached. Returns the value, frozen if it was cached.
+NearCache.prototype.add = function(key, value) {
+  const bytes = value === null || value === undefined ? -1 : estimateBytes(value);
+  if (bytes < 0 || bytes > this.options.maxBytes) {
+    return value;
+  }
+
+  deepFreeze(value);
+  this.invalidate(key, true);
+  const entry = { key: key, value: value, bytes: bytes, hash: hashKey(key), segment: null };
+  this.entries.set(key, entry);
+  this.moveTo(entry, this.window);
+  this.bytes += bytes;
+
+  if (this.window.size > this.windowCapacity) {
+    this.admit(first(this.window));
+  }
+  while (this.bytes > this.options.maxBytes) {
+    this.remove(first(this.probation) || first(this.window) || first(this.protected));
+    this.evictions++;
+  }
+  return value;
+};
+
+// Moves the least recently used entry of the window into the main space, if it is read more often
+// than the entry it would evict there.
+NearCache.prototype.admit = function(candidate) {
+  if (this.probation.size + this.protected.size < this.mainCapacity) {
+    this.window.delete(candidate.key);
+    this.moveTo(candidate, this.probation);
+    return;
+  }
+
+  const victim = first(this.probation) || first(this.protected);
+  if (!victim || this.sketch.frequency(candidate.hash) <= this.sketch.frequency(victim.hash)) {
+    this.remove(candidate);
+    this.rejections++;
+    return;
+  }
+
+  this.remove(victim);
+  this.evictions++;
+  this.window.delete(candidate.key);
+  this.moveTo(candidate, this.probation);
+};
+
+NearCache.prototype.remove = function(entry) {
+  entry.segment.delete(entry.key);
+  this.entries.delete(entry.key);
+  this.bytes -= entry.bytes;
+};
+
+// Drops the entry of key, and any fetch of it in flight. Replacing an entry is not counted.
+NearCache.prototype.invalidate = function(key, replacing) {
+  if (!replacing) {
+    this.fetches.delete(key);
+  }
+  const entry = this.entries.get(key);
+  if (entry) {
+    this.remove(entry);
+    if (!replacing) {
+      this.invalidations++;
+    }
+  }
+};
+
+NearCache.prototype.clear = function() {
+  this.invalidations += this.entries.size;
+  this.entries.clear();
+  this.window.clear();
+  this.probation.clear();
+  this.protected.clear();
+  this.fetches.clear();
+  this.bytes = 0;
+};
+
+NearCache.prototype.stats = function() {
+  const reads = this.hits + this.misses;
+  return {
+    entries: this.entries.size,
+    bytes: this.bytes,
+    hits: this.hits,
+    misses: this.misses,
+    hitRatio: reads === 0 ? 0 : this.hits / reads,
+    evictions: this.evictions,
+    rejections: this.rejections,
+    invalidations: this.invalidations
+  };
+};
+
+// The keys of the entries passed to putAll(): an object, a Map or an array of [key, value] pairs.
+function entryKeys(entries) {
+  if (entries instanceof Map) {
+    return Array.from(entries.keys());
+  }
+  if (Array.isArray(entries)) {
+    return entries.map(function(pair) { return Array.isArray(pair) ? pair[0] : undefined; });
+  }
+  return Object.keys(entries);
+}
+
+// The writes, each with the number of arguments it takes before its callback. Synchronous and
+// promise forms take no callback.
+const keyedWrites = {
+  put: 2, putJSON: 2, update: 2, remove: 1, putIfAbsent: 2, replace: 3, removeIfEquals: 2, increment: 2,
+  putSync: null, putAsync: null, removeAsync: null, putIfAbsentSync: null, replaceSync: null,
+  removeIfEqualsSync: null, incrementSync: null
+};
+const entriesWrites = { putAll: 1, putAllSync: null, putAllAsync: null };
+const regionWrites = { putAllJSON: 1, clear: 0, destroyRegion: 0, localDestroyRegion: 0 };
+const invalidatingEvents = ["create", "update", "destroy"];
+
+// Wraps get(), getSync(), getAsync() and the Region methods that write. Regions without a near
+// cache go straight to the native methods. Caches are kept by region path, since getRegion()
+// returns a new Region object every time; the events of the Region object that set the cache up
+// invalidate it.
+function install(Region) {
+  const prototype = Region.prototype;
+  const native = {};
+  const reads = ["get", "getSync", "getAsync"];
+  const writes = Object.keys(keyedWrites).concat(Object.keys(entriesWrites), Object.keys(regionWrites));
+  reads.concat(writes).forEach(function(name) {
+    native[name] = prototype[name];
+  });
+
+  const caches = new Map();
+
+  function cacheOf(region) {
+    return caches.size === 0 ? undefined : caches.get(region.fullPath);
+  }
+
+  function listen(region, cache) {
+    cache.region = region;
+    cache.listener = function(event) {
+      cache.invalidate(event.key);
+    };
+    invalidatingEvents.forEach(function(eventName) {
+      region.on(eventName, cache.listener);
+    });
+  }
+
+  function unlisten(cache) {
+    invalidatingEvents.forEach(function(eventName) {
+      cache.region.removeListener(eventName, cache.listener);
+    });
+  }
+
+  prototype.setNearCache = function setNearCache(options) {
+    const path = this.fullPath;
+    const existing = caches.get(path);
+
+    if (options === false || options === null) {
+      if (existing) {
+        unlisten(existing);
+        caches.delete(path);
+      }
+      return this;
+    }
+
+    const cache = new NearCache(validateOptions(options));
+    if (existing) {
+      unlisten(existing);
+    }
+    listen(this, cache);
+    caches.set(path, cache);
+    return this;
+  };
+
+  prototype.nearCacheStats = function nearCacheStats() {
+    const cache = cacheOf(this);
+    return cache ? cache.stats() : undefined;
+  };
+
+  // Options such as lazy and fields change the value that comes back, so only plain gets are cached.
+  prototype.get = function get(key, callback) {
+    const cache = cacheOf(this);
+    if (!cache || arguments.length !== 2 || !isCacheableKey(key) || typeof callback !== "function") {
+      return native.get.apply(this, arguments);
+    }
+
+    const entry = cache.get(key);
+    if (entry) {
+      setImmediate(callback, undefined, entry.value);
+      return this;
+    }
+
+    const fetch = cache.beginFetch(key);
+    return native.get.call(this, key, function(error, value) {
+      if (error) {
+        cache.cancelFetch(key, fetch);
+        callback(error, value);
+        return;
+      }
+      callback(error, cache.completeFetch(key, fetch, value));
+    });
+  };
+
+  prototype.getSync = function getSync(key) {
+    const cache = cacheOf(this);
+    if (!cache || arguments.length !== 1 || !isCacheableKey(key)) {
+      return native.getSync.apply(this, arguments);
+    }
+
+    const entry = cache.get(key);
+    return entry ? entry.value : cache.add(key, native.getSync.call(this, key));
+  };
+
+  prototype.getAsync = function getAsync(key) {
+    const cache = cacheOf(this);
+    if (!cache || arguments.length !== 1 || !isCacheableKey(key)) {
+      return native.getAsync.apply(this, arguments);
+    }
+
+    const entry = cache.get(key);
+    if (entry) {
+      return Promise.resolve(entry.value);
+    }
+
+    const fetch = cache.beginFetch(key);
+    return native.getAsync.call(this, key).then(function(value) {
+      return cache.completeFetch(key, fetch, value);
+    }, function(error) {
+      cache.cancelFetch(key, fetch);
+      throw error;
+    });
+  };
+
+  // Writes invalidate before they are sent, which also stops reads in flight from caching what
+  // they read, and again once they have been applied, for reads sent in the meantime. Events cannot
+  // be relied on for that: update() and the conditional writes run on the server and raise none.
+  function wrapWrite(name, callbackIndex, invalidate) {
+    prototype[name] = function() {
+      const cache = cacheOf(this);
+      const args = Array.prototype.slice.call(arguments);
+      if (!cache || !invalidate(cache, args)) {
+        return native[name].apply(this, arguments);
+      }
+
+      function applied() {
+        invalidate(cache, args);
+      }
+
+      // A callback is added where the caller passed none; it reports errors as the native method
+      // would without one.
+      const region = this;
+      if (callbackIndex !== null) {
+        if (args.length === callbackIndex) {
+          args.push(function(error) {
+            if (error) {
+              region.emit("error", error);
+            }
+          });
+        }
+        const callback = args[callbackIndex];
+        if (args.length === callbackIndex + 1 && typeof callback === "function") {
+          args[callbackIndex] = function() {
+            applied();
+            return callback.apply(this, arguments);
+          };
+        }
+      }
+
+      const result = native[name].apply(this, args);
+      if (result instanceof Promise) {
+        return result.then(function(value) {
+          applied();
+          return value;
+        }, function(error) {
+          applied();
+          throw error;
+        });
+      }
+      return result;
+    };
+  }
+
+  Object.keys(keyedWrites).forEach(function(name) {
+    wrapWrite(name, keyedWrites[name], function(cache, args) {
+      if (!isCacheableKey(args[0])) {
+        return false;
+      }
+      cache.invalidate(args[0]);
+      return true;
+    });
+  });
+
+  Object.keys(entriesWrites).forEach(function(name) {
+    wrapWrite(name, entriesWrites[name], function(cache, args) {
+      const entries = args[0];
+      if (entries === null || typeof entries !== "object") {
+        return false;
+      }
+      entryKeys(entries).forEach(function(key) {
+        cache.invalidate(key);
+      });
+      return true;
+    });
+  });
+
+  Object.keys(regionWrites).forEach(function(name) {
+    wrapWrite(name, regionWrites[name], function(cache) {
+      cache.clear();
+      return true;
+    });
+  });
+}
+
+module.exports.NearCache = NearCache;
+module.exports.validateOptions = validateOptions;
+module.exports.estimateBytes = estimateBytes;
+module.exports.install = install;
@@ -0,0 +1,182 @@
+// Opt-in read combining for region.get(). Gets of a String key that is already being fetched share
+// that fetch, and the other keys asked for in the same turn of the event loop are fetched with a
+// single getAll(). See region.setReadCombining() in doc/region.md.
+
+const defaultOptions = {
+  maxBatchSize: 500
+};
+
+function validateOptions(options) {
+  const merged = Object.assign({}, defaultOptions, options === true ? {} : options);
+  if (typeof merged.maxBatchSize !== "number" || !(merged.maxBatchSize >= 1)) {
+    throw new Error("setReadCombining: maxBatchSize must be a positive number.");
+  }
+  return merged;
+}
+
+function ReadCombiner(region, native, options) {
+  this.region = region;
+  this.native = native;
+  this.options = options;
+  // Keys asked for in this turn, and keys being fetched, each with the callbacks waiting for them.
+  this.pending = new Map();
+  this.inFlight = new Map();
+  this.immediate = null;
+}
+
+ReadCombiner.prototype.get = function(key, callback) {
+  const fetch = this.inFlight.get(key) || this.pending.get(key);
+  if (fetch) {
+    fetch.callbacks.push(callback);
+    return;
+  }
+
+  this.pending.set(key, { callbacks: [callback] });
+  if (!this.immediate) {
+    this.immediate = setImmediate(this.flush.bind(this));
+  }
+};
+
+ReadCombiner.prototype.flush = function() {
+  this.immediate = null;
+  const batch = [];
+  this.pending.forEach(function(fetch, key) {
+    this.inFlight.set(key, fetch);
+    batch.push([key, fetch]);
+  }, this);
+  this.pending = new Map();
+
+  for (var start = 0; start < batch.length; start += this.options.maxBatchSize) {
+    this.fetch(batch.slice(start, start + this.options.maxBatchSize));
+  }
+};
+
+// Runs a caller's callback on its own, so that one that throws does not keep the other callers of
+// the batch waiting. The error is rethrown on the next tick, as it would have been uncaught.
+function callBack(callback, error, value) {
+  try {
+    callback(error, value);
+  } catch (thrown) {
+    process.nextTick(function() { throw thrown; });
+  }
+}
+
+// A key asked for on its own is fetched with get(), so that a lone hot key costs no more than before.
+ReadCombiner.prototype.fetch = function(batch) {
+  const self = this;
+  function fetched(error, values) {
+    batch.forEach(function(pair) {
+      if (self.inFlight.get(pair[0]) === pair[1]) {
+        self.inFlight.delete(pair[0]);
+      }
+    });
+
+    batch.forEach(function(pair) {
+      // getAll() leaves out missing keys, which get() returns as null.
+      const value = error ? undefined : (batch.length === 1 ? values : values[pair[0]]);
+      pair[1].callbacks.forEach(function(callback) {
+        callBack(callback, error, error || value !== undefined ? value : null);
+      });
+    });
+  }
+
+  try {
+    if (batch.length === 1) {
+      this.native.get.call(this.region, batch[0][0], fetched);
+    } else {
+      this.native.getAll.call(this.region, batch.map(function(pair) { return pair[0]; }), fetched);
+    }
+  } catch (error) {
+    fetched(error);
+  }
+};
+
+// Called for writes made through this process, so that later gets do not share a fetch that may
+// have been answered before the write landed. Callers already waiting keep sharing it.
+ReadCombiner.prototype.forget = function(key) {
+  if (key === undefined) {
+    this.inFlight.clear();
+  } else {
+    this.inFlight.delete(key);
+  }
+};
+
+const conditionalWrites = [
+  "putIfAbsent", "putIfAbsentSync", "replace", "replaceSync", "removeIfEquals", "removeIfEqualsSync",
+  "increment", "incrementSync"
+];
+
+// Wraps get() and the Region methods that write. Regions without a combiner go straight to the
+// native methods. Combiners are kept by region path, since getRegion() returns a new Region object
+// every time.
+function install(Region) {
+  const prototype = Region.prototype;
+  const native = {};
+  [
+    "get", "getAll", "put", "putSync", "putAll", "putAllSync", "putJSON", "putAllJSON", "update",
+    "remove", "clear", "putAsync", "putAllAsync", "removeAsync"
+  ].concat(conditionalWrites).forEach(function(name) {
+    native[name] = prototype[name];
+  });
+
+  const combiners = new Map();
+
+  function combinerOf(region) {
+    return combiners.size === 0 ? undefined : combiners.get(region.fullPath);
+  }
+
+  prototype.setReadCombining = function setReadCombining(options) {
+    const path = this.fullPath;
+    const combiner = combiners.get(path);
+
+    if (options === false || options === null) {
+      // Fetches already sent still call back their callers.
+      combiners.delete(path);
+      if (combiner) {
+        combiner.flush();
+      }
+      return this;
+    }
+
+    const validated = validateOptions(options);
+    if (combiner) {
+      combiner.options = validated;
+    } else {
+      combiners.set(path, new ReadCombiner(this, native, validated));
+    }
+    return this;
+  };
+
+  // Options such as lazy and fields change the value that comes back, so only plain gets combine.
+  prototype.get = function get(key, callback) {
+    const combiner = combinerOf(this);
+    if (!combiner || arguments.length !== 2 || typeof key !== "string" || typeof callback !== "function") {
+      return native.get.apply(this, arguments);
+    }
+
+    combiner.get(key, callback);
+    return this;
+  };
+
+  function write(name, hasKey) {
+    return function() {
+      const combiner = combinerOf(this);
+      if (combiner) {
+        combiner.forget(hasKey && typeof arguments[0] === "string" ? arguments[0] : undefined);
+      }
+      return native[name].apply(this, arguments);
+    };
+  }
+
+  const keyedWrites = ["put", "putSync", "putJSON", "update", "remove", "putAsync", "removeAsync"];
+  keyedWrites.concat(conditionalWrites).forEach(function(name) {
+    prototype[name] = write(name, true);
+  });
+  ["putAll", "putAllSync", "putAllJSON", "clear", "putAllAsync"].forEach(function(name) {
+    prototype[name] = write(name, false);
+  });
+}
+
+module.exports.ReadCombiner = ReadCombiner;
+module.exports.validateOptions = validateOptions;
+module.exports.install = install;
@@ -0,0 +1,68 @@
+// Readable streams over region.openCursor(). A batch is only fetched from the cursor when the
+// stream wants more data, so a consumer that falls behind holds up the region read instead of
+// buffering the whole region. See region.keysStream() in doc/region.md.
+
+const Readable = require("stream").Readable;
+
+function cursorStream(region, source, options) {
+  const batchSize = options && options.batchSize;
+  const cursor = region.openCursor(source, batchSize);
+  var reading = false;
+
+  const stream = new Readable({
+    objectMode: true,
+    // Room for a whole batch, so that a batch is pushed without going over the high water mark.
+    highWaterMark: batchSize || 1000,
+
+    read: function() {
+      if (reading) {
+        return;
+      }
+      reading = true;
+
+      cursor.next(function(error, batch) {
+        reading = false;
+        if (error) {
+          stream.destroy(error);
+          return;
+        }
+        if (batch === null) {
+          stream.push(null);
+          return;
+        }
+        for (var i = 0; i < batch.length; i++) {
+          stream.push(batch[i]);
+        }
+      });
+    },
+
+    destroy: function(error, callback) {
+      cursor.close();
+      callback(error);
+    }
+  });
+
+  return stream;
+}
+
+function install(Region) {
+  const prototype = Region.prototype;
+
+  prototype.keysStream = function keysStream(options) {
+    return cursorStream(this, "keys", options);
+  };
+
+  prototype.serverKeysStream = function serverKeysStream(options) {
+    return cursorStream(this, "serverKeys", options);
+  };
+
+  prototype.valuesStream = function valuesStream(options) {
+    return cursorStream(this, "values", options);
+  };
+
+  prototype.entriesStream = function entriesStream(options) {
+    return cursorStream(this, "entries", options);
+  };
+}
+
+module.exports.install = install;
@@ -0,0 +1,588 @@
+// Opt-in write batching for region.put(). Puts of String keys are gathered for a short window and
+// written with a single putAll(), one batch in flight per region at a time so that writes of the
+// same key land in the order they were made. See region.setWriteBatching() in doc/region.md.
+
+const defaultOptions = {
+  windowMilliseconds: 0,
+  maxBatchSize: 500
+};
+
+function validateOptions(options) {
+  const merged = Object.assign({}, defaultOptions, options);
+  if (typeof merged.windowMilliseconds !== "number" || !(merged.windowMilliseconds >= 0)) {
+    throw new Error("setWriteBatching: windowMilliseconds must be a non-negative number.");
+  }
+  if (typeof merged.maxBatchSize !== "number" || !(merged.maxBatchSize >= 1)) {
+    throw new Error("setWriteBatching: maxBatchSize must be a positive number.");
+  }
+  return merged;
+}
+
+// Calls back the writers of one key, or emits the error on the region they wrote through if they
+// passed no callback, as put() itself does.
+function deliver(entry, error) {
+  entry.writers.forEach(function(writer) {
+    if (writer.callback) {
+      writer.callback(error);
+    } else if (error) {
+      writer.region.emit("error", error);
+    }
+  });
+}
+
+function WriteBatcher(region, native, options) {
+  this.region = region;
+  this.native = native;
+  this.options = options;
+  this.pending = new Map();
+  this.inFlight = null;
+  this.timer = null;
+  this.closing = false;
+  this.onIdle = null;
+
+  // Batches are numbered so that operations which must follow pending writes can wait for them.
+  this.sentBatches = 0;
+  this.completedBatches = 0;
+  this.waiters = [];
+}
+
+WriteBatcher.prototype.put = function(region, key, value, callback) {
+  var entry = this.pending.get(key);
+  if (entry) {
+    // Only the last value of a key is written; every writer is called back with its result.
+    entry.value = value;
+  } else {
+    entry = { value: value, writers: [] };
+    this.pending.set(key, entry);
+  }
+  entry.writers.push({ region: region, callback: callback });
+
+  if (this.pending.size >= this.options.maxBatchSize) {
+    this.flush();
+  } else {
+    this.schedule();
+  }
+};
+
+WriteBatcher.prototype.schedule = function() {
+  if (this.timer || this.inFlight) {
+    return;
+  }
+
+  const self = this;
+  function flush() {
+    self.timer = null;
+    self.flush();
+  }
+  this.timer = this.options.windowMilliseconds > 0 ?
+    { timeout: setTimeout(flush, this.options.windowMilliseconds) } :
+    { immediate: setImmediate(flush) };
+};
+
+WriteBatcher.prototype.cancelTimer = function() {
+  if (!this.timer) {
+    return;
+  }
+  if (this.timer.timeout) {
+    clearTimeout(this.timer.timeout);
+  } else {
+    clearImmediate(this.timer.immediate);
+  }
+  this.timer = null;
+};
+
+WriteBatcher.prototype.flush = function() {
+  this.cancelTimer();
+  if (this.inFlight || this.pending.size === 0) {
+    return;
+  }
+
+  // Puts made while a batch was in flight may have gone past the maximum, and are split up.
+  var batch = this.pending;
+  this.pending = new Map();
+  if (batch.size > this.options.maxBatchSize) {
+    const rest = this.pending;
+    var count = 0;
+    batch.forEach(function(entry, key) {
+      if (++count > this.options.maxBatchSize) {
+        rest.set(key, entry);
+        batch.delete(key);
+      }
+    }, this);
+  }
+  this.inFlight = batch;
+  this.sentBatches++;
+
+  const entries = Object.create(null);
+  batch.forEach(function(entry, key) {
+    entries[key] = entry.value;
+  });
+
+  const self = this;
+  function written(error) {
+    if (error) {
+      self.writeIndividually(batch);
+    } else {
+      batch.forEach(function(entry) { deliver(entry, undefined); });
+      self.complete();
+    }
+  }
+
+  try {
+    this.native.putAll.call(this.region, entries, written);
+  } catch (error) {
+    // A value that cannot be serialized fails the whole putAll() before it is sent.
+    written(error);
+  }
+};
+
+// After a failed batch every entry is put on its own, so that each writer gets its own result.
+WriteBatcher.prototype.writeIndividually = function(batch) {
+  const self = this;
+  var remaining = batch.size;
+
+  batch.forEach(function(entry, key) {
+    function written(error) {
+      deliver(entry, error);
+      if (--remaining === 0) {
+        self.complete();
+      }
+    }
+
+    try {
+      self.native.put.call(self.region, key, entry.value, written);
+    } catch (error) {
+      written(error);
+    }
+  });
+};
+
+WriteBatcher.prototype.complete = function() {
+  this.inFlight = null;
+  this.completedBatches++;
+
+  // Writes made while the batch was in flight have waited long enough already.
+  this.flush();
+  this.runWaiters();
+};
+
+WriteBatcher.prototype.runWaiters = function() {
+  // Once idle, waiters for a batch that was emptied by supersede() are released as well.
+  const completed = this.completedBatches;
+  const idle = this.idle();
+  function isReady(waiter) { return idle || waiter.batch <= completed; }
+
+  const ready = this.waiters.filter(isReady);
+  this.waiters = this.waiters.filter(function(waiter) { return !isReady(waiter); });
+  ready.forEach(function(waiter) { waiter.fn(); });
+
+  if (this.closing && this.idle() && this.onIdle) {
+    this.onIdle();
+  }
+};
+
+WriteBatcher.prototype.idle = function() {
+  return this.pending.size === 0 && !this.inFlight;
+};
+
+// The buffered write of a key that has been put but not yet written, as { value, writers }.
+WriteBatcher.prototype.read = function(key) {
+  return this.pending.get(key) || (this.inFlight && this.inFlight.get(key));
+};
+
+// Calls fn once the pending and in-flight writes of key, or of every key if key is undefined, have
+// been written. Returns false without calling fn if there are none.
+WriteBatcher.prototype.afterWrites = function(key, fn) {
+  var batch;
+  if (key === undefined ? this.pending.size > 0 : this.pending.has(key)) {
+    batch = this.sentBatches + 1;
+  } else if (this.inFlight && (key === undefined || this.inFlight.has(key))) {
+    batch = this.sentBatches;
+  } else {
+    return false;
+  }
+
+  this.waiters.push({ batch: batch, fn: fn });
+  this.flush();
+  return true;
+};
+
+// Removes the pending writes of keys so that a synchronous write can take their place, and returns
+// them as [key, entry] pairs. Their writers should be called back once it has succeeded.
+WriteBatcher.prototype.supersede = function(keys, methodName) {
+  const inFlight = this.inFlight;
+  if (inFlight && keys.some(function(key) { return inFlight.has(key); })) {
+    throw new Error(
+      "You cannot call " + methodName + "() for a key whose batched put() is being written; " +
+      "wait for its callback or use flushWrites()."
+    );
+  }
+
+  const superseded = [];
+  keys.forEach(function(key) {
+    const entry = this.pending.get(key);
+    if (entry) {
+      this.pending.delete(key);
+      superseded.push([key, entry]);
+    }
+  }, this);
+
+  if (superseded.length > 0 && this.idle()) {
+    this.cancelTimer();
+    setImmediate(this.runWaiters.bind(this));
+  }
+  return superseded;
+};
+
+// Puts superseded writes back if the synchronous write failed after all.
+WriteBatcher.prototype.restore = function(superseded) {
+  superseded.forEach(function(pair) {
+    if (!this.pending.has(pair[0])) {
+      this.pending.set(pair[0], pair[1]);
+    }
+  }, this);
+  if (superseded.length > 0) {
+    this.schedule();
+  }
+};
+
+function lastFunction(args) {
+  const last = args[args.length - 1];
+  return typeof last === "function" ? last : undefined;
+}
+
+// The keys of the entries passed to putAllSync(): an object, a Map or an array of [key, value] pairs.
+function entryKeys(entries) {
+  if (entries instanceof Map) {
+    return Array.from(entries.keys());
+  }
+  if (Array.isArray(entries)) {
+    return entries.map(function(pair) { return Array.isArray(pair) ? pair[0] : undefined; });
+  }
+  return Object.keys(entries);
+}
+
+// Wraps the Region methods that write batching affects. Regions without a batcher go straight to
+// the native methods. Batchers are kept by region path, since getRegion() returns a new Region
+// object every time.
+function install(Region) {
+  const prototype = Region.prototype;
+  const native = {};
+  [
+    "put", "putSync", "putAll", "putAllSync", "putJSON", "putAllJSON", "update", "remove", "clear",
+    "get", "getSync", "getAll", "getAllSync", "getAsync", "getAllAsync", "putAsync", "putAllAsync",
+    "removeAsync", "putIfAbsent", "putIfAbsentSync", "replace", "replaceSync", "removeIfEquals",
+    "removeIfEqualsSync", "increment", "incrementSync"
+  ].forEach(function(name) {
+    native[name] = prototype[name];
+  });
+
+  const batchers = new Map();
+
+  function batcherOf(region) {
+    return batchers.size === 0 ? undefined : batchers.get(region.fullPath);
+  }
+
+  prototype.setWriteBatching = function setWriteBatching(options) {
+    const path = this.fullPath;
+    const batcher = batchers.get(path);
+
+    if (options === false || options === null) {
+      if (batcher) {
+        // Writes still buffered are written first; the batcher is dropped once it is idle.
+        batcher.closing = true;
+        batcher.onIdle = function() { batchers.delete(path); };
+        batcher.flush();
+        if (batcher.idle()) {
+          batchers.delete(path);
+        }
+      }
+      return this;
+    }
+
+    const validated = validateOptions(options);
+    if (batcher) {
+      batcher.options = validated;
+      batcher.closing = false;
+      batcher.onIdle = null;
+    } else {
+      batchers.set(path, new WriteBatcher(this, native, validated));
+    }
+    return this;
+  };
+
+  prototype.flushWrites = function flushWrites(callback) {
+    if (callback !== undefined && typeof callback !== "function") {
+      throw new Error("You must pass a function as the callback to flushWrites().");
+    }
+
+    const done = callback || function() {};
+    const batcher = batcherOf(this);
+    if (!batcher || !batcher.afterWrites(undefined, done)) {
+      setImmediate(done);
+    }
+    return this;
+  };
+
+  prototype.put = function put(key, value, callback) {
+    const batcher = batcherOf(this);
+    if (!batcher || typeof key !== "string") {
+      return native.put.apply(this, arguments);
+    }
+
+    if (arguments.length < 2) {
+      throw new Error("You must pass a key and value to put().");
+    }
+    if (callback !== undefined && typeof callback !== "function") {
+      throw new Error("You must pass a function as the callback to put().");
+    }
+
+    batcher.put(this, key, value, callback);
+    return this;
+  };
+
+  function writeSync(name, keysOf) {
+    return function() {
+      const batcher = batcherOf(this);
+      const keys = batcher ? keysOf(arguments) : [];
+      if (keys.length === 0) {
+        return native[name].apply(this, arguments);
+      }
+
+      const superseded = batcher.supersede(keys, name);
+      var result;
+      try {
+        result = native[name].apply(this, arguments);
+      } catch (error) {
+        batcher.restore(superseded);
+        throw error;
+      }
+
+      setImmediate(function() {
+        superseded.forEach(function(pair) { deliver(pair[1], undefined); });
+      });
+      return result;
+    };
+  }
+
+  prototype.putSync = writeSync("putSync", function(args) {
+    return typeof args[0] === "string" ? [args[0]] : [];
+  });
+
+  prototype.putAllSync = writeSync("putAllSync", function(args) {
+    return args[0] !== null && typeof args[0] === "object" ? entryKeys(args[0]) : [];
+  });
+
+  // Writes that could land before buffered writes of the same keys wait for those to be written.
+  // Their arguments can then only be checked late, so errors go to the callback or "error" event.
+  function afterWrites(name, keyOf) {
+    return function() {
+      const batcher = batcherOf(this);
+      const key = keyOf ? arguments[0] : undefined;
+      if (!batcher || (keyOf && typeof key !== "string")) {
+        return native[name].apply(this, arguments);
+      }
+
+      const region = this;
+      const args = arguments;
+      function call() {
+        try {
+          native[name].apply(region, args);
+        } catch (error) {
+          const callback = lastFunction(args);
+          if (callback) {
+            callback(error);
+          } else {
+            region.emit("error", error);
+          }
+        }
+      }
+
+      if (!batcher.afterWrites(key, call)) {
+        return native[name].apply(this, arguments);
+      }
+      return this;
+    };
+  }
+
+  prototype.putAll = afterWrites("putAll");
+  prototype.putAllJSON = afterWrites("putAllJSON");
+  prototype.clear = afterWrites("clear");
+  prototype.putJSON = afterWrites("putJSON", true);
+  prototype.update = afterWrites("update", true);
+  prototype.remove = afterWrites("remove", true);
+  prototype.putIfAbsent = afterWrites("putIfAbsent", true);
+  prototype.replace = afterWrites("replace", true);
+  prototype.removeIfEquals = afterWrites("removeIfEquals", true);
+  prototype.increment = afterWrites("increment", true);
+
+  // The condition of a synchronous conditional write depends on buffered writes of its key, which
+  // cannot be waited for, so it throws instead.
+  function conditionalSync(name) {
+    return function(key) {
+      const batcher = batcherOf(this);
+      if (batcher && typeof key === "string" && batcher.read(key)) {
+        throw new Error(
+          "You cannot call " + name + "() for a key with a batched put() that has not been written; " +
+          "use flushWrites() first."
+        );
+      }
+      return native[name].apply(this, arguments);
+    };
+  }
+
+  ["putIfAbsentSync", "replaceSync", "removeIfEqualsSync", "incrementSync"].forEach(function(name) {
+    prototype[name] = conditionalSync(name);
+  });
+
+  // The promise methods wait the same way, and then return the promise of the native method.
+  function afterWritesAsync(name, keyed) {
+    return function() {
+      const batcher = batcherOf(this);
+      const key = keyed ? arguments[0] : undefined;
+      if (!batcher || (keyed && typeof key !== "string")) {
+        return native[name].apply(this, arguments);
+      }
+
+      var waiting = false;
+      const written = new Promise(function(resolve) {
+        waiting = batcher.afterWrites(key, resolve);
+      });
+      if (!waiting) {
+        return native[name].apply(this, arguments);
+      }
+
+      const region = this;
+      const args = arguments;
+      return written.then(function() {
+        return native[name].apply(region, args);
+      });
+    };
+  }
+
+  prototype.putAsync = afterWritesAsync("putAsync", true);
+  prototype.removeAsync = afterWritesAsync("removeAsync", true);
+  prototype.putAllAsync = afterWritesAsync("putAllAsync", false);
+
+  // Reads of keys with buffered writes return the value passed to put(), options notwithstanding.
+  function bufferedValues(batcher, keys) {
+    const buffered = {};
+    const remaining = [];
+    var count = 0;
+    keys.forEach(function(key) {
+      const entry = typeof key === "string" && batcher.read(key);
+      if (entry) {
+        buffered[key] = entry.value;
+        count++;
+      } else {
+        remaining.push(key);
+      }
+    });
+    return count === 0 ? undefined : { values: buffered, remaining: remaining };
+  }
+
+  // Adds the buffered values to the values read, which are a Map under the map option.
+  function withBuffered(values, buffered) {
+    if (!(values instanceof Map)) {
+      return Object.assign(values, buffered);
+    }
+    Object.keys(buffered).forEach(function(key) {
+      values.set(key, buffered[key]);
+    });
+    return values;
+  }
+
+  function onlyBuffered(buffered, options) {
+    const asMap = options !== null && typeof options === "object" && Boolean(options.map);
+    return asMap ? withBuffered(new Map(), buffered.values) : buffered.values;
+  }
+
+  prototype.get = function get(key) {
+    const batcher = batcherOf(this);
+    const entry = batcher && typeof key === "string" && batcher.read(key);
+    const callback = lastFunction(arguments);
+    if (!entry || !callback || arguments.length < 2) {
+      return native.get.apply(this, arguments);
+    }
+
+    setImmediate(callback, undefined, entry.value);
+    return this;
+  };
+
+  prototype.getSync = function getSync(key) {
+    const batcher = batcherOf(this);
+    const entry = batcher && typeof key === "string" && batcher.read(key);
+    return entry ? entry.value : native.getSync.apply(this, arguments);
+  };
+
+  prototype.getAll = function getAll(keys) {
+    const batcher = batcherOf(this);
+    const callback = lastFunction(arguments);
+    const buffered = batcher && callback && Array.isArray(keys) && bufferedValues(batcher, keys);
+    if (!buffered) {
+      return native.getAll.apply(this, arguments);
+    }
+
+    if (buffered.remaining.length === 0) {
+      const options = arguments.length > 2 ? arguments[1] : undefined;
+      setImmediate(callback, undefined, onlyBuffered(buffered, options));
+      return this;
+    }
+
+    const args = Array.prototype.slice.call(arguments);
+    args[0] = buffered.remaining;
+    args[args.length - 1] = function(error, values) {
+      if (error) {
+        callback(error);
+        return;
+      }
+      callback(undefined, withBuffered(values, buffered.values));
+    };
+    return native.getAll.apply(this, args);
+  };
+
+  prototype.getAsync = function getAsync(key) {
+    const batcher = batcherOf(this);
+    const entry = batcher && typeof key === "string" && batcher.read(key);
+    return entry ? Promise.resolve(entry.value) : native.getAsync.apply(this, arguments);
+  };
+
+  prototype.getAllAsync = function getAllAsync(keys) {
+    const batcher = batcherOf(this);
+    const buffered = batcher && Array.isArray(keys) && bufferedValues(batcher, keys);
+    if (!buffered) {
+      return native.getAllAsync.apply(this, arguments);
+    }
+
+    if (buffered.remaining.length === 0) {
+      return Promise.resolve(onlyBuffered(buffered, arguments[1]));
+    }
+
+    const args = Array.prototype.slice.call(arguments);
+    args[0] = buffered.remaining;
+    return native.getAllAsync.apply(this, args).then(function(values) {
+      return withBuffered(values, buffered.values);
+    });
+  };
+
+  prototype.getAllSync = function getAllSync(keys) {
+    const batcher = batcherOf(this);
+    const buffered = batcher && Array.isArray(keys) && bufferedValues(batcher, keys);
+    if (!buffered) {
+      return native.getAllSync.apply(this, arguments);
+    }
+
+    if (buffered.remaining.length === 0) {
+      return onlyBuffered(buffered, arguments[1]);
+    }
+
+    const args = Array.prototype.slice.call(arguments);
+    args[0] = buffered.remaining;
+    return withBuffered(native.getAllSync.apply(this, args), buffered.values);
+  };
+}
+
+module.exports.WriteBatcher = WriteBatcher;
+module.exports.validateOptions = validateOptions;
+module.exports.deliver = deliver;
+module.exports.install = install;
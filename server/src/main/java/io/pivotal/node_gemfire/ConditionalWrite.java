@@ -0,0 +1,94 @@
+package io.pivotal.node_gemfire;
+
+import java.util.List;
+
+import org.apache.geode.cache.Region;
+import org.apache.geode.cache.execute.FunctionAdapter;
+import org.apache.geode.cache.execute.FunctionContext;
+import org.apache.geode.cache.execute.FunctionException;
+import org.apache.geode.cache.execute.RegionFunctionContext;
+
+// Runs region.putIfAbsent(), region.replace() and region.increment() for the filter key, which the
+// native client has no operations for. The arguments are the name of the operation followed by
+// its values.
+public class ConditionalWrite extends FunctionAdapter {
+
+    public void execute(FunctionContext fc) {
+        RegionFunctionContext regionFunctionContext = (RegionFunctionContext) fc;
+        Region<Object, Object> region = regionFunctionContext.getDataSet();
+        List<?> arguments = (List<?>) regionFunctionContext.getArguments();
+        String operation = (String) arguments.get(0);
+        Object key = regionFunctionContext.getFilter().iterator().next();
+
+        Object result;
+        if (operation.equals("putIfAbsent")) {
+            result = region.putIfAbsent(key, arguments.get(1));
+        } else if (operation.equals("replace")) {
+            result = region.replace(key, arguments.get(1), arguments.get(2));
+        } else if (operation.equals("increment")) {
+            result = increment(region, key, (Number) arguments.get(1));
+        } else {
+            throw new FunctionException("Unknown conditional write: " + operation);
+        }
+
+        fc.getResultSender().lastResult(result);
+    }
+
+    // Retried until no other write got in between the read and the write.
+    private Number increment(Region<Object, Object> region, Object key, Number delta) {
+        while (true) {
+            Object current = region.get(key);
+            if (current == null) {
+                if (region.putIfAbsent(key, delta) == null) {
+                    return delta;
+                }
+            } else if (!(current instanceof Number)) {
+                throw new FunctionException("The value at key " + key + " is not a number.");
+            } else {
+                Number sum = add((Number) current, delta);
+                if (region.replace(key, current, sum)) {
+                    return sum;
+                }
+            }
+        }
+    }
+
+    // Integer and Long counters keep their type as long as the sum fits, and Double counters stay
+    // Doubles. JavaScript deltas arrive as Doubles unless the compact number encoding is used.
+    private Number add(Number current, Number delta) {
+        if (isIntegerType(current) && isWhole(delta)) {
+            long sum = Math.addExact(current.longValue(), delta.longValue());
+            if (current instanceof Integer && sum >= Integer.MIN_VALUE && sum <= Integer.MAX_VALUE) {
+                return (int) sum;
+            }
+            return sum;
+        }
+        return current.doubleValue() + delta.doubleValue();
+    }
+
+    private boolean isIntegerType(Number number) {
+        return number instanceof Integer || number instanceof Long || number instanceof Short ||
+            number instanceof Byte;
+    }
+
+    private boolean isWhole(Number number) {
+        if (isIntegerType(number)) {
+            return true;
+        }
+        double value = number.doubleValue();
+        return value == Math.rint(value) && Math.abs(value) <= 9007199254740991.0;
+    }
+
+    public boolean optimizeForWrite() {
+        return true;
+    }
+
+    // A retried increment could be applied twice.
+    public boolean isHA() {
+        return false;
+    }
+
+    public String getId() {
+        return getClass().getName();
+    }
+}
@@ -0,0 +1,215 @@
+package io.pivotal.node_gemfire;
+
+import java.lang.reflect.Array;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+
+import org.apache.geode.cache.Region;
+import org.apache.geode.cache.execute.FunctionAdapter;
+import org.apache.geode.cache.execute.FunctionContext;
+import org.apache.geode.cache.execute.FunctionException;
+import org.apache.geode.cache.execute.RegionFunctionContext;
+import org.apache.geode.pdx.PdxInstance;
+import org.apache.geode.pdx.PdxInstanceFactory;
+import org.apache.geode.pdx.WritablePdxInstance;
+
+// Merges the fields of the PdxInstance passed as the argument into the value of each filter key,
+// so that region.update() only has to send the fields that changed. Missing entries, and entries
+// that are not PdxInstances, are replaced by the changes.
+public class UpdateFields extends FunctionAdapter {
+
+    // The prefix of the class names node-gemfire derives from the field names of plain objects.
+    private static final String SHAPE_CLASS_PREFIX = "JSON: ";
+
+    private static final Comparator<String> UTF8_ORDER = new Comparator<String>() {
+        public int compare(String first, String second) {
+            byte[] firstBytes = first.getBytes(StandardCharsets.UTF_8);
+            byte[] secondBytes = second.getBytes(StandardCharsets.UTF_8);
+            for (int i = 0; i < Math.min(firstBytes.length, secondBytes.length); i++) {
+                int difference = (firstBytes[i] & 0xff) - (secondBytes[i] & 0xff);
+                if (difference != 0) {
+                    return difference;
+                }
+            }
+            return firstBytes.length - secondBytes.length;
+        }
+    };
+
+    public void execute(FunctionContext fc) {
+        RegionFunctionContext regionFunctionContext = (RegionFunctionContext) fc;
+        Region<Object, Object> region = regionFunctionContext.getDataSet();
+        PdxInstance changes = (PdxInstance) regionFunctionContext.getArguments();
+
+        for (Object key : regionFunctionContext.getFilter()) {
+            // Retried until no other update got in between the read and the write.
+            while (true) {
+                Object current = region.get(key);
+                if (current == null) {
+                    if (region.putIfAbsent(key, changes) == null) {
+                        break;
+                    }
+                } else if (region.replace(key, current, merge(region, current, changes))) {
+                    break;
+                }
+            }
+        }
+
+        fc.getResultSender().lastResult(true);
+    }
+
+    private Object merge(Region<Object, Object> region, Object current, PdxInstance changes) {
+        if (!(current instanceof PdxInstance)) {
+            return changes;
+        }
+
+        PdxInstance currentInstance = (PdxInstance) current;
+        if (currentInstance.getClassName().startsWith(SHAPE_CLASS_PREFIX)) {
+            return mergeShape(region, currentInstance, changes);
+        }
+        return mergeTyped(currentInstance, changes);
+    }
+
+    // Plain objects write every field as an Object field, under a class name derived from their
+    // field names; the merged field set gets the class name the client would derive for it.
+    private Object mergeShape(Region<Object, Object> region, PdxInstance current, PdxInstance changes) {
+        List<String> fields = new ArrayList<String>(current.getFieldNames());
+        for (String field : changes.getFieldNames()) {
+            if (!current.hasField(field)) {
+                fields.add(field);
+            }
+        }
+
+        List<Object> values = new ArrayList<Object>(fields.size());
+        for (String field : fields) {
+            values.add(changes.hasField(field) ? changes.getField(field) : current.getField(field));
+        }
+
+        PdxInstanceFactory factory =
+            region.getRegionService().createPdxInstanceFactory(shapeClassName(fields, values));
+        for (int i = 0; i < fields.size(); i++) {
+            factory.writeObject(fields.get(i), values.get(i));
+        }
+        return factory.create();
+    }
+
+    // Mirrors pdxClassName() in src/pdx_type_cache.cpp: the escaped field names, with "[]" after
+    // arrays, sorted by their UTF-8 bytes.
+    private String shapeClassName(List<String> fields, List<Object> values) {
+        List<String> fullFieldNames = new ArrayList<String>(fields.size());
+        for (int i = 0; i < fields.size(); i++) {
+            StringBuilder fullFieldName = new StringBuilder();
+            for (char character : fields.get(i).toCharArray()) {
+                if (character == ',' || character == '[' || character == ']' || character == '\\') {
+                    fullFieldName.append('\\');
+                }
+                fullFieldName.append(character);
+            }
+            if (values.get(i) instanceof List) {
+                fullFieldName.append("[]");
+            }
+            fullFieldNames.add(fullFieldName.append(',').toString());
+        }
+
+        Collections.sort(fullFieldNames, UTF8_ORDER);
+        StringBuilder className = new StringBuilder(SHAPE_CLASS_PREFIX);
+        for (String fullFieldName : fullFieldNames) {
+            className.append(fullFieldName);
+        }
+        return className.toString();
+    }
+
+    // Values of registered schemas and Java classes keep their class name and the declared type
+    // of every field, so their fields can only be changed, not added.
+    private Object mergeTyped(PdxInstance current, PdxInstance changes) {
+        for (String field : changes.getFieldNames()) {
+            if (!current.hasField(field)) {
+                throw new FunctionException("update() cannot add the field " + field +
+                    " to a value of type " + current.getClassName() + ".");
+            }
+        }
+
+        WritablePdxInstance writer = current.createWriter();
+        for (String field : changes.getFieldNames()) {
+            writer.setField(field, coerce(changes.getField(field), current.getField(field)));
+        }
+        return writer;
+    }
+
+    // JavaScript sends numbers as Doubles and arrays as Lists; they are converted to the type of the
+    // current value of the field where that loses nothing. Anything else is left for setField() to
+    // reject.
+    private Object coerce(Object value, Object current) {
+        if (value == null || current == null || current.getClass().isInstance(value)) {
+            return value;
+        }
+        if (value instanceof Number && current instanceof Number) {
+            return convertNumber((Number) value, current.getClass());
+        }
+        if (value instanceof List && current.getClass().isArray()) {
+            List<?> list = (List<?>) value;
+            Class<?> componentType = current.getClass().getComponentType();
+            Object array = Array.newInstance(componentType, list.size());
+            for (int i = 0; i < list.size(); i++) {
+                Object element = list.get(i);
+                if (element instanceof Number) {
+                    element = convertNumber((Number) element, boxed(componentType));
+                }
+                try {
+                    Array.set(array, i, element);
+                } catch (IllegalArgumentException exception) {
+                    return value;
+                }
+            }
+            return array;
+        }
+        return value;
+    }
+
+    private Number convertNumber(Number number, Class<?> type) {
+        Number converted;
+        if (type == Integer.class) {
+            converted = number.intValue();
+        } else if (type == Long.class) {
+            converted = number.longValue();
+        } else if (type == Short.class) {
+            converted = number.shortValue();
+        } else if (type == Byte.class) {
+            converted = number.byteValue();
+        } else if (type == Float.class) {
+            converted = number.floatValue();
+        } else if (type == Double.class) {
+            converted = number.doubleValue();
+        } else {
+            return number;
+        }
+        return converted.doubleValue() == number.doubleValue() ? converted : number;
+    }
+
+    private Class<?> boxed(Class<?> type) {
+        if (type == int.class) {
+            return Integer.class;
+        } else if (type == long.class) {
+            return Long.class;
+        } else if (type == short.class) {
+            return Short.class;
+        } else if (type == byte.class) {
+            return Byte.class;
+        } else if (type == float.class) {
+            return Float.class;
+        } else if (type == double.class) {
+            return Double.class;
+        }
+        return type;
+    }
+
+    public boolean optimizeForWrite() {
+        return true;
+    }
+
+    public String getId() {
+        return getClass().getName();
+    }
+}
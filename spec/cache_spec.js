@@ -563,6 +563,81 @@ describe("gemfire.Cache", function() {
     });
   });
 
+  describe(".registerSchema", function() {
+    const cache = factories.getCache();
+    const region = cache.getRegion("exampleRegion");
+
+    beforeEach(function(done) {
+      region.clear(done);
+    });
+
+    it("writes tagged objects with the typed fields of the schema", function(done) {
+      cache.registerSchema("com.example.Trade", {
+        id: "long",
+        price: "double",
+        quantity: "int",
+        symbol: "string",
+        tags: "string[]",
+        history: "double[]"
+      });
+
+      const trade = { id: 42, price: 10.5, quantity: 3, symbol: "GF", tags: ["fx", "spot"], history: [1.5, 2] };
+      trade[gemfire.schemaSymbol] = "com.example.Trade";
+
+      region.putSync("trade", trade);
+      region.get("trade", function(error, value) {
+        expect(error).not.toBeError();
+        expect(value.id).toEqual(42);
+        expect(value.price).toEqual(10.5);
+        expect(value.quantity).toEqual(3);
+        expect(value.symbol).toEqual("GF");
+        expect(value.tags).toEqual(["fx", "spot"]);
+        expect(Array.from(value.history)).toEqual([1.5, 2]);
+        done();
+      });
+    });
+
+    it("stores an invalid Date in a date field as null", function() {
+      cache.registerSchema("com.example.Event", { name: "string", when: "date" });
+      const event = { name: "launch", when: new Date(NaN) };
+      event[gemfire.schemaSymbol] = "com.example.Event";
+
+      region.putSync("event", event);
+      const value = region.getSync("event");
+      expect(value.name).toEqual("launch");
+      expect(value.when).toBeNull();
+    });
+
+    it("exposes Symbol.for('gemfire.schema') as the schema symbol", function() {
+      expect(gemfire.schemaSymbol).toBe(Symbol.for("gemfire.schema"));
+    });
+
+    it("throws a TypeError when a field does not match its type", function() {
+      cache.registerSchema("com.example.Counter", { count: "int" });
+      const counter = { count: "many" };
+      counter[gemfire.schemaSymbol] = "com.example.Counter";
+
+      expect(function() { region.putSync("counter", counter); }).toThrow(
+        new TypeError("Unable to serialize to GemFire; field 'count' of schema 'com.example.Counter' must be of type int.")
+      );
+    });
+
+    it("throws an error for an unknown field type", function() {
+      expect(function() { cache.registerSchema("com.example.Bad", { count: "integer" }); }).toThrow(
+        new Error("registerSchema: Unknown type 'integer' for field 'count'. Use boolean, byte, short, int, long, " +
+                  "float, double, string, date or object, or an array of one of them such as 'string[]'.")
+      );
+    });
+
+    it("throws an error for objects tagged with an unknown schema", function() {
+      const value = { foo: "bar" };
+      value[gemfire.schemaSymbol] = "com.example.Unknown";
+      expect(function() { region.putSync("unknown", value); }).toThrow(
+        new Error("Unable to serialize to GemFire; unknown schema: com.example.Unknown")
+      );
+    });
+  });
+
   describe(".inspect", function() {
     it("returns a user-friendly display string describing the cache", function() {
       expect(factories.getCache().inspect()).toEqual('[Cache]');
@@ -3,6 +3,8 @@
 #include <string>
 #include "../../src/conversions.hpp"
 #include "../../src/region_shortcuts.hpp"
+#include "../../src/pdx_type_cache.hpp"
+#include "../../src/string_conversions.hpp"
 #include "gtest/gtest.h"
 
 using namespace v8;
@@ -102,6 +104,77 @@ TEST(getClassName, fieldNamesCanContainBackslash) {
                getClassName(secondObject).c_str());
 }
 
+TEST(PdxTypeCache, sameShapeReturnsSameDescriptor) {
+  PdxTypeCache pdxTypeCache;
+
+  std::string shapeKey;
+  PdxTypeCache::appendToShapeKey(shapeKey, "foo", 3, false);
+  PdxTypeCache::appendToShapeKey(shapeKey, "bar", 3, true);
+
+  PdxTypeDescriptorPtr first(pdxTypeCache.find(shapeKey));
+  PdxTypeDescriptorPtr second(pdxTypeCache.find(shapeKey));
+
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(1u, pdxTypeCache.getMisses());
+  EXPECT_EQ(1u, pdxTypeCache.getHits());
+}
+
+TEST(PdxTypeCache, descriptorMatchesGetClassName) {
+  Nan::HandleScope scope;
+
+  Local<Object> object = Nan::New<Object>();
+  object->Set(Nan::New("foo").ToLocalChecked(), Nan::Null());
+  object->Set(Nan::New("b,ar").ToLocalChecked(), Nan::New<Array>());
+
+  std::string shapeKey;
+  PdxTypeCache::appendToShapeKey(shapeKey, "foo", 3, false);
+  PdxTypeCache::appendToShapeKey(shapeKey, "b,ar", 4, true);
+
+  PdxTypeCache pdxTypeCache;
+  PdxTypeDescriptorPtr descriptor(pdxTypeCache.find(shapeKey));
+
+  EXPECT_STREQ(getClassName(object).c_str(), descriptor->className.c_str());
+  ASSERT_EQ(2u, descriptor->fields.size());
+  EXPECT_EQ("foo", descriptor->fields[0].name);
+  EXPECT_FALSE(descriptor->fields[0].isArray);
+  EXPECT_EQ("b,ar", descriptor->fields[1].name);
+  EXPECT_TRUE(descriptor->fields[1].isArray);
+}
+
+TEST(PdxTypeCache, fieldOrderIsPartOfTheShape) {
+  std::string firstShapeKey;
+  PdxTypeCache::appendToShapeKey(firstShapeKey, "a", 1, false);
+  PdxTypeCache::appendToShapeKey(firstShapeKey, "b", 1, false);
+
+  std::string secondShapeKey;
+  PdxTypeCache::appendToShapeKey(secondShapeKey, "b", 1, false);
+  PdxTypeCache::appendToShapeKey(secondShapeKey, "a", 1, false);
+
+  PdxTypeCache pdxTypeCache;
+  PdxTypeDescriptorPtr first(pdxTypeCache.find(firstShapeKey));
+  PdxTypeDescriptorPtr second(pdxTypeCache.find(secondShapeKey));
+
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(first->className, second->className);
+}
+
+TEST(isAscii, oneByte) {
+  EXPECT_TRUE(isAscii("", 0));
+  EXPECT_TRUE(isAscii("plain ascii text spanning several words", 39));
+  EXPECT_FALSE(isAscii("caf\xe9", 4));
+  EXPECT_FALSE(isAscii("eight by\xe9tes and a tail", 23));
+}
+
+TEST(isAscii, twoByte) {
+  const uint16_t ascii[] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g' };
+  const uint16_t latin1[] = { 'a', 'b', 'c', 'd', 0xe9 };
+  const uint16_t wide[] = { 'a', 0x2603, 'c', 'd', 'e' };
+
+  EXPECT_TRUE(isAscii(ascii, 7));
+  EXPECT_FALSE(isAscii(latin1, 5));
+  EXPECT_FALSE(isAscii(wide, 5));
+}
+
 TEST(getRegionShortcut, proxy) {
   EXPECT_EQ(apache::geode::client::PROXY, getRegionShortcut("PROXY"));
 }
@@ -28,4 +28,63 @@ describe("gemfire", function() {
       });
     });
   });
+
+  describe(".conversionStats", function() {
+    it("counts PDX type cache hits for objects with the same shape", function() {
+      const region = cache.getRegion("exampleRegion");
+      const shape = "conversionStats" + Date.now();
+      var value = {};
+      value[shape] = 1;
+
+      const before = gemfire.conversionStats().pdxTypeCache;
+      region.putSync("conversionStats1", value);
+      region.putSync("conversionStats2", value);
+      const after = gemfire.conversionStats().pdxTypeCache;
+
+      expect(after.misses - before.misses).toEqual(1);
+      expect(after.hits - before.hits).toEqual(1);
+      expect(after.size).toBeGreaterThan(0);
+    });
+
+    it("counts field name cache hits for PDX instances of the same type", function() {
+      const region = cache.getRegion("exampleRegion");
+      region.putSync("fieldNames", { foo: "bar", baz: 1 });
+      region.getSync("fieldNames");
+
+      const before = gemfire.conversionStats().fieldNameCache;
+      region.getSync("fieldNames");
+      const after = gemfire.conversionStats().fieldNameCache;
+
+      expect(after.hits - before.hits).toEqual(1);
+      expect(after.misses).toEqual(before.misses);
+    });
+  });
+
+  describe(".threadPoolStats", function() {
+    it("counts operations run on the GemFire thread pool", function(done) {
+      const region = cache.getRegion("exampleRegion");
+      const before = gemfire.threadPoolStats();
+
+      region.put("threadPoolStats", "value", function(error) {
+        expect(error).toBeFalsy();
+
+        const after = gemfire.threadPoolStats();
+        expect(after.threads).toBeGreaterThan(0);
+        expect(after.completed).toBeGreaterThan(before.completed);
+        expect(after.maxQueueDepth).toBeGreaterThan(0);
+        done();
+      });
+    });
+  });
+
+  describe(".setThreadPoolSize", function() {
+    it("throws once the thread pool has started", function() {
+      cache.getRegion("exampleRegion").putSync("started", "value");
+      cache.getRegion("exampleRegion").put("started", "value");
+
+      expect(function() { gemfire.setThreadPoolSize(4); }).toThrow(
+        new Error("gemfire: setThreadPoolSize() must be called before the first GemFire operation.")
+      );
+    });
+  });
 });
@@ -133,4 +133,113 @@ describe("Interoperability", function() {
       }
     ], done);
   });
+
+  describe("with the int64 conversion option", function() {
+    const itWithBigInt = typeof BigInt === "function" ? it : xit;
+
+    afterEach(function() {
+      cache.setConversionOptions({ int64: "number" });
+    });
+
+    itWithBigInt("interprets Java long as JavaScript BigInt in bigint mode", function(done) {
+      spyOn(console, "warn");
+      cache.setConversionOptions({ int64: "bigint" });
+
+      expectFunctionToReturn("io.pivotal.node_gemfire.ReturnPositiveAmbiguousLong", BigInt(Math.pow(2, 53)), function() {
+        expect(console.warn).not.toHaveBeenCalled();
+        done();
+      });
+    });
+
+    itWithBigInt("interprets a safe Java long as JavaScript Number in safe mode", function(done) {
+      cache.setConversionOptions({ int64: "safe" });
+      expectFunctionToReturn("io.pivotal.node_gemfire.ReturnLong", 1, done);
+    });
+
+    itWithBigInt("interprets an unsafe Java long as JavaScript BigInt in safe mode", function(done) {
+      spyOn(console, "warn");
+      cache.setConversionOptions({ int64: "safe" });
+
+      expectFunctionToReturn("io.pivotal.node_gemfire.ReturnNegativeAmbiguousLong", -BigInt(Math.pow(2, 53)), function() {
+        expect(console.warn).not.toHaveBeenCalled();
+        done();
+      });
+    });
+
+    itWithBigInt("stores JavaScript BigInt as a Java long", function(done) {
+      cache.setConversionOptions({ int64: "bigint" });
+      const value = BigInt("9007199254740993");
+
+      region.put("bigint", value, function(error) {
+        expect(error).not.toBeError();
+        region.get("bigint", function(error, result) {
+          expect(error).not.toBeError();
+          expect(result).toEqual(value);
+          done();
+        });
+      });
+    });
+
+    it("rejects unknown modes", function() {
+      function callWithUnknownMode() {
+        cache.setConversionOptions({ int64: "string" });
+      }
+
+      expect(callWithUnknownMode).toThrow(
+        new Error("setConversionOptions: int64 must be one of 'number', 'bigint' or 'safe'."));
+    });
+  });
+
+  describe("with the numberEncoding and keyEncoding conversion options", function() {
+    const gemfire = require("../support/gemfire.js");
+
+    afterEach(function() {
+      cache.setConversionOptions({ numberEncoding: "double", keyEncoding: "double" });
+    });
+
+    it("stores integral Numbers as Java integers in compact mode", function() {
+      const value = { quantity: 3, price: 1.5, total: Math.pow(2, 40) };
+      const doubleSize = gemfire.serializedSize(value);
+
+      cache.setConversionOptions({ numberEncoding: "compact" });
+      expect(gemfire.serializedSize(value)).toBeLessThan(doubleSize);
+
+      region.putSync("compact", value);
+      expect(region.getSync("compact")).toEqual(value);
+    });
+
+    it("keeps -0 and fractions as doubles in compact mode", function() {
+      cache.setConversionOptions({ numberEncoding: "compact" });
+      region.putSync("compact", [-0, 0.5, NaN]);
+
+      const result = region.getSync("compact");
+      expect(Object.is(result[0], -0)).toBe(true);
+      expect(result[1]).toEqual(0.5);
+      expect(result[2]).toBeNaN();
+    });
+
+    it("stores Number keys as Java integers in compact mode", function() {
+      cache.setConversionOptions({ keyEncoding: "compact" });
+      region.putSync(42, "integer key");
+      expect(region.getSync(42)).toEqual("integer key");
+
+      cache.setConversionOptions({ keyEncoding: "double" });
+      expect(region.getSync(42)).toBeNull();
+    });
+
+    it("reports the encodings in getConversionOptions", function() {
+      cache.setConversionOptions({ keyEncoding: "compact" });
+      expect(cache.getConversionOptions().numberEncoding).toEqual("double");
+      expect(cache.getConversionOptions().keyEncoding).toEqual("compact");
+    });
+
+    it("rejects unknown encodings", function() {
+      function callWithUnknownEncoding() {
+        cache.setConversionOptions({ numberEncoding: "int" });
+      }
+
+      expect(callWithUnknownEncoding).toThrow(
+        new Error("setConversionOptions: numberEncoding must be one of 'double' or 'compact'."));
+    });
+  });
 });
@@ -1,6 +1,7 @@
 const _ = require("lodash");
 const util = require("util");
 const async = require('async');
+const gemfire = require("./support/gemfire.js");
 const randomString = require("random-string");
 
 const factories = require('./support/factories.js');
@@ -82,6 +83,134 @@ describe("gemfire.Region", function() {
         });
       });
     });
+
+    it("throws an error if the options are not an object", function() {
+      function getWithNonObjectOptions() {
+        region.get("foo", "lazy", function(){});
+      }
+
+      expect(getWithNonObjectOptions).toThrow(new Error("You must pass an object as the options to get()."));
+    });
+
+    describe("with the lazy option", function() {
+      var object = { name: "Alice", nested: { count: 2, tags: ["a", "b"] }, list: [1, 2] };
+
+      beforeEach(function(done) {
+        region.put("lazy", object, done);
+      });
+
+      it("returns an object that reads fields on demand", function(done) {
+        region.get("lazy", { lazy: true }, function(error, value) {
+          expect(error).not.toBeError();
+          expect(value.name).toEqual("Alice");
+          expect(value.nested.count).toEqual(2);
+          expect(value.nested.tags).toEqual(["a", "b"]);
+          expect(value.missing).toBeUndefined();
+          expect("name" in value).toBeTruthy();
+          expect("missing" in value).toBeFalsy();
+          done();
+        });
+      });
+
+      it("materializes every field when enumerated", function(done) {
+        region.get("lazy", { lazy: true }, function(error, value) {
+          expect(error).not.toBeError();
+          expect(Object.keys(value).sort()).toEqual(["list", "name", "nested"]);
+          expect(JSON.parse(JSON.stringify(value))).toEqual(object);
+          done();
+        });
+      });
+
+      it("supports assigning and deleting fields", function(done) {
+        region.get("lazy", { lazy: true }, function(error, value) {
+          expect(error).not.toBeError();
+          value.name = "Bob";
+          value.extra = true;
+          delete value.list;
+
+          expect(value.name).toEqual("Bob");
+          expect(value.list).toBeUndefined();
+          expect(Object.keys(value).sort()).toEqual(["extra", "name", "nested"]);
+          done();
+        });
+      });
+
+      it("lists a field that was deleted and assigned again", function() {
+        var value = region.getSync("lazy", { lazy: true });
+        delete value.name;
+        value.name = "Bob";
+
+        expect(Object.keys(value).sort()).toEqual(["list", "name", "nested"]);
+        expect(JSON.parse(JSON.stringify(value)).name).toEqual("Bob");
+      });
+
+      it("can be inspected and leaves Symbols to the object", function() {
+        var value = region.getSync("lazy", { lazy: true });
+        expect(util.inspect(value)).toContain("Alice");
+        expect(Symbol.iterator in value).toBeFalsy();
+        expect(String(value)).toEqual("[object Object]");
+      });
+
+      it("returns non-PDX values as usual", function(done) {
+        region.put("string", "bar", function(error) {
+          expect(error).not.toBeError();
+          region.get("string", { lazy: true }, function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual("bar");
+            done();
+          });
+        });
+      });
+
+      it("is supported by getSync", function() {
+        var value = region.getSync("lazy", { lazy: true });
+        expect(value.nested.count).toEqual(2);
+        expect(JSON.parse(JSON.stringify(value))).toEqual(object);
+      });
+    });
+
+    describe("with the fields option", function() {
+      var object = { name: "Alice", nested: { count: 2, tags: ["a", "b"] }, list: [1, 2] };
+
+      beforeEach(function(done) {
+        region.put("fields", object, done);
+      });
+
+      it("returns only the selected fields", function(done) {
+        region.get("fields", { fields: ["name", "nested.count", "missing"] }, function(error, value) {
+          expect(error).not.toBeError();
+          expect(value).toEqual({ name: "Alice", nested: { count: 2 } });
+          done();
+        });
+      });
+
+      it("projects every value of getAll and the msgpack codec", function(done) {
+        region.setCodec("msgpack");
+        async.series([
+          function(next) { region.put("encoded", object, next); },
+          function(next) {
+            region.getAll(["fields", "encoded"], { fields: ["nested"] }, function(error, values) {
+              expect(error).not.toBeError();
+              expect(values).toEqual({ fields: { nested: object.nested }, encoded: { nested: object.nested } });
+              next();
+            });
+          }
+        ], function(error) {
+          region.setCodec("pdx");
+          done(error);
+        });
+      });
+
+      it("is supported by getSync", function() {
+        expect(region.getSync("fields", { fields: ["list"] })).toEqual({ list: [1, 2] });
+      });
+
+      it("throws an error for invalid field names", function() {
+        expect(function() { region.getSync("fields", { fields: ["a..b"] }); }).toThrow(
+          new Error("You must pass an array of field names as the fields option to getSync().")
+        );
+      });
+    });
   });
 
   describe(".getSync", function() {
@@ -220,6 +349,266 @@ describe("gemfire.Region", function() {
 
   });
 
+  describe(".update", function() {
+    const value = { name: "order", status: "new", quantity: 3 };
+
+    it("replaces and adds the changed fields", function(done) {
+      async.series([
+        function(next) { region.put("order", value, next); },
+        function(next) { region.update("order", { status: "shipped", carrier: "ups" }, next); },
+        function(next) {
+          region.get("order", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result).toEqual({ name: "order", status: "shipped", quantity: 3, carrier: "ups" });
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("keeps the typed fields of a registered schema", function(done) {
+      cache.registerSchema("com.example.Order", { name: "string", quantity: "int" });
+      const order = { name: "order", quantity: 3 };
+      order[gemfire.schemaSymbol] = "com.example.Order";
+
+      async.series([
+        function(next) { region.put("order", order, next); },
+        function(next) { region.update("order", { quantity: 4 }, next); },
+        function(next) {
+          region.get("order", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result.name).toEqual("order");
+            expect(result.quantity).toEqual(4);
+            next();
+          });
+        },
+        function(next) {
+          region.update("order", { carrier: "ups" }, function(error) {
+            expect(error).toBeError("apache::geode::client::CacheServerException", /cannot add the field carrier/);
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("gives the merged object the PDX class name that put gives it", function(done) {
+      const value = { "x[y]": "new", "a,b": 2, tags: ["one", "two"] };
+
+      async.series([
+        function(next) { region.put("put", value, next); },
+        function(next) { region.put("updated", { "x[y]": "old" }, next); },
+        function(next) { region.update("updated", { "x[y]": "new", "a,b": 2, tags: ["one", "two"] }, next); },
+        function(next) { region.get("put", next); },
+        function(next) {
+          // Field names are cached per class name, so a different class name would add an entry.
+          const fieldNameCacheSize = gemfire.conversionStats().fieldNameCache.size;
+          region.get("updated", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result).toEqual(value);
+            expect(gemfire.conversionStats().fieldNameCache.size).toEqual(fieldNameCacheSize);
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("stores the changes when there is no entry", function(done) {
+      async.series([
+        function(next) { region.update("missing", { status: "new" }, next); },
+        function(next) {
+          region.get("missing", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result).toEqual({ status: "new" });
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("throws an error when the changes are not an object", function() {
+      expect(function() { region.update("order", "shipped"); }).toThrow(
+        new Error("You must pass a key and an object of changed fields to update().")
+      );
+    });
+
+    it("throws an error for a msgpack region", function() {
+      region.setCodec("msgpack");
+      try {
+        expect(function() { region.update("order", { status: "shipped" }); }).toThrow(
+          new Error("update() requires a region that stores values as uncompressed PDX.")
+        );
+      } finally {
+        region.setCodec("pdx");
+      }
+    });
+  });
+
+  describe("conditional writes", function() {
+    it("puts a value only if the key is absent", function(done) {
+      async.series([
+        function(next) {
+          region.putIfAbsent("lock", "first", function(error, current) {
+            expect(error).not.toBeError();
+            expect(current).toBeNull();
+            next();
+          });
+        },
+        function(next) {
+          region.putIfAbsent("lock", "second", function(error, current) {
+            expect(error).not.toBeError();
+            expect(current).toEqual("first");
+            expect(region.getSync("lock")).toEqual("first");
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("replaces a value only if it equals the expected value", function(done) {
+      async.series([
+        function(next) { region.put("config", { version: 1 }, next); },
+        function(next) {
+          region.replace("config", { version: 2 }, { version: 3 }, function(error, replaced) {
+            expect(error).not.toBeError();
+            expect(replaced).toBe(false);
+            next();
+          });
+        },
+        function(next) {
+          region.replace("config", { version: 1 }, { version: 2 }, function(error, replaced) {
+            expect(error).not.toBeError();
+            expect(replaced).toBe(true);
+            expect(region.getSync("config")).toEqual({ version: 2 });
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("removes a value only if it equals the expected value", function(done) {
+      async.series([
+        function(next) { region.put("token", "abc", next); },
+        function(next) {
+          region.removeIfEquals("token", "xyz", function(error, removed) {
+            expect(error).not.toBeError();
+            expect(removed).toBe(false);
+            next();
+          });
+        },
+        function(next) {
+          region.removeIfEquals("token", "abc", function(error, removed) {
+            expect(error).not.toBeError();
+            expect(removed).toBe(true);
+            expect(region.getSync("token")).toBeNull();
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("increments a number, starting from the delta", function(done) {
+      async.times(10, function(n, next) {
+        region.increment("counter", 2, next);
+      }, function(error) {
+        expect(error).not.toBeError();
+        expect(region.getSync("counter")).toEqual(20);
+        expect(region.incrementSync("counter", -5)).toEqual(15);
+        done();
+      });
+    });
+
+    it("passes an error to the callback when incrementing a value that is not a number", function(done) {
+      region.putSync("name", "not a number");
+      region.increment("name", 1, function(error) {
+        expect(error).toBeError();
+        done();
+      });
+    });
+
+    it("has synchronous forms", function() {
+      expect(region.putIfAbsentSync("sync", 1)).toBeNull();
+      expect(region.replaceSync("sync", 1, 2)).toBe(true);
+      expect(region.removeIfEqualsSync("sync", 1)).toBe(false);
+      expect(region.removeIfEqualsSync("sync", 2)).toBe(true);
+    });
+
+    it("compares the encoded values of a msgpack region", function() {
+      region.setCodec("msgpack");
+      try {
+        region.putSync("config", { version: 1, owner: "ops" });
+        expect(region.replaceSync("config", { owner: "ops", version: 1 }, { version: 2 })).toBe(false);
+        expect(region.replaceSync("config", { version: 1, owner: "ops" }, { version: 2 })).toBe(true);
+        expect(region.removeIfEqualsSync("config", { version: 2 })).toBe(true);
+      } finally {
+        region.setCodec("pdx");
+      }
+    });
+
+    it("throws an error when the values are missing", function() {
+      expect(function() { region.replace("key", "expected"); }).toThrow(
+        new Error("You must pass a key and the expected and new values to replace().")
+      );
+      expect(function() { region.increment("key", "1"); }).toThrow(
+        new Error("You must pass a key and a number to increment().")
+      );
+      expect(function() { region.putIfAbsentSync("key"); }).toThrow(
+        new Error("You must pass a key and value to putIfAbsentSync().")
+      );
+    });
+
+    it("throws an error when incrementing in a msgpack region", function() {
+      region.setCodec("msgpack");
+      try {
+        expect(function() { region.increment("counter", 1); }).toThrow(
+          new Error("increment() requires a region that stores values as uncompressed PDX.")
+        );
+      } finally {
+        region.setCodec("pdx");
+      }
+    });
+  });
+
+  describe("promise methods", function() {
+    it("puts and gets values", function(done) {
+      region.putAsync("key", { foo: "bar" }).then(function() {
+        return region.getAsync("key");
+      }).then(function(value) {
+        expect(value).toEqual({ foo: "bar" });
+        return region.putAllAsync({ first: 1, second: 2 });
+      }).then(function() {
+        return region.getAllAsync(["first", "second"]);
+      }).then(function(values) {
+        expect(values).toEqual({ first: 1, second: 2 });
+        return region.removeAsync("key");
+      }).then(function() {
+        return region.getAsync("key");
+      }).then(function(value) {
+        expect(value).toBeNull();
+      }).then(done, done.fail);
+    });
+
+    it("accepts get options", function(done) {
+      region.putSync("customer", { name: "Jane", age: 40 });
+      region.getAsync("customer", { fields: ["name"] }).then(function(value) {
+        expect(value).toEqual({ name: "Jane" });
+      }).then(done, done.fail);
+    });
+
+    it("rejects with GemFire errors", function(done) {
+      region.removeAsync("missing").then(done.fail, function(error) {
+        expect(error).toBeError("KeyNotFoundError", "Key not found in region.");
+        done();
+      });
+    });
+
+    it("throws an error for invalid arguments", function() {
+      expect(function() { region.getAsync(); }).toThrow(new Error("You must pass a key to getAsync()."));
+      expect(function() { region.putAsync("key"); }).toThrow(
+        new Error("You must pass a key and value to putAsync().")
+      );
+    });
+  });
+
   describe(".putSync", function() {
     it("throws an error when no key is passed", function() {
       function putWithNoArgs() {
@@ -313,6 +702,8 @@ describe("gemfire.Region", function() {
       "",
       "foo",
       "\u0123\u4567\u89AB\uCDEF\uabcd\uef4A",
+      "caf\u00e9 cr\u00e8me",
+      "ascii in a two-byte string \u2603".slice(0, -1),
     ], function(string) {
       it("stores and retrieves strings like " + util.inspect(string), function(done) {
         testRoundTrip(string, done);
@@ -392,6 +783,22 @@ describe("gemfire.Region", function() {
       });
     });
 
+    _.each([
+      Buffer.from([0, 1, 2, 254, 255]),
+      new Int16Array([-32768, 0, 32767]),
+      new Int32Array([-2147483648, 0, 2147483647]),
+      new Float32Array([1.5, -0.25]),
+      new Float64Array([Math.PI, -Infinity, 1e300]),
+    ], function(typedArray) {
+      it("stores and retrieves " + typedArray.constructor.name + "s", function(done) {
+        testRoundTrip(typedArray, done);
+      });
+    });
+
+    it("stores and retrieves typed arrays nested in objects", function(done) {
+      testRoundTrip({ image: Buffer.from("image bytes"), embedding: new Float64Array([0.1, 0.2]) }, done);
+    });
+
     it("stores and retrieves sparse arrays", function(done) {
       var sparseArray = [];
       sparseArray[10] = 'an element';
@@ -562,104 +969,504 @@ describe("gemfire.Region", function() {
         ], done);
       });
 
-      it("stores and retrieves objects with date keys", function(done) {
-        var date = new Date();
-        region.put(date, "date key", function(error){
-          expect(error).not.toBeError();
-          region.get(date, function(error, value) {
-            expect(error).not.toBeError();
-            expect(value).toEqual("date key");
-            done();
-          });
-        });
+      it("stores and retrieves objects with date keys", function(done) {
+        var date = new Date();
+        region.put(date, "date key", function(error){
+          expect(error).not.toBeError();
+          region.get(date, function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual("date key");
+            done();
+          });
+        });
+      });
+
+      it("stores and retrieves objects with boolean keys", function(done) {
+        async.series([
+          function(callback) {
+            region.put(true, "true key", function(error) {
+              expect(error).not.toBeError();
+              callback();
+            });
+          },
+          function(callback) {
+            region.put(false, "false key", function(error) {
+              expect(error).not.toBeError();
+              callback();
+            });
+          },
+          function(callback) {
+            region.put("true", "true string key", function(error) {
+              expect(error).not.toBeError();
+              callback();
+            });
+          },
+          function(callback) {
+            region.put("false", "false string key", function(error) {
+              expect(error).not.toBeError();
+              callback();
+            });
+          },
+          function(callback) {
+            region.get(true, function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual("true key");
+              callback();
+            });
+          },
+          function(callback) {
+            region.get(false, function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual("false key");
+              callback();
+            });
+          },
+          function(callback) {
+            region.get("true", function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual("true string key");
+              callback();
+            });
+          },
+          function(callback) {
+            region.get("false", function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual("false string key");
+              callback();
+            });
+          },
+        ], done);
+      });
+
+      it("allows dynamic schema", function(done) {
+        async.series([
+          function(callback) { region.put('foo', {}, callback); },
+          function(callback) {
+            region.get('foo', function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual({});
+              callback();
+            });
+          },
+          function(callback) { region.put('foo', { baz: 'qux' }, callback); },
+          function(callback) {
+            region.get('foo', function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual({ baz: "qux" });
+              callback();
+            });
+          },
+          function(callback) { region.put('foo', { baz: [] }, callback); },
+          function(callback) {
+            region.get('foo', function(error, value) {
+              expect(error).not.toBeError();
+              expect(value).toEqual({ baz: [] });
+              callback();
+            });
+          },
+        ], done);
+      });
+    });
+  });
+
+  describe(".putJSON/.getJSON", function() {
+    const object = {
+      string: "café 😀 \"quoted\"\n",
+      number: 1.5,
+      integer: -42,
+      boolean: true,
+      nothing: null,
+      array: [1, "two", { three: 3 }],
+      nested: { 10: "ten", 2: "two", name: "nested" }
+    };
+
+    it("stores JSON text as the value JSON.parse would give", function(done) {
+      async.series([
+        function(next) { region.putJSON("json", JSON.stringify(object), next); },
+        function(next) {
+          region.get("json", function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual(object);
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("returns the JSON text JSON.stringify would give", function(done) {
+      async.series([
+        function(next) { region.put("json", object, next); },
+        function(next) {
+          region.getJSON("json", function(error, json) {
+            expect(error).not.toBeError();
+            expect(json).toEqual(JSON.stringify(object));
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("stores objects with the same PDX type as put", function(done) {
+      async.series([
+        function(next) { region.put("put", { foo: "bar", baz: [1] }, next); },
+        function(next) { region.putJSON("putJSON", '{"foo":"bar","baz":[1]}', next); },
+        function(next) {
+          region.query("foo = 'bar'", function(error, response) {
+            expect(error).not.toBeError();
+            expect(response.toArray().length).toEqual(2);
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("passes a SyntaxError to the callback for invalid JSON", function(done) {
+      region.putJSON("json", '{"foo": }', function(error) {
+        expect(error).toBeError("SyntaxError", "Unexpected token } in JSON at position 8");
+        done();
+      });
+    });
+
+    it("passes null to the callback for a nonexistent key", function(done) {
+      region.getJSON("baz", function(error, json) {
+        expect(error).not.toBeError();
+        expect(json).toBeNull();
+        done();
+      });
+    });
+
+    it("throws an error if a JSON string is not passed", function() {
+      function putJSONWithObject() {
+        region.putJSON("json", { foo: "bar" });
+      }
+      expect(putJSONWithObject).toThrow(new Error("You must pass a key and a JSON string to putJSON()."));
+    });
+
+    it("stores and returns several entries with putAllJSON and getAllJSON", function(done) {
+      async.series([
+        function(next) { region.putAllJSON('{"key1":"value1","key2":{"foo":"bar"}}', next); },
+        function(next) {
+          region.getAllJSON(["key1", "key2", "unknownKey"], function(error, json) {
+            expect(error).not.toBeError();
+            expect(JSON.parse(json)).toEqual({ key1: "value1", key2: { foo: "bar" }, unknownKey: null });
+            next();
+          });
+        }
+      ], done);
+    });
+  });
+
+  describe(".setCodec", function() {
+    afterEach(function() {
+      region.setCodec("pdx");
+    });
+
+    it("round trips values through the msgpack codec", function(done) {
+      const value = {
+        string: "café 😀",
+        integer: -42,
+        number: 1.5,
+        boolean: false,
+        nothing: null,
+        date: new Date(1500000000123),
+        buffer: Buffer.from([1, 2, 3]),
+        array: [1, "two", { three: 3 }]
+      };
+
+      expect(region.setCodec("msgpack")).toBe(region);
+      expect(region.codec).toEqual("msgpack");
+      expect(cache.getRegion("exampleRegion").codec).toEqual("msgpack");
+
+      async.series([
+        function(next) { region.put("msgpack", value, next); },
+        function(next) {
+          region.get("msgpack", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result).toEqual(value);
+            next();
+          });
+        },
+        function(next) {
+          region.getJSON("msgpack", function(error, json) {
+            expect(error).not.toBeError();
+            expect(json).toEqual(JSON.stringify(value));
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("stores the encoded value as a byte array", function(done) {
+      region.setCodec("msgpack");
+      region.putSync("msgpack", { foo: "bar" });
+      region.setCodec("pdx");
+
+      region.get("msgpack", function(error, result) {
+        expect(error).not.toBeError();
+        expect(Buffer.isBuffer(result)).toBeTruthy();
+        expect(result.slice(0, 3).toString()).toEqual("NGF");
+        done();
+      });
+    });
+
+    it("passes an error for a value nested too deeply", function(done) {
+      // The msgpack envelope followed by 5000 nested one element arrays.
+      const nested = Buffer.concat([Buffer.from("NGF\x01"), Buffer.alloc(5000, 0x91), Buffer.from([0xc0])]);
+      region.putSync("nested", nested);
+      region.setCodec("msgpack");
+
+      region.get("nested", function(error) {
+        expect(error).toBeError(
+          "apache::geode::client::IllegalStateException", "MessagePack value is nested too deeply."
+        );
+        done();
+      });
+    });
+
+    it("stores invalid Dates as null", function() {
+      region.setCodec("msgpack");
+      region.putSync("date", { date: new Date(NaN) });
+      expect(region.getSync("date")).toEqual({ date: null });
+    });
+
+    it("throws an error for an unknown codec", function() {
+      expect(function() { region.setCodec("cbor"); }).toThrow(
+        new Error("You must pass 'pdx' or 'msgpack' as the codec to setCodec().")
+      );
+    });
+  });
+
+  describe(".setCompressionThreshold", function() {
+    afterEach(function() {
+      region.setCompressionThreshold(0);
+      region.setCodec("pdx");
+    });
+
+    const value = { text: new Array(1000).join("compressible "), count: 3 };
+
+    it("round trips large values through compression", function(done) {
+      const compressedValues = gemfire.conversionStats().compression.compressedValues;
+
+      expect(region.setCompressionThreshold(256)).toBe(region);
+      expect(region.compressionThreshold).toEqual(256);
+
+      async.series([
+        function(next) { region.put("compressed", value, next); },
+        function(next) {
+          region.get("compressed", function(error, result) {
+            expect(error).not.toBeError();
+            expect(result).toEqual(value);
+            expect(gemfire.conversionStats().compression.compressedValues).toBeGreaterThan(compressedValues);
+            next();
+          });
+        },
+        function(next) {
+          region.getJSON("compressed", function(error, json) {
+            expect(error).not.toBeError();
+            expect(json).toEqual(JSON.stringify(value));
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("compresses values of a msgpack region", function() {
+      region.setCodec("msgpack").setCompressionThreshold(256);
+      region.putSync("compressed", value);
+      expect(region.getSync("compressed")).toEqual(value);
+    });
+
+    it("leaves small values uncompressed", function() {
+      region.setCompressionThreshold(256);
+      region.putSync("small", { foo: "bar" });
+      region.setCompressionThreshold(0);
+
+      expect(region.getSync("small")).toEqual({ foo: "bar" });
+    });
+
+    it("round trips Buffers that start like an envelope", function(done) {
+      const messagePackLike = Buffer.from("NGF\x01\x81\xa3foo\xa3bar", "latin1");
+      const compressedLike = Buffer.from("NGF\x02\x01\xff\xff\xff\x7f\x00\x00\x00\x00", "latin1");
+      region.setCompressionThreshold(256);
+      region.putSync("messagePackLike", messagePackLike);
+      region.putSync("compressedLike", compressedLike);
+
+      expect(region.getSync("messagePackLike")).toEqual(messagePackLike);
+      expect(region.getSync("compressedLike")).toEqual(compressedLike);
+      region.getAll(["messagePackLike", "compressedLike"], function(error, values) {
+        expect(error).not.toBeError();
+        expect(values).toEqual({ messagePackLike: messagePackLike, compressedLike: compressedLike });
+        done();
+      });
+    });
+
+    it("passes an error for a compressed length that the value cannot hold", function(done) {
+      // An LZ4 envelope claiming 2 GB of msgpack for four bytes of payload.
+      region.putSync("corrupt", Buffer.from("NGF\x02\x01\xff\xff\xff\x7f\x00\x00\x00\x00", "latin1"));
+      region.setCompressionThreshold(256);
+
+      region.get("corrupt", function(error) {
+        expect(error).toBeError("apache::geode::client::IllegalStateException", "Corrupt compressed value.");
+        done();
+      });
+    });
+
+    it("throws an error for a negative threshold", function() {
+      expect(function() { region.setCompressionThreshold(-1); }).toThrow(
+        new Error("You must pass a number of bytes to setCompressionThreshold().")
+      );
+    });
+  });
+
+  describe(".setReadCombining", function() {
+    afterEach(function() {
+      region.setReadCombining(false);
+    });
+
+    it("answers gets of the same and of different keys in one turn", function(done) {
+      region.putAllSync({ first: "one", second: "two" });
+      expect(region.setReadCombining(true)).toBe(region);
+
+      async.parallel([
+        function(next) { region.get("first", next); },
+        function(next) { region.get("first", next); },
+        function(next) { region.get("second", next); },
+        function(next) { region.get("missing", next); }
+      ], function(error, values) {
+        expect(error).not.toBeError();
+        expect(values).toEqual(["one", "one", "two", null]);
+        done();
+      });
+    });
+
+    it("does not share a fetch sent before a write of the key", function(done) {
+      region.putSync("key", "old");
+      region.setReadCombining(true);
+
+      region.get("key", function(error) {
+        expect(error).not.toBeError();
+      });
+      setImmediate(function() {
+        region.putSync("key", "new");
+        region.get("key", function(error, value) {
+          expect(error).not.toBeError();
+          expect(value).toEqual("new");
+          done();
+        });
+      });
+    });
+
+    it("throws an error for invalid options", function() {
+      expect(function() { region.setReadCombining({ maxBatchSize: -1 }); }).toThrow(
+        new Error("setReadCombining: maxBatchSize must be a positive number.")
+      );
+    });
+  });
+
+  describe(".setNearCache", function() {
+    afterEach(function() {
+      region.setNearCache(false);
+    });
+
+    it("answers repeated gets with the same frozen value", function(done) {
+      // The create event of the put would invalidate the key, so it is awaited first.
+      region.once("create", function() {
+        expect(region.setNearCache(true)).toBe(region);
+
+        const first = region.getSync("key");
+        expect(first).toEqual({ foo: "bar" });
+        expect(Object.isFrozen(first)).toBe(true);
+
+        region.get("key", function(error, value) {
+          expect(error).not.toBeError();
+          expect(value).toBe(first);
+          const stats = region.nearCacheStats();
+          expect(stats).toEqual(jasmine.objectContaining({ entries: 1, hits: 1, misses: 1 }));
+          done();
+        });
+      });
+      region.putSync("key", { foo: "bar" });
+    });
+
+    it("invalidates a key written through the region", function() {
+      region.putSync("key", "old");
+      region.setNearCache(true);
+      expect(region.getSync("key")).toEqual("old");
+
+      region.putSync("key", "new");
+      expect(region.getSync("key")).toEqual("new");
+      expect(region.nearCacheStats().invalidations).toEqual(1);
+    });
+
+    it("returns undefined stats when the cache is off", function() {
+      expect(region.nearCacheStats()).toBeUndefined();
+    });
+
+    it("throws an error for invalid options", function() {
+      expect(function() { region.setNearCache({ maxEntries: 0 }); }).toThrow(
+        new Error("setNearCache: maxEntries must be a positive number.")
+      );
+      expect(function() { region.setNearCache({ maxBytes: "big" }); }).toThrow(
+        new Error("setNearCache: maxBytes must be a positive number.")
+      );
+    });
+  });
+
+  describe(".setWriteBatching", function() {
+    afterEach(function(done) {
+      region.setWriteBatching(false).flushWrites(done);
+    });
+
+    it("writes batched puts and calls back every writer", function(done) {
+      expect(region.setWriteBatching({ windowMilliseconds: 5 })).toBe(region);
+
+      async.parallel([
+        function(next) { region.put("first", "one", next); },
+        function(next) { region.put("second", "two", next); },
+        function(next) { region.put("first", "three", next); }
+      ], function(error) {
+        expect(error).not.toBeError();
+        region.setWriteBatching(false);
+        expect(region.getAllSync(["first", "second"])).toEqual({ first: "three", second: "two" });
+        done();
       });
+    });
 
-      it("stores and retrieves objects with boolean keys", function(done) {
-        async.series([
-          function(callback) {
-            region.put(true, "true key", function(error) {
-              expect(error).not.toBeError();
-              callback();
-            });
-          },
-          function(callback) {
-            region.put(false, "false key", function(error) {
-              expect(error).not.toBeError();
-              callback();
-            });
-          },
-          function(callback) {
-            region.put("true", "true string key", function(error) {
-              expect(error).not.toBeError();
-              callback();
-            });
-          },
-          function(callback) {
-            region.put("false", "false string key", function(error) {
-              expect(error).not.toBeError();
-              callback();
-            });
-          },
-          function(callback) {
-            region.get(true, function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual("true key");
-              callback();
-            });
-          },
-          function(callback) {
-            region.get(false, function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual("false key");
-              callback();
-            });
-          },
-          function(callback) {
-            region.get("true", function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual("true string key");
-              callback();
-            });
-          },
-          function(callback) {
-            region.get("false", function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual("false string key");
-              callback();
-            });
-          },
-        ], done);
+    it("returns buffered values before they have been written", function(done) {
+      region.setWriteBatching({ windowMilliseconds: 50 });
+      region.putSync("written", "value");
+      region.put("buffered", { foo: "bar" }, done);
+
+      expect(region.getSync("buffered")).toEqual({ foo: "bar" });
+      expect(region.getAllSync(["buffered", "written"])).toEqual({ buffered: { foo: "bar" }, written: "value" });
+    });
+
+    it("removes a key only after its buffered put has been written", function(done) {
+      region.setWriteBatching({ windowMilliseconds: 50 });
+      region.put("key", "value");
+      region.remove("key", function(error) {
+        expect(error).not.toBeError();
+        region.setWriteBatching(false);
+        expect(region.getSync("key")).toBeNull();
+        done();
       });
+    });
 
-      it("allows dynamic schema", function(done) {
-        async.series([
-          function(callback) { region.put('foo', {}, callback); },
-          function(callback) {
-            region.get('foo', function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual({});
-              callback();
-            });
-          },
-          function(callback) { region.put('foo', { baz: 'qux' }, callback); },
-          function(callback) {
-            region.get('foo', function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual({ baz: "qux" });
-              callback();
-            });
-          },
-          function(callback) { region.put('foo', { baz: [] }, callback); },
-          function(callback) {
-            region.get('foo', function(error, value) {
-              expect(error).not.toBeError();
-              expect(value).toEqual({ baz: [] });
-              callback();
-            });
-          },
-        ], done);
+    it("calls flushWrites() back once buffered puts are written", function(done) {
+      region.setWriteBatching({ windowMilliseconds: 1000 });
+      region.put("key", "value");
+      region.flushWrites(function() {
+        region.setWriteBatching(false);
+        expect(region.getSync("key")).toEqual("value");
+        done();
       });
     });
+
+    it("throws an error for invalid options", function() {
+      expect(function() { region.setWriteBatching({ maxBatchSize: 0 }); }).toThrow(
+        new Error("setWriteBatching: maxBatchSize must be a positive number.")
+      );
+    });
   });
 
   describe(".clear", function(){
@@ -826,6 +1633,12 @@ describe("gemfire.Region", function() {
     });
   });
 
+  describe(".fullPath", function() {
+    it("returns the full path of the region", function() {
+      expect(region.fullPath).toEqual("/exampleRegion");
+    });
+  });
+
   describe(".attributes", function() {
     describe(".cachingEnabled", function() {
       describe("for a caching proxy region", function() {
@@ -1200,6 +2013,88 @@ describe("gemfire.Region", function() {
   });
 
   describe(".putAll", function() {
+    it("stores nested objects, typed arrays and non-ASCII strings", function(done) {
+      var values = {
+        "\u00fcber": { name: "\u2603", tags: ["a", "\u00e9"], when: new Date(1234567890000) },
+        plain: { bytes: new Buffer([1, 2, 3]), doubles: new Float64Array([0.5, 1.5]), flag: false }
+      };
+
+      async.series([
+        function(next) { region.putAll(values, next); },
+        function(next) {
+          region.getAll(["\u00fcber", "plain"], function(error, results) {
+            expect(error).not.toBeError();
+            expect(results["\u00fcber"]).toEqual(values["\u00fcber"]);
+            expect(results.plain.bytes).toEqual(values.plain.bytes);
+            expect(Array.prototype.slice.call(results.plain.doubles)).toEqual([0.5, 1.5]);
+            expect(results.plain.flag).toBe(false);
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("stores the entries of a Map with keys of any type", function(done) {
+      var entries = new Map([[1, "number one"], ["1", "string one"], [true, "yes"]]);
+
+      async.series([
+        function(next) { region.putAll(entries, next); },
+        function(next) {
+          region.get(1, function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual("number one");
+            next();
+          });
+        },
+        function(next) {
+          region.get("1", function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual("string one");
+            next();
+          });
+        },
+        function(next) {
+          region.get(true, function(error, value) {
+            expect(error).not.toBeError();
+            expect(value).toEqual("yes");
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("stores an array of [key, value] pairs", function(done) {
+      async.series([
+        function(next) { region.putAll([[2, { two: 2 }], ["two", "2"]], next); },
+        function(next) {
+          region.getAll([2, "two"], { map: true }, function(error, values) {
+            expect(error).not.toBeError();
+            expect(values.get(2)).toEqual({ two: 2 });
+            expect(values.get("two")).toEqual("2");
+            next();
+          });
+        }
+      ], done);
+    });
+
+    it("throws an error when an array entry is not a [key, value] pair", function() {
+      function callWithBadPair() {
+        region.putAll([["key", "value"], ["lonely"]], function(){});
+      }
+
+      expect(callWithBadPair).toThrow(
+        new Error("Unable to serialize to GemFire; entries must be [key, value] pairs.")
+      );
+    });
+
+    it("throws an error when a Map has a null key", function() {
+      function callWithNullKey() {
+        region.putAll(new Map([[null, "value"]]), function(){});
+      }
+
+      expect(callWithNullKey).toThrow(new Error("Invalid GemFire key."));
+    });
+
     it("sets multiple values at once async", function(done) {
       async.series([
         function(next) {
@@ -1377,6 +2272,23 @@ describe("gemfire.Region", function() {
       expect(region.putAllSync({ key: 'value' })).toEqual(region);
     });
 
+    it("stores the entries of a Map with keys of any type", function() {
+      region.putAllSync(new Map([[3, "number three"], ["3", "string three"]]));
+
+      expect(region.getSync(3)).toEqual("number three");
+      expect(region.getSync("3")).toEqual("string three");
+    });
+
+    it("stores Number keys with the key encoding rather than the number encoding", function() {
+      cache.setConversionOptions({ numberEncoding: "compact", keyEncoding: "double" });
+      try {
+        region.putAllSync(new Map([[4, "number four"]]));
+        expect(region.getSync(4)).toEqual("number four");
+      } finally {
+        cache.setConversionOptions({ numberEncoding: "double" });
+      }
+    });
+
     it("requires a map argument", function() {
       function callWithNoArgs() {
         region.putAllSync();
@@ -1400,6 +2312,73 @@ describe("gemfire.Region", function() {
     });
   });
 
+  describe(".setBulkChunking", function() {
+    afterEach(function() {
+      region.setBulkChunking(false);
+    });
+
+    const entries = {};
+    for (var i = 0; i < 25; i++) {
+      entries["key" + i] = i;
+    }
+
+    it("puts and gets in chunks and reports each chunk", function(done) {
+      expect(region.setBulkChunking({ chunkSize: 10, concurrency: 2 })).toBe(region);
+
+      region.putAll(entries, function(error, report) {
+        expect(error).not.toBeError();
+        expect(_.map(report.chunks, "size")).toEqual([10, 10, 5]);
+
+        region.getAll(Object.keys(entries), function(error, values, report) {
+          expect(error).not.toBeError();
+          expect(values).toEqual(entries);
+          expect(report.chunks.length).toEqual(3);
+          expect(report.chunks[0].milliseconds).toBeGreaterThan(0);
+          done();
+        });
+      });
+    });
+
+    it("resolves the promise methods with merged values", function(done) {
+      region.setBulkChunking({ chunkSize: 7 });
+      region.putAllAsync(entries).then(function() {
+        return region.getAllAsync(Object.keys(entries));
+      }).then(function(values) {
+        expect(values).toEqual(entries);
+      }).then(done, done.fail);
+    });
+
+    it("reports a chunk that cannot be serialized without failing the others", function(done) {
+      region.setBulkChunking({ chunkSize: 10 });
+      const badEntries = Object.assign({}, entries, { key15: function() {} });
+
+      region.putAll(badEntries, function(error, report) {
+        expect(error).toBeError();
+        expect(_.map(report.chunks, "size")).toEqual([10, 10, 5]);
+        expect(report.chunks[0].error).toBeUndefined();
+        expect(report.chunks[1].error).toBeError();
+        expect(report.chunks[2].error).toBeUndefined();
+        expect(region.getSync("key24")).toEqual(24);
+        done();
+      });
+    });
+
+    it("does not chunk calls of one chunk or less", function(done) {
+      region.setBulkChunking({ chunkSize: 100 });
+      region.getAll(["key1"], function(error, values, report) {
+        expect(error).not.toBeError();
+        expect(report).toBeUndefined();
+        done();
+      });
+    });
+
+    it("throws an error for invalid options", function() {
+      expect(function() { region.setBulkChunking({ concurrency: 0 }); }).toThrow(
+        new Error("setBulkChunking: concurrency must be a positive number.")
+      );
+    });
+  });
+
   describe(".getAll", function() {
     it("passes the results as an array to the callback", function(done) {
       async.series([
@@ -1424,6 +2403,21 @@ describe("gemfire.Region", function() {
       expect(region.getAll(['key'], function(){})).toEqual(region);
     });
 
+    it("passes the results as a Map keyed by the original keys with the map option", function(done) {
+      async.series([
+        function(next) { region.putAll(new Map([[1, "one"], ["1", { one: 1 }]]), next); },
+        function(next) {
+          region.getAll([1, "1"], { map: true }, function(error, values) {
+            expect(error).not.toBeError();
+            expect(values instanceof Map).toBe(true);
+            expect(values.get(1)).toEqual("one");
+            expect(values.get("1")).toEqual({ one: 1 });
+            next();
+          });
+        }
+      ], done);
+    });
+
     it("requires a keys argument", function() {
       function callWithNoArgs() {
         region.getAll();
@@ -1456,6 +2450,21 @@ describe("gemfire.Region", function() {
       expect(callWithNonArray).toThrow(new Error("You must pass an array of keys and a callback to getAll()."));
     });
 
+    it("returns lazy PDX proxies with the lazy option", function(done) {
+      async.series([
+        function(next) { region.put('key1', { foo: 'bar' }, next); },
+        function(next) { region.put('key2', 'value2', next); },
+        function(next) {
+          region.getAll(['key1', 'key2'], { lazy: true }, function(error, values) {
+            expect(error).not.toBeError();
+            expect(values.key1.foo).toEqual('bar');
+            expect(values.key2).toEqual('value2');
+            next();
+          });
+        }
+      ], done);
+    });
+
     it("passes an empty object to the callback when provided with no keys", function(done){
       region.getAll([], function(error, response) {
         expect(error).not.toBeError();
@@ -1521,6 +2530,16 @@ describe("gemfire.Region", function() {
       expect(results).toEqual({});
     });
 
+    it("returns a Map with the map option", function() {
+      region.putAllSync([[4, "four"], ["four", 4]]);
+
+      var results = region.getAllSync([4, "four"], { map: true });
+      expect(results instanceof Map).toBe(true);
+      expect(results.get(4)).toEqual("four");
+      expect(results.get("four")).toEqual(4);
+      expect(region.getAllSync([], { map: true }).size).toEqual(0);
+    });
+
     _.each(invalidKeys, function(invalidKey) {
       it("returns an error when passed the invalid key " + util.inspect(invalidKey), function() {
         function callWithInvalidKeys() {
@@ -1659,6 +2678,26 @@ describe("gemfire.Region", function() {
       ], done);
     });
 
+    it("passes nested objects, dates and non-ASCII strings through unchanged", function(done) {
+      var value = {
+        name: "caf\u00e9 \u2603",
+        when: new Date(1234567890000),
+        nested: { list: [1, "two", { three: true }], empty: {} },
+        missing: null
+      };
+
+      async.series([
+        function(next) { region.put("nested", value, next); },
+        function(next) {
+          region.entries(function(error, pairs) {
+            expect(error).not.toBeError();
+            expect(pairs).toEqual([{ key: "nested", value: value }]);
+            next();
+          });
+        },
+      ], done);
+    });
+
     it("throws an exception when no callback is passed", function() {
       function callWithNoArgs() {
         region.entries();
@@ -1676,6 +2715,64 @@ describe("gemfire.Region", function() {
     });
   });
 
+  describe("streams", function() {
+    function readAll(stream, done) {
+      const items = [];
+      stream.on("data", function(item) { items.push(item); });
+      stream.on("error", done.fail);
+      stream.on("end", function() { done(items); });
+    }
+
+    beforeEach(function() {
+      const entries = {};
+      for (var i = 0; i < 25; i++) {
+        entries["key" + i] = { index: i };
+      }
+      region.putAllSync(entries);
+    });
+
+    it("streams keys in batches", function(done) {
+      readAll(region.keysStream({ batchSize: 10 }), function(keys) {
+        expect(keys.length).toEqual(25);
+        expect(keys).toContain("key24");
+        done();
+      });
+    });
+
+    it("streams values and entries", function(done) {
+      readAll(region.valuesStream({ batchSize: 7 }), function(values) {
+        expect(values.length).toEqual(25);
+        expect(values).toContain({ index: 3 });
+
+        readAll(region.entriesStream(), function(entries) {
+          expect(entries).toContain({ key: "key3", value: { index: 3 } });
+          done();
+        });
+      });
+    });
+
+    it("hands out batches from a cursor until it returns null", function(done) {
+      const cursor = region.openCursor("keys", 20);
+      cursor.next(function(error, first) {
+        expect(error).not.toBeError();
+        expect(first.length).toEqual(20);
+        expect(function() { cursor.next(function() {}); }).not.toThrow();
+
+        cursor.close();
+        done();
+      });
+      expect(function() { cursor.next(function() {}); }).toThrow(
+        new Error("You must wait for the previous batch before calling next().")
+      );
+    });
+
+    it("throws an error for an unknown source", function() {
+      expect(function() { region.openCursor("rows"); }).toThrow(
+        new Error("You must pass \"keys\", \"serverKeys\", \"values\" or \"entries\" to openCursor().")
+      );
+    });
+  });
+
   describe("events", function() {
     describe("create", function() {
       beforeEach(function() {
@@ -3,11 +3,21 @@
 #include <v8.h>
 #include <nan.h>
 #include <geode/CacheFactory.hpp>
+#include <geode/DataOutput.hpp>
 #include "dependencies.hpp"
 #include "cache.hpp"
+#include "conversions.hpp"
+#include "exceptions.hpp"
 #include "region.hpp"
+#include "region_cursor.hpp"
 #include "cache_factory.hpp"
 #include "select_results.hpp"
+#include "pdx_type_cache.hpp"
+#include "field_name_cache.hpp"
+#include "pdx_proxy.hpp"
+#include "schema_registry.hpp"
+#include "value_codec.hpp"
+#include "gemfire_executor.hpp"
 
 using namespace v8;
 using namespace apache::geode::client;
@@ -20,6 +30,123 @@ NAN_METHOD(Connected) {
   info.GetReturnValue().Set(Nan::New(distributedSystemPtr->isConnected()));
 }
 
+NAN_METHOD(ConversionStats) {
+  Nan::HandleScope scope;
+
+  PdxTypeCache * pdxTypeCache = PdxTypeCache::getInstance();
+  Local<Object> pdxTypeCacheStats = Nan::New<Object>();
+  Nan::Set(pdxTypeCacheStats, Nan::New("hits").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(pdxTypeCache->getHits())));
+  Nan::Set(pdxTypeCacheStats, Nan::New("misses").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(pdxTypeCache->getMisses())));
+  Nan::Set(pdxTypeCacheStats, Nan::New("size").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(pdxTypeCache->size())));
+
+  FieldNameCache * fieldNameCache = FieldNameCache::getInstance();
+  Local<Object> fieldNameCacheStats = Nan::New<Object>();
+  Nan::Set(fieldNameCacheStats, Nan::New("hits").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(fieldNameCache->getHits())));
+  Nan::Set(fieldNameCacheStats, Nan::New("misses").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(fieldNameCache->getMisses())));
+  Nan::Set(fieldNameCacheStats, Nan::New("size").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(fieldNameCache->size())));
+
+  CompressionStats::Totals compression(CompressionStats::getInstance()->getTotals());
+  Local<Object> compressionStats = Nan::New<Object>();
+  Nan::Set(compressionStats, Nan::New("compressedValues").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(compression.compressedValues)));
+  Nan::Set(compressionStats, Nan::New("skippedValues").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(compression.skippedValues)));
+  Nan::Set(compressionStats, Nan::New("uncompressedBytes").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(compression.uncompressedBytes)));
+  Nan::Set(compressionStats, Nan::New("compressedBytes").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(compression.compressedBytes)));
+  Nan::Set(compressionStats, Nan::New("ratio").ToLocalChecked(),
+      Nan::New<Number>(compression.compressedBytes == 0 ? 0 :
+        static_cast<double>(compression.uncompressedBytes) / compression.compressedBytes));
+  Nan::Set(compressionStats, Nan::New("compressMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(compression.compressNanoseconds / 1000.0));
+  Nan::Set(compressionStats, Nan::New("decompressedValues").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(compression.decompressedValues)));
+  Nan::Set(compressionStats, Nan::New("decompressMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(compression.decompressNanoseconds / 1000.0));
+
+  Local<Object> conversionStats = Nan::New<Object>();
+  Nan::Set(conversionStats, Nan::New("pdxTypeCache").ToLocalChecked(), pdxTypeCacheStats);
+  Nan::Set(conversionStats, Nan::New("fieldNameCache").ToLocalChecked(), fieldNameCacheStats);
+  Nan::Set(conversionStats, Nan::New("compression").ToLocalChecked(), compressionStats);
+
+  info.GetReturnValue().Set(conversionStats);
+}
+
+NAN_METHOD(SetThreadPoolSize) {
+  Nan::HandleScope scope;
+
+  GemfireExecutor * executor = GemfireExecutor::getInstance();
+  if (executor->started()) {
+    Nan::ThrowError("gemfire: setThreadPoolSize() must be called before the first GemFire operation.");
+    return;
+  }
+
+  double threadCount = info[0]->IsNumber() ? Nan::To<double>(info[0]).FromJust() : 0;
+  if (threadCount < 1 || threadCount != static_cast<size_t>(threadCount) ||
+      !executor->setThreadCount(static_cast<size_t>(threadCount))) {
+    Nan::ThrowError("You must pass a number of threads from 1 to 1024 to setThreadPoolSize().");
+    return;
+  }
+}
+
+NAN_METHOD(ThreadPoolStats) {
+  Nan::HandleScope scope;
+
+  GemfireExecutor::Stats stats(GemfireExecutor::getInstance()->getStats());
+  Local<Object> threadPoolStats = Nan::New<Object>();
+  Nan::Set(threadPoolStats, Nan::New("threads").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(stats.threads)));
+  Nan::Set(threadPoolStats, Nan::New("active").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(stats.active)));
+  Nan::Set(threadPoolStats, Nan::New("queueDepth").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(stats.queueDepth)));
+  Nan::Set(threadPoolStats, Nan::New("maxQueueDepth").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(stats.maxQueueDepth)));
+  Nan::Set(threadPoolStats, Nan::New("completed").ToLocalChecked(),
+      Nan::New<Number>(static_cast<double>(stats.completed)));
+  Nan::Set(threadPoolStats, Nan::New("waitMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(stats.waitNanoseconds / 1000.0));
+  Nan::Set(threadPoolStats, Nan::New("maxWaitMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(stats.maxWaitNanoseconds / 1000.0));
+  Nan::Set(threadPoolStats, Nan::New("averageWaitMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(stats.completed == 0 ? 0 : stats.waitNanoseconds / 1000.0 / stats.completed));
+  Nan::Set(threadPoolStats, Nan::New("runMicroseconds").ToLocalChecked(),
+      Nan::New<Number>(stats.runNanoseconds / 1000.0));
+
+  info.GetReturnValue().Set(threadPoolStats);
+}
+
+// Diagnostic for comparing conversion options: the number of bytes GemFire serializes a value to.
+NAN_METHOD(SerializedSize) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0) {
+    Nan::ThrowError("You must pass a value to serializedSize().");
+    return;
+  }
+
+  try {
+    CachePtr cachePtr(apache::geode::client::CacheFactory::getAnyInstance());
+    CacheablePtr valuePtr(gemfireValue(info[0], cachePtr));
+    if (valuePtr == NULLPTR) {
+      return;
+    }
+
+    DataOutput dataOutput;
+    dataOutput.writeObject(valuePtr);
+    info.GetReturnValue().Set(Nan::New<Number>(dataOutput.getBufferLength()));
+  } catch (const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+  }
+}
+
 NAN_METHOD(Initialize) {
   Nan::HandleScope scope;
 
@@ -37,9 +164,31 @@ NAN_METHOD(Initialize) {
       Nan::New<FunctionTemplate>(Connected)->GetFunction(),
       static_cast<PropertyAttribute>(ReadOnly | DontDelete));
 
+  Nan::DefineOwnProperty(gemfire, Nan::New("conversionStats").ToLocalChecked(),
+      Nan::New<FunctionTemplate>(ConversionStats)->GetFunction(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+  Nan::DefineOwnProperty(gemfire, Nan::New("setThreadPoolSize").ToLocalChecked(),
+      Nan::New<FunctionTemplate>(SetThreadPoolSize)->GetFunction(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+  Nan::DefineOwnProperty(gemfire, Nan::New("threadPoolStats").ToLocalChecked(),
+      Nan::New<FunctionTemplate>(ThreadPoolStats)->GetFunction(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+  Nan::DefineOwnProperty(gemfire, Nan::New("serializedSize").ToLocalChecked(),
+      Nan::New<FunctionTemplate>(SerializedSize)->GetFunction(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+  Nan::DefineOwnProperty(gemfire, Nan::New("schemaSymbol").ToLocalChecked(),
+      SchemaRegistry::symbol(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
   node_gemfire::Cache::Init(gemfire);
   node_gemfire::Region::Init(gemfire);
+  node_gemfire::RegionCursor::Init(gemfire);
   node_gemfire::SelectResults::Init(gemfire);
+  node_gemfire::PdxProxy::Init(gemfire);
   node_gemfire::CacheFactory::Init(gemfire);
 
   dependencies.Reset(v8::Isolate::GetCurrent(),info[0]->ToObject());
@@ -7,13 +7,17 @@
 #include <geode/Region.hpp>
 #include <string>
 #include <sstream>
+#include <vector>
 #include "exceptions.hpp"
 #include "conversions.hpp"
 #include "region.hpp"
 #include "gemfire_worker.hpp"
+#include "gemfire_executor.hpp"
 #include "dependencies.hpp"
 #include "functions.hpp"
 #include "region_shortcuts.hpp"
+#include "schema_registry.hpp"
+#include "value_codec.hpp"
 
 using namespace v8;
 using namespace apache::geode::client;
@@ -42,6 +46,9 @@ NAN_MODULE_INIT(Cache::Init) {
   Nan::SetPrototypeMethod(constructorTemplate, "getRegion", Cache::GetRegion);
   Nan::SetPrototypeMethod(constructorTemplate, "rootRegions", Cache::RootRegions);
   Nan::SetPrototypeMethod(constructorTemplate, "inspect", Cache::Inspect);
+  Nan::SetPrototypeMethod(constructorTemplate, "setConversionOptions", Cache::SetConversionOptions);
+  Nan::SetPrototypeMethod(constructorTemplate, "getConversionOptions", Cache::GetConversionOptions);
+  Nan::SetPrototypeMethod(constructorTemplate, "registerSchema", Cache::RegisterSchema);
 
   constructor().Reset(Nan::GetFunction(constructorTemplate).ToLocalChecked());
 
@@ -188,7 +195,7 @@ NAN_METHOD(Cache::ExecuteQuery) {
   Nan::Callback * callback = new Nan::Callback(callbackFunction);
 
   ExecuteQueryWorker * worker = new ExecuteQueryWorker(queryPtr, queryParamsPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.This());
 }
@@ -229,6 +236,24 @@ NAN_METHOD(Cache::CreateRegion) {
     return;
   }
 
+  ValueCodecOptions codecOptions;
+  Local<Value> regionCodec(regionConfiguration->Get(Nan::New("codec").ToLocalChecked()));
+  if (!regionCodec->IsUndefined() && !parseValueCodec(*Nan::Utf8String(regionCodec), codecOptions.codec)) {
+    Nan::ThrowError("createRegion: The codec must be one of 'pdx' or 'msgpack'.");
+    return;
+  }
+
+  Local<Value> compressionThreshold(
+      regionConfiguration->Get(Nan::New("compressionThreshold").ToLocalChecked()));
+  if (!compressionThreshold->IsUndefined()) {
+    if (!compressionThreshold->IsNumber() || !(compressionThreshold->NumberValue() >= 0) ||
+        compressionThreshold->NumberValue() > UINT32_MAX) {
+      Nan::ThrowError("createRegion: The compressionThreshold must be a non-negative number of bytes.");
+      return;
+    }
+    codecOptions.compressionThreshold = static_cast<uint32_t>(compressionThreshold->NumberValue());
+  }
+
   Cache * cache = Nan::ObjectWrap::Unwrap<Cache>(info.This());
   CachePtr cachePtr(cache->cachePtr);
 
@@ -245,6 +270,7 @@ NAN_METHOD(Cache::CreateRegion) {
     ThrowGemfireException(exception);
     return;
   }
+  ValueCodecRegistry::getInstance()->set(regionPtr->getFullPath(), codecOptions);
   info.GetReturnValue().Set(Region::NewInstance(regionPtr));
 }
 
@@ -297,6 +323,140 @@ NAN_METHOD(Cache::Inspect) {
   info.GetReturnValue().Set(Nan::New("[Cache]").ToLocalChecked());
 }
 
+bool parseNumberEncoding(const Local<Object> & optionsObject, const char * name, NumberEncoding & encoding) {
+  Local<Value> encodingValue(optionsObject->Get(Nan::New(name).ToLocalChecked()));
+  if (encodingValue->IsUndefined()) {
+    return true;
+  }
+
+  std::string encodingName(*Nan::Utf8String(encodingValue));
+  if (encodingName == "double") {
+    encoding = NUMBER_AS_DOUBLE;
+  } else if (encodingName == "compact") {
+    encoding = NUMBER_AS_COMPACT;
+  } else {
+    std::stringstream errorMessageStream;
+    errorMessageStream << "setConversionOptions: " << name << " must be one of 'double' or 'compact'.";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+const char * numberEncodingName(NumberEncoding encoding) {
+  return encoding == NUMBER_AS_COMPACT ? "compact" : "double";
+}
+
+NAN_METHOD(Cache::SetConversionOptions) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0 || !info[0]->IsObject()) {
+    Nan::ThrowError("setConversionOptions: You must pass an options object.");
+    return;
+  }
+
+  Local<Object> optionsObject(info[0]->ToObject());
+  ConversionOptions options(conversionOptions());
+
+  Local<Value> int64Value(optionsObject->Get(Nan::New("int64").ToLocalChecked()));
+  if (!int64Value->IsUndefined()) {
+    std::string int64Mode(*Nan::Utf8String(int64Value));
+    if (int64Mode == "number") {
+      options.int64Mode = INT64_AS_NUMBER;
+    } else if (int64Mode == "bigint") {
+      options.int64Mode = INT64_AS_BIGINT;
+    } else if (int64Mode == "safe") {
+      options.int64Mode = INT64_AS_SAFE_NUMBER;
+    } else {
+      Nan::ThrowError("setConversionOptions: int64 must be one of 'number', 'bigint' or 'safe'.");
+      return;
+    }
+
+#if !NODE_GEMFIRE_HAS_BIGINT
+    if (options.int64Mode != INT64_AS_NUMBER) {
+      Nan::ThrowError("setConversionOptions: BigInt is not supported by this version of Node.js.");
+      return;
+    }
+#endif
+  }
+
+  if (!parseNumberEncoding(optionsObject, "numberEncoding", options.numberEncoding) ||
+      !parseNumberEncoding(optionsObject, "keyEncoding", options.keyEncoding)) {
+    return;
+  }
+
+  conversionOptions() = options;
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(Cache::GetConversionOptions) {
+  Nan::HandleScope scope;
+
+  const ConversionOptions & options(conversionOptions());
+  Local<Object> optionsObject(Nan::New<Object>());
+
+  const char * int64Mode;
+  switch (options.int64Mode) {
+    case INT64_AS_BIGINT:
+      int64Mode = "bigint";
+      break;
+    case INT64_AS_SAFE_NUMBER:
+      int64Mode = "safe";
+      break;
+    default:
+      int64Mode = "number";
+  }
+  Nan::Set(optionsObject, Nan::New("int64").ToLocalChecked(), Nan::New(int64Mode).ToLocalChecked());
+  Nan::Set(optionsObject, Nan::New("numberEncoding").ToLocalChecked(),
+      Nan::New(numberEncodingName(options.numberEncoding)).ToLocalChecked());
+  Nan::Set(optionsObject, Nan::New("keyEncoding").ToLocalChecked(),
+      Nan::New(numberEncodingName(options.keyEncoding)).ToLocalChecked());
+
+  info.GetReturnValue().Set(optionsObject);
+}
+
+NAN_METHOD(Cache::RegisterSchema) {
+  Nan::HandleScope scope;
+
+  if (info.Length() < 2 || !info[0]->IsString() || !info[1]->IsObject() || info[1]->IsArray()) {
+    Nan::ThrowError("registerSchema: You must pass a schema name and an object of field types.");
+    return;
+  }
+
+  std::string className(*Nan::Utf8String(info[0]));
+  if (className.empty()) {
+    Nan::ThrowError("registerSchema: The schema name must not be empty.");
+    return;
+  }
+
+  Local<Object> fieldsObject(info[1]->ToObject());
+  Local<Array> v8FieldNames(fieldsObject->GetOwnPropertyNames());
+  unsigned int length = v8FieldNames->Length();
+
+  std::vector<PdxSchema::Field> fields;
+  fields.reserve(length);
+  for (unsigned int i = 0; i < length; i++) {
+    Local<Value> v8FieldName(v8FieldNames->Get(i));
+    std::string fieldName(*Nan::Utf8String(v8FieldName));
+    std::string typeName(*Nan::Utf8String(fieldsObject->Get(v8FieldName)));
+
+    SchemaFieldType type;
+    if (!parseSchemaFieldType(typeName, type)) {
+      std::stringstream errorMessageStream;
+      errorMessageStream << "registerSchema: Unknown type '" << typeName << "' for field '" << fieldName
+        << "'. Use boolean, byte, short, int, long, float, double, string, date or object, "
+        << "or an array of one of them such as 'string[]'.";
+      Nan::ThrowError(errorMessageStream.str().c_str());
+      return;
+    }
+
+    fields.push_back(PdxSchema::Field(fieldName, type));
+  }
+
+  SchemaRegistry::getInstance()->add(PdxSchemaPtr(new PdxSchema(className, fields)));
+  info.GetReturnValue().Set(info.This());
+}
+
 NAN_METHOD(Cache::ExecuteFunction) {
   Nan::HandleScope scope;
 
@@ -34,6 +34,9 @@ class Cache : public Nan::ObjectWrap {
   static NAN_METHOD(GetRegion);
   static NAN_METHOD(RootRegions);
   static NAN_METHOD(Inspect);
+  static NAN_METHOD(SetConversionOptions);
+  static NAN_METHOD(GetConversionOptions);
+  static NAN_METHOD(RegisterSchema);
 
  private:
   static apache::geode::client::PoolPtr getPool(const v8::Handle<v8::Value> & poolNameValue);
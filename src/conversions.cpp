@@ -3,13 +3,19 @@
 #include <nan.h>
 #include <v8.h>
 #include <math.h>
+#include <cmath>
 #include <geode/GeodeCppCache.hpp>
 #include <string>
 #include <sstream>
-#include <set>
+#include <vector>
 #include "conversions.hpp"
 #include "exceptions.hpp"
 #include "select_results.hpp"
+#include "pdx_type_cache.hpp"
+#include "field_name_cache.hpp"
+#include "string_conversions.hpp"
+#include "pdx_proxy.hpp"
+#include "staging_buffer.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -19,87 +25,43 @@ using namespace apache::geode::client;
 namespace node_gemfire {
 
 std::string getClassName(const Local<Object> & v8Object) {
-   Nan::HandleScope scope;
+  Nan::HandleScope scope;
 
-  std::set<std::string> fieldNames;
-  uint totalSize = 0;
+  std::vector<PdxTypeDescriptor::Field> fields;
 
   Local<Array> v8Keys(v8Object->GetOwnPropertyNames());
   unsigned int numKeys = v8Keys->Length();
+  fields.reserve(numKeys);
   for (unsigned int i = 0; i < numKeys; i++) {
     Local<Value> v8Key(v8Keys->Get(i));
     Nan::Utf8String utf8FieldName(v8Key);
-    char * fieldName = *utf8FieldName;
-
-    unsigned int size = utf8FieldName.length();
-    std::string fullFieldName;
-    fullFieldName.reserve((size * 2) + 3);  // escape every character, plus '[],'
-
-    for (unsigned int j = 0; j < size; j++) {
-      char fieldNameChar = fieldName[j];
-      switch (fieldNameChar) {
-        case ',':
-        case '[':
-        case ']':
-        case '\\':
-          fullFieldName += '\\';
-      }
-      fullFieldName += fieldNameChar;
-    }
 
     Local<Value> v8Value(v8Object->Get(v8Key));
-    if (v8Value->IsArray() && !v8Value->IsString()) {
-      fullFieldName += "[]";
-    }
-    fullFieldName += ',';
-
-    fieldNames.insert(fullFieldName);
-    totalSize += fullFieldName.length();
+    fields.push_back(PdxTypeDescriptor::Field(std::string(*utf8FieldName, utf8FieldName.length()),
+                                              v8Value->IsArray() && !v8Value->IsString()));
   }
 
-  std::string className;
-  className.reserve(totalSize + 7);
-  className += "JSON: ";
-
-  for (std::set<std::string>::iterator i(fieldNames.begin()); i != fieldNames.end(); ++i) {
-    className += *i;
-  }
-  return className;
+  return pdxClassName(fields);
 }
 
-std::wstring wstringFromV8String(const Local<String> & v8String) {
-  Nan::HandleScope scope;
-
-  String::Value v8StringValue(v8String);
-  uint16_t * v8StringData(*v8StringValue);
-
-  unsigned int length = v8String->Length();
-  wchar_t * buffer = new wchar_t[length + 1];
-  for (unsigned int i = 0; i < length; i++) {
-    buffer[i] = v8StringData[i];
-  }
-  buffer[length] = 0;
-
-  std::wstring wstring(buffer);
-  delete[] buffer;
-
-  return wstring;
+ConversionOptions & conversionOptions() {
+  static ConversionOptions options;
+  return options;
 }
 
-Local<String> v8StringFromWstring(const std::wstring & wideString) {
-  Nan::EscapableHandleScope scope;
+CompactNumberType compactNumberType(double value) {
+  static const double maxSafeInteger = 9007199254740991.0;
 
-  unsigned int length = wideString.length();
-  uint16_t * buffer = new uint16_t[length + 1];
-  for (unsigned int i = 0; i < length; i++) {
-    buffer[i] = wideString[i];
+  if (value != std::trunc(value) || (value == 0 && std::signbit(value))) {
+    return COMPACT_DOUBLE;
   }
-  buffer[length] = 0;
- 
-  Local<String> v8String = Nan::New(buffer).ToLocalChecked();
-  delete[] buffer;
-
-  return scope.Escape(v8String);
+  if (value >= INT32_MIN && value <= INT32_MAX) {
+    return COMPACT_INT32;
+  }
+  if (value >= -maxSafeInteger && value <= maxSafeInteger) {
+    return COMPACT_INT64;
+  }
+  return COMPACT_DOUBLE;
 }
 
 void ConsoleWarn(const char * message) {
@@ -113,57 +75,20 @@ void ConsoleWarn(const char * message) {
   callback.Call(1, argv);
 }
 
+// Values are converted by staging them and building the result straight away, so that puts made
+// on the JavaScript thread and puts built on a worker thread share one set of conversion rules.
 CacheablePtr gemfireValue(const Local<Value> & v8Value, const CachePtr & cachePtr) {
-  if (v8Value->IsString() || v8Value->IsStringObject()) {
-    std::wstring wideString = wstringFromV8String(v8Value->ToString());
-    const wchar_t* readOnlyWideChar = wideString.c_str();
-    return CacheableString::create(readOnlyWideChar);
-  } else if (v8Value->IsBoolean()) {
-    return CacheableBoolean::create(v8Value->ToBoolean()->Value());
-  } else if (v8Value->IsNumber() || v8Value->IsNumberObject()) {
-    return CacheableDouble::create(v8Value->ToNumber()->Value());
-  } else if (v8Value->IsDate()) {
-    return gemfireValue(Local<Date>::Cast(v8Value));
-  } else if (v8Value->IsArray()) {
-    return gemfireValue(Local<Array>::Cast(v8Value), cachePtr);
-  } else if (v8Value->IsBooleanObject()) {
-#if (NODE_MODULE_VERSION > 0x000B)
-    return CacheableBoolean::create(BooleanObject::Cast(*v8Value)->ValueOf());
-#else
-    return CacheableBoolean::create(BooleanObject::Cast(*v8Value)->BooleanValue());
-#endif
-  } else if (v8Value->IsFunction()) {
-    Nan::ThrowError("Unable to serialize to GemFire; functions are not supported.");
-    return NULLPTR;
-  } else if (v8Value->IsObject()) {
-    return gemfireValue(v8Value->ToObject(), cachePtr);
-  } else if (v8Value->IsUndefined()) {
-    return CacheableUndefined::create();
-  } else if (v8Value->IsNull()) {
-    return NULLPTR;
-  } else {
-    std::string errorMessage("Unable to serialize to GemFire; unknown JavaScript object: ");
-    errorMessage.append(*Nan::Utf8String(v8Value->ToDetailString()));
-    Nan::ThrowError(errorMessage.c_str());
+  if (v8Value->IsString()) {
+    return gemfireString(v8Value.As<String>());
+  }
+
+  StagingBuffer stagingBuffer;
+  if (!stagingBuffer.stage(v8Value)) {
     return NULLPTR;
   }
-}
 
-PdxInstancePtr gemfireValue(const Local<Object> & v8Object, const CachePtr & cachePtr) {
-    Nan::EscapableHandleScope scope;
   try {
-    std::string pdxClassName = getClassName(v8Object);
-    PdxInstanceFactoryPtr pdxInstanceFactory = cachePtr->createPdxInstanceFactory(pdxClassName.c_str());
-    Local<Array> v8Keys(v8Object->GetOwnPropertyNames());
-    unsigned int length = v8Keys->Length();
-    for (unsigned int i = 0; i < length; i++) {
-      Local<Value> v8Key(v8Keys->Get(i));
-      Local<Value> v8Value(v8Object->Get(v8Key));
-      Nan::Utf8String fieldName(v8Key);
-      CacheablePtr cacheablePtr(gemfireValue(v8Value, cachePtr));
-      pdxInstanceFactory->writeObject(*fieldName, cacheablePtr);
-    }
-    return pdxInstanceFactory->create();
+    return stagingBuffer.build(cachePtr);
   }
   catch(const apache::geode::client::Exception & exception) {
     ThrowGemfireException(exception);
@@ -171,24 +96,25 @@ PdxInstancePtr gemfireValue(const Local<Object> & v8Object, const CachePtr & cac
   }
 }
 
-apache::geode::client::CacheableArrayListPtr gemfireValue(const Local<Array> & v8Array,
-                                         const apache::geode::client::CachePtr & cachePtr) {
-  CacheableArrayListPtr arrayListPtr(CacheableArrayList::create());
-  unsigned int length = v8Array->Length();
-  for (unsigned int i = 0; i < length; i++) {
-    arrayListPtr->push_back(gemfireValue(v8Array->Get(i), cachePtr));
+// Under the compact key encoding, integral keys hash and compare like Java Integer and Long keys.
+// Number keys never follow the number encoding of values, so that a key reads back however the
+// values around it are encoded.
+CacheableKeyPtr gemfireKey(const Local<Value> & v8Value, const CachePtr & cachePtr) {
+  if (v8Value->IsNumber()) {
+    double value = v8Value->NumberValue();
+    if (conversionOptions().keyEncoding != NUMBER_AS_COMPACT) {
+      return CacheableDouble::create(value);
+    }
+    switch (compactNumberType(value)) {
+      case COMPACT_INT32:
+        return CacheableInt32::create(static_cast<int32_t>(value));
+      case COMPACT_INT64:
+        return CacheableInt64::create(static_cast<int64_t>(value));
+      default:
+        return CacheableDouble::create(value);
+    }
   }
-  return arrayListPtr;
-}
-
-apache::geode::client::CacheableDatePtr gemfireValue(const Local<Date> & v8Date) {
-  long int millisecondsSinceEpoch = v8Date->NumberValue();
-  std::chrono::milliseconds dur(millisecondsSinceEpoch);
-  std::chrono::time_point<std::chrono::system_clock> dt(dur);
-  return CacheableDate::create(dt);
-}
 
-CacheableKeyPtr gemfireKey(const Local<Value> & v8Value, const CachePtr & cachePtr) {
   CacheableKeyPtr keyPtr;
   try {
     keyPtr = gemfireValue(v8Value, cachePtr);
@@ -202,9 +128,11 @@ CacheableKeyPtr gemfireKey(const Local<Value> & v8Value, const CachePtr & cacheP
 
 VectorOfCacheableKeyPtr gemfireKeys(const Local<Array> & v8Value,
                                           const CachePtr & cachePtr) {
+  unsigned int length = v8Value->Length();
   VectorOfCacheableKeyPtr vectorPtr(new VectorOfCacheableKey());
+  vectorPtr->reserve(length);
 
-  for (unsigned int i = 0; i < v8Value->Length(); i++) {
+  for (unsigned int i = 0; i < length; i++) {
     CacheableKeyPtr keyPtr = gemfireKey(v8Value->Get(i), cachePtr);
 
     if (keyPtr == NULLPTR) {
@@ -219,27 +147,18 @@ VectorOfCacheableKeyPtr gemfireKeys(const Local<Array> & v8Value,
 
 HashMapOfCacheablePtr gemfireHashMap(const Local<Object> & v8Object,
                                            const CachePtr & cachePtr) {
-  Nan::HandleScope scope;
-
-  HashMapOfCacheablePtr hashMapPtr(new HashMapOfCacheable());
-
-  Local<Array> v8Keys(v8Object->GetOwnPropertyNames());
-  unsigned int length = v8Keys->Length();
-
-  for (unsigned int i = 0; i < length; i++) {
-    Local<String> v8Key(v8Keys->Get(i)->ToString());
-
-    CacheableKeyPtr keyPtr(gemfireKey(v8Key, cachePtr));
-    CacheablePtr valuePtr(gemfireValue(v8Object->Get(v8Key), cachePtr));
-
-    if (valuePtr == NULLPTR) {
-      return NULLPTR;
-    }
-
-    hashMapPtr->insert(keyPtr, valuePtr);
+  StagingBuffer stagingBuffer;
+  if (!stagingBuffer.stageEntries(v8Object)) {
+    return NULLPTR;
   }
 
-  return hashMapPtr;
+  try {
+    return stagingBuffer.buildHashMap(cachePtr);
+  }
+  catch(const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+    return NULLPTR;
+  }
 }
 
 CacheableVectorPtr gemfireVector(const Local<Array> & v8Array, const CachePtr & cachePtr) {
@@ -255,6 +174,36 @@ CacheableVectorPtr gemfireVector(const Local<Array> & v8Array, const CachePtr &
   return vectorPtr;
 }
 
+void releaseCacheable(char * data, void * hint) {
+  delete static_cast<CacheablePtr *>(hint);
+}
+
+// Wraps the storage of a Cacheable array in a Buffer without copying it. The Buffer keeps the
+// Cacheable alive until it is garbage collected.
+Local<Object> externalBuffer(const CacheablePtr & cacheablePtr, const void * data, size_t byteLength) {
+  Nan::EscapableHandleScope scope;
+
+  if (byteLength == 0) {
+    return scope.Escape(Nan::NewBuffer(0).ToLocalChecked());
+  }
+
+  return scope.Escape(Nan::NewBuffer(static_cast<char *>(const_cast<void *>(data)),
+                                     byteLength,
+                                     releaseCacheable,
+                                     new CacheablePtr(cacheablePtr)).ToLocalChecked());
+}
+
+template<typename V8TypedArray, typename T>
+Local<Object> v8TypedArray(const SharedPtr<T> & arrayPtr) {
+  Nan::EscapableHandleScope scope;
+
+  size_t length = arrayPtr->length();
+  Local<Object> buffer(externalBuffer(arrayPtr, arrayPtr->value(), length * sizeof(*arrayPtr->value())));
+  Local<Uint8Array> bufferView(buffer.As<Uint8Array>());
+
+  return scope.Escape(V8TypedArray::New(bufferView->Buffer(), bufferView->ByteOffset(), length));
+}
+
 Local<Value> v8Value(const CacheablePtr & valuePtr) {
  Nan::EscapableHandleScope scope;
 
@@ -268,14 +217,7 @@ Local<Value> v8Value(const CacheablePtr & valuePtr) {
     case GeodeTypeIds::CacheableASCIIStringHuge:
     case GeodeTypeIds::CacheableString:
     case GeodeTypeIds::CacheableStringHuge:
-    {  
-      CacheableStringPtr cacheableStringPtr = static_cast<CacheableStringPtr>(valuePtr);
-      if(cacheableStringPtr->isWideString()){
-        return scope.Escape(v8StringFromWstring(cacheableStringPtr->asWChar()));
-      }
-      //else
-      return scope.Escape(Nan::New(cacheableStringPtr->asChar()).ToLocalChecked());
-    }
+      return scope.Escape(v8String(static_cast<CacheableStringPtr>(valuePtr)));
     case GeodeTypeIds::CacheableBoolean:
       return scope.Escape(Nan::New((static_cast<CacheableBooleanPtr>(valuePtr))->value()));
     case GeodeTypeIds::CacheableDouble:
@@ -290,6 +232,30 @@ Local<Value> v8Value(const CacheablePtr & valuePtr) {
       return scope.Escape(v8Value(static_cast<CacheableInt64Ptr>(valuePtr)));
     case GeodeTypeIds::CacheableDate:
       return scope.Escape(v8Value(static_cast<CacheableDatePtr>(valuePtr)));
+    case GeodeTypeIds::CacheableBytes:
+      return scope.Escape(v8Value(static_cast<CacheableBytesPtr>(valuePtr)));
+    case GeodeTypeIds::CacheableInt16Array:
+      return scope.Escape(v8TypedArray<Int16Array>(static_cast<CacheableInt16ArrayPtr>(valuePtr)));
+    case GeodeTypeIds::CacheableInt32Array:
+      return scope.Escape(v8TypedArray<Int32Array>(static_cast<CacheableInt32ArrayPtr>(valuePtr)));
+    case GeodeTypeIds::CacheableFloatArray:
+      return scope.Escape(v8TypedArray<Float32Array>(static_cast<CacheableFloatArrayPtr>(valuePtr)));
+    case GeodeTypeIds::CacheableDoubleArray:
+      return scope.Escape(v8TypedArray<Float64Array>(static_cast<CacheableDoubleArrayPtr>(valuePtr)));
+    case GeodeTypeIds::CacheableInt64Array:
+#if NODE_GEMFIRE_HAS_BIGINT
+      return scope.Escape(v8TypedArray<BigInt64Array>(static_cast<CacheableInt64ArrayPtr>(valuePtr)));
+#else
+    {
+      CacheableInt64ArrayPtr int64ArrayPtr(static_cast<CacheableInt64ArrayPtr>(valuePtr));
+      int32_t length = int64ArrayPtr->length();
+      Local<Array> v8Array(Nan::New<Array>(length));
+      for (int32_t i = 0; i < length; i++) {
+        Nan::Set(v8Array, i, v8Value(CacheableInt64::create((*int64ArrayPtr)[i])));
+      }
+      return scope.Escape(v8Array);
+    }
+#endif
     case GeodeTypeIds::CacheableUndefined:
       return scope.Escape(Nan::Undefined());
     case GeodeTypeIds::Struct:
@@ -326,6 +292,186 @@ Local<Value> v8Value(const CacheablePtr & valuePtr) {
   return scope.Escape(Nan::Undefined());
 }
 
+namespace {
+
+// getField() hands over arrays it allocated, which are copied and then freed here.
+template<typename T, typename CacheableT>
+CacheablePtr getPdxArrayField(const PdxInstancePtr & pdxInstance, const char * key) {
+  T * values = NULL;
+  int32_t length = 0;
+  pdxInstance->getField(key, &values, length);
+  CacheablePtr valuePtr(CacheableT::create(values, length < 0 ? 0 : length));
+  delete [] values;
+  return valuePtr;
+}
+
+}  // namespace
+
+// Fields written with the typed PdxInstanceFactory methods, as registered schemas do, must be read
+// with the getField() overload of their type.
+CacheablePtr getPdxField(const PdxInstancePtr & pdxInstance, const char * key) {
+  CacheablePtr value;
+
+  switch (pdxInstance->getFieldType(key)) {
+    case PdxFieldTypes::BOOLEAN: {
+      bool fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableBoolean::create(fieldValue);
+    }
+    case PdxFieldTypes::BYTE: {
+      signed char fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableInt16::create(fieldValue);
+    }
+    case PdxFieldTypes::SHORT: {
+      int16_t fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableInt16::create(fieldValue);
+    }
+    case PdxFieldTypes::INT: {
+      int32_t fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableInt32::create(fieldValue);
+    }
+    case PdxFieldTypes::LONG: {
+      int64_t fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableInt64::create(fieldValue);
+    }
+    case PdxFieldTypes::FLOAT: {
+      float fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableFloat::create(fieldValue);
+    }
+    case PdxFieldTypes::DOUBLE: {
+      double fieldValue;
+      pdxInstance->getField(key, fieldValue);
+      return CacheableDouble::create(fieldValue);
+    }
+    case PdxFieldTypes::STRING: {
+      wchar_t * fieldValue = NULL;
+      pdxInstance->getField(key, &fieldValue);
+      if (fieldValue == NULL) {
+        return NULLPTR;
+      }
+      CacheableStringPtr stringPtr(CacheableString::create(fieldValue));
+      delete [] fieldValue;
+      return stringPtr;
+    }
+    case PdxFieldTypes::DATE: {
+      CacheableDatePtr datePtr;
+      pdxInstance->getField(key, datePtr);
+      return datePtr;
+    }
+    case PdxFieldTypes::BOOLEAN_ARRAY: {
+      bool * values = NULL;
+      int32_t length = 0;
+      pdxInstance->getField(key, &values, length);
+      CacheableArrayListPtr arrayListPtr(CacheableArrayList::create());
+      for (int32_t i = 0; i < length; i++) {
+        arrayListPtr->push_back(CacheableBoolean::create(values[i]));
+      }
+      delete [] values;
+      return arrayListPtr;
+    }
+    case PdxFieldTypes::BYTE_ARRAY: {
+      signed char * values = NULL;
+      int32_t length = 0;
+      pdxInstance->getField(key, &values, length);
+      CacheablePtr bytesPtr(
+          CacheableBytes::create(reinterpret_cast<const uint8_t *>(values), length < 0 ? 0 : length));
+      delete [] values;
+      return bytesPtr;
+    }
+    case PdxFieldTypes::SHORT_ARRAY:
+      return getPdxArrayField<int16_t, CacheableInt16Array>(pdxInstance, key);
+    case PdxFieldTypes::INT_ARRAY:
+      return getPdxArrayField<int32_t, CacheableInt32Array>(pdxInstance, key);
+    case PdxFieldTypes::LONG_ARRAY:
+      return getPdxArrayField<int64_t, CacheableInt64Array>(pdxInstance, key);
+    case PdxFieldTypes::FLOAT_ARRAY:
+      return getPdxArrayField<float, CacheableFloatArray>(pdxInstance, key);
+    case PdxFieldTypes::DOUBLE_ARRAY:
+      return getPdxArrayField<double, CacheableDoubleArray>(pdxInstance, key);
+    case PdxFieldTypes::STRING_ARRAY: {
+      wchar_t ** values = NULL;
+      int32_t length = 0;
+      pdxInstance->getField(key, &values, length);
+      CacheableArrayListPtr arrayListPtr(CacheableArrayList::create());
+      for (int32_t i = 0; i < length; i++) {
+        CacheablePtr stringPtr(NULLPTR);
+        if (values[i] != NULL) {
+          stringPtr = CacheableString::create(values[i]);
+        }
+        arrayListPtr->push_back(stringPtr);
+        delete [] values[i];
+      }
+      delete [] values;
+      return arrayListPtr;
+    }
+    case PdxFieldTypes::OBJECT_ARRAY: {
+      CacheableObjectArrayPtr valueArray;
+      pdxInstance->getField(key, valueArray);
+      value = valueArray;
+      return value;
+    }
+    default:
+      pdxInstance->getField(key, value);
+      return value;
+  }
+}
+
+Local<Value> v8LazyValue(const CacheablePtr & valuePtr) {
+  Nan::EscapableHandleScope scope;
+
+  PdxInstance * pdxInstance = NULL;
+  if (valuePtr != NULLPTR) {
+    pdxInstance = dynamic_cast<PdxInstance *>(valuePtr.ptr());
+  }
+
+  if (pdxInstance == NULL) {
+    return scope.Escape(v8Value(valuePtr));
+  }
+
+  try {
+    return scope.Escape(PdxProxy::NewInstance(PdxInstancePtr(pdxInstance)));
+  }
+  catch(const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+    return scope.Escape(Nan::Undefined());
+  }
+}
+
+Local<Object> v8LazyValue(const HashMapOfCacheablePtr & hashMapPtr) {
+  Nan::EscapableHandleScope scope;
+  Local<Object> v8Object(Nan::New<Object>());
+
+  for (HashMapOfCacheable::Iterator iterator = hashMapPtr->begin();
+       iterator != hashMapPtr->end();
+       iterator++) {
+    CacheablePtr keyPtr(iterator.first());
+    Nan::Set(v8Object, v8Value(keyPtr), v8LazyValue(iterator.second()));
+  }
+
+  return scope.Escape(v8Object);
+}
+
+Local<v8::Map> v8Map(const HashMapOfCacheablePtr & hashMapPtr, bool lazy) {
+  Nan::EscapableHandleScope scope;
+  Local<Context> context(Nan::GetCurrentContext());
+  Local<v8::Map> v8Map(v8::Map::New(Isolate::GetCurrent()));
+
+  for (HashMapOfCacheable::Iterator iterator = hashMapPtr->begin();
+       iterator != hashMapPtr->end();
+       iterator++) {
+    CacheablePtr keyPtr(iterator.first());
+    CacheablePtr valuePtr(iterator.second());
+    v8Map->Set(context, v8Value(keyPtr), lazy ? v8LazyValue(valuePtr) : v8Value(valuePtr)).ToLocalChecked();
+  }
+
+  return scope.Escape(v8Map);
+}
+
 Local<Value> v8Value(const PdxInstancePtr & pdxInstance) {
   Nan::EscapableHandleScope scope;
 
@@ -336,45 +482,59 @@ Local<Value> v8Value(const PdxInstancePtr & pdxInstance) {
       return scope.Escape(Nan::New<Object>());
     }
 
-    Local<Object> v8Object = Nan::New<Object>();
     int length = gemfireKeys->length();
+    std::vector<const char *> keys;
+    keys.reserve(length);
+    for (int i = 0; i < length; i++) {
+      keys.push_back(gemfireKeys[i]->asChar());
+    }
+
+    InternedFieldNamesPtr fieldNames(
+        FieldNameCache::getInstance()->find(pdxInstance->getClassName(), keys));
 
+    Local<Object> v8Object(fieldNames->newObject());
     for (int i = 0; i < length; i++) {
-      const char * key = gemfireKeys[i]->asChar();
-      CacheablePtr value;
-      if (pdxInstance->getFieldType(key) == apache::geode::client::PdxFieldTypes::OBJECT_ARRAY) {
-        CacheableObjectArrayPtr valueArray;
-        pdxInstance->getField(key, valueArray);
-        value = valueArray;
-      } else {
-        pdxInstance->getField(key, value);
-      }
-      Nan::Set(v8Object, Nan::New(key).ToLocalChecked(),v8Value(value)); 
+      Nan::Set(v8Object, fieldNames->get(i), v8Value(getPdxField(pdxInstance, keys[i])));
     }
 
     return scope.Escape(v8Object);
   }
   catch(const apache::geode::client::Exception & exception) {
     ThrowGemfireException(exception);
-    Nan::EscapableHandleScope scope;
     return scope.Escape(Nan::Undefined());
   }
 }
 
 Local<Value> v8Value(const CacheableInt64Ptr & valuePtr) {
-   Nan::EscapableHandleScope scope;
+  return v8Int64(valuePtr->value());
+}
+
+Local<Value> v8Int64(int64_t value) {
+  Nan::EscapableHandleScope scope;
 
   static const int64_t maxSafeInteger = pow(2, 53) - 1;
   static const int64_t minSafeInteger = -1 * maxSafeInteger;
 
-  int64_t value = static_cast<CacheableInt64Ptr>(valuePtr)->value();
-  if (value > maxSafeInteger) {
-    ConsoleWarn("Received 64 bit integer from GemFire greater than Number.MAX_SAFE_INTEGER (2^53 - 1)");
-  } else if (value < minSafeInteger) {
-    ConsoleWarn("Received 64 bit integer from GemFire less than Number.MIN_SAFE_INTEGER (-1 * 2^53 + 1)");
-  }
+  bool isSafe = value <= maxSafeInteger && value >= minSafeInteger;
 
-  return scope.Escape(Nan::New<Number>(value));
+  switch (conversionOptions().int64Mode) {
+#if NODE_GEMFIRE_HAS_BIGINT
+    case INT64_AS_BIGINT:
+      return scope.Escape(BigInt::New(Isolate::GetCurrent(), value));
+    case INT64_AS_SAFE_NUMBER:
+      if (isSafe) {
+        return scope.Escape(Nan::New<Number>(value));
+      }
+      return scope.Escape(BigInt::New(Isolate::GetCurrent(), value));
+#endif
+    default:
+      if (value > maxSafeInteger) {
+        ConsoleWarn("Received 64 bit integer from GemFire greater than Number.MAX_SAFE_INTEGER (2^53 - 1)");
+      } else if (value < minSafeInteger) {
+        ConsoleWarn("Received 64 bit integer from GemFire less than Number.MIN_SAFE_INTEGER (-1 * 2^53 + 1)");
+      }
+      return scope.Escape(Nan::New<Number>(value));
+  }
 }
 
 Local<Date> v8Value(const CacheableDatePtr & datePtr) {
@@ -384,16 +544,33 @@ Local<Date> v8Value(const CacheableDatePtr & datePtr) {
 }
 
 
+Local<Object> v8Value(const CacheableBytesPtr & bytesPtr) {
+  return externalBuffer(bytesPtr, bytesPtr->value(), bytesPtr->length());
+}
+
 Local<Value> v8Value(const CacheableKeyPtr & keyPtr) {
   return v8Value(static_cast<CacheablePtr>(keyPtr));
 }
 
 Local<Object> v8Value(const StructPtr & structPtr) {
   Nan::EscapableHandleScope scope;
-  Local<Object> v8Object(Nan::New<Object>());
+
   unsigned int length = structPtr->length();
+  std::vector<const char *> keys;
+  keys.reserve(length);
+  std::string typeKey;
   for (unsigned int i = 0; i < length; i++) {
-    Nan::Set(v8Object, Nan::New(structPtr->getFieldName(i)).ToLocalChecked(), v8Value((*structPtr)[i]));
+    const char * key = structPtr->getFieldName(i);
+    keys.push_back(key);
+    typeKey.append(key);
+    typeKey += '\0';
+  }
+
+  InternedFieldNamesPtr fieldNames(FieldNameCache::getInstance()->find(typeKey, keys));
+
+  Local<Object> v8Object(fieldNames->newObject());
+  for (unsigned int i = 0; i < length; i++) {
+    Nan::Set(v8Object, fieldNames->get(i), v8Value((*structPtr)[i]));
   }
   return scope.Escape(v8Object);
 }
@@ -412,9 +589,10 @@ Local<Array> v8Value(const VectorOfCacheableKeyPtr & vectorPtr) {
 
 Local<Object> v8Value(const RegionEntryPtr & regionEntryPtr) {
   Nan::EscapableHandleScope scope;
-  Local<Object> v8Object(Nan::New<Object>());
-  Nan::Set(v8Object, Nan::New("key").ToLocalChecked(), v8Value(regionEntryPtr->getKey()));
-  Nan::Set(v8Object, Nan::New("value").ToLocalChecked(), v8Value(regionEntryPtr->getValue()));
+  InternedFieldNamesPtr fieldNames(FieldNameCache::getInstance()->regionEntry());
+  Local<Object> v8Object(fieldNames->newObject());
+  Nan::Set(v8Object, fieldNames->get(0), v8Value(regionEntryPtr->getKey()));
+  Nan::Set(v8Object, fieldNames->get(1), v8Value(regionEntryPtr->getValue()));
   return scope.Escape(v8Object);
 }
 
@@ -9,15 +9,53 @@
 #include <cstdint>
 #include <sys/time.h>
 
+// BigInt and BigInt64Array are available to addons from V8 6.8 (Node 10.7).
+#if defined(V8_MAJOR_VERSION) && (V8_MAJOR_VERSION > 6 || (V8_MAJOR_VERSION == 6 && V8_MINOR_VERSION >= 8))
+#define NODE_GEMFIRE_HAS_BIGINT 1
+#else
+#define NODE_GEMFIRE_HAS_BIGINT 0
+#endif
+
 namespace node_gemfire {
 
+enum Int64Mode {
+  INT64_AS_NUMBER,
+  INT64_AS_BIGINT,
+  INT64_AS_SAFE_NUMBER
+};
+
+enum NumberEncoding {
+  NUMBER_AS_DOUBLE,
+  NUMBER_AS_COMPACT
+};
+
+// Set through cache.setConversionOptions(). There is only ever one cache per process.
+struct ConversionOptions {
+  ConversionOptions() :
+    int64Mode(INT64_AS_NUMBER),
+    numberEncoding(NUMBER_AS_DOUBLE),
+    keyEncoding(NUMBER_AS_DOUBLE) {}
+
+  Int64Mode int64Mode;
+  // How Numbers are stored in values, and separately in keys.
+  NumberEncoding numberEncoding;
+  NumberEncoding keyEncoding;
+};
+
+ConversionOptions & conversionOptions();
+
+enum CompactNumberType {
+  COMPACT_INT32,
+  COMPACT_INT64,
+  COMPACT_DOUBLE
+};
+
+// How a Number is stored under NUMBER_AS_COMPACT: as a Java int when it is integral and fits in 32
+// bits, as a long when it is a safe integer, and as a double otherwise, including -0.
+CompactNumberType compactNumberType(double value);
+
 apache::geode::client::CacheablePtr gemfireValue(const v8::Local<v8::Value> & v8Value,
                                          const apache::geode::client::CachePtr & cachePtr);
-apache::geode::client::PdxInstancePtr gemfireValue(const v8::Local<v8::Object> & v8Object,
-                                           const apache::geode::client::CachePtr & cachePtr);
-apache::geode::client::CacheableArrayListPtr gemfireValue(const v8::Local<v8::Array> & v8Value,
-                                         const apache::geode::client::CachePtr & cachePtr);
-apache::geode::client::CacheableDatePtr gemfireValue(const v8::Local<v8::Date> & v8Value);
 
 apache::geode::client::CacheableKeyPtr gemfireKey(const v8::Local<v8::Value> & v8Value,
                                           const apache::geode::client::CachePtr & cachePtr);
@@ -32,6 +70,7 @@ apache::geode::client::CacheableVectorPtr gemfireVector(const v8::Local<v8::Arra
 v8::Local<v8::Value> v8Value(const apache::geode::client::CacheablePtr & valuePtr);
 v8::Local<v8::Value> v8Value(const apache::geode::client::CacheableKeyPtr & keyPtr);
 v8::Local<v8::Value> v8Value(const apache::geode::client::CacheableInt64Ptr & valuePtr);
+v8::Local<v8::Value> v8Int64(int64_t value);
 v8::Local<v8::Object> v8Value(const apache::geode::client::StructPtr & structPtr);
 v8::Local<v8::Value> v8Value(const apache::geode::client::PdxInstancePtr & pdxInstancePtr);
 v8::Local<v8::Object> v8Value(const apache::geode::client::SelectResultsPtr & selectResultsPtr);
@@ -42,8 +81,18 @@ v8::Local<v8::Array> v8Value(const apache::geode::client::VectorOfCacheablePtr &
 v8::Local<v8::Array> v8Value(const apache::geode::client::VectorOfCacheableKeyPtr & vectorPtr);
 v8::Local<v8::Array> v8Value(const apache::geode::client::VectorOfRegionEntry & vectorPtr);
 v8::Local<v8::Date> v8Value(const apache::geode::client::CacheableDatePtr & datePtr);
+v8::Local<v8::Object> v8Value(const apache::geode::client::CacheableBytesPtr & bytesPtr);
 v8::Local<v8::Boolean> v8Value(bool value);
 
+// Like v8Value(), but PDX instances become PdxProxy objects that convert fields on first access.
+v8::Local<v8::Value> v8LazyValue(const apache::geode::client::CacheablePtr & valuePtr);
+v8::Local<v8::Object> v8LazyValue(const apache::geode::client::HashMapOfCacheablePtr & hashMapPtr);
+// A map of results as a JavaScript Map, which keeps the type of every key.
+v8::Local<v8::Map> v8Map(const apache::geode::client::HashMapOfCacheablePtr & hashMapPtr, bool lazy = false);
+
+apache::geode::client::CacheablePtr getPdxField(const apache::geode::client::PdxInstancePtr & pdxInstance,
+                                                const char * key);
+
 template<typename T>
 v8::Local<v8::Array> v8Array(const apache::geode::client::SharedPtr<T> & iterablePtr) {
   Nan::EscapableHandleScope scope;
@@ -0,0 +1,468 @@
+#include "decoded_value.hpp"
+#include <nan.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "conversions.hpp"
+#include "field_name_cache.hpp"
+#include "string_conversions.hpp"
+
+using namespace v8;
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+void DecodedValue::clear() {
+  nodes.clear();
+  bytes.clear();
+  cacheables.clear();
+}
+
+DecodedValue::Node & DecodedValue::append(Kind kind, uint32_t length) {
+  nodes.push_back(Node());
+  Node & node = nodes.back();
+  node.kind = kind;
+  node.length = length;
+  node.int64 = 0;
+  return node;
+}
+
+void DecodedValue::appendCacheable(const CacheablePtr & cacheablePtr) {
+  append(CACHEABLE).offset = static_cast<uint32_t>(cacheables.size());
+  cacheables.push_back(cacheablePtr);
+}
+
+uint32_t DecodedValue::appendBytes(const void * data, size_t byteLength, size_t alignment, bool terminate) {
+  size_t offset = bytes.size();
+  offset += (alignment - offset % alignment) % alignment;
+
+  bytes.resize(offset + byteLength + (terminate ? 1 : 0));
+  if (data != NULL && byteLength > 0) {
+    memcpy(&bytes[offset], data, byteLength);
+  }
+  if (terminate) {
+    bytes[offset + byteLength] = '\0';
+  }
+
+  return static_cast<uint32_t>(offset);
+}
+
+void DecodedValue::decode(const CacheablePtr & valuePtr) {
+  clear();
+  decodeValue(valuePtr, rootProjection());
+}
+
+void DecodedValue::decode(const HashMapOfCacheablePtr & hashMapPtr, bool asMap) {
+  clear();
+  decodeMap(hashMapPtr, rootProjection(), asMap ? KEYED_MAP : MAP);
+}
+
+void DecodedValue::decode(const VectorOfCacheablePtr & vectorPtr) {
+  clear();
+  decodeIterable(vectorPtr);
+}
+
+void DecodedValue::decode(const VectorOfRegionEntry & vectorOfRegionEntries) {
+  clear();
+
+  int32_t length = vectorOfRegionEntries.length();
+  append(ARRAY, length);
+  for (int32_t i = 0; i < length; i++) {
+    append(ENTRY);
+    CacheablePtr keyPtr(vectorOfRegionEntries[i]->getKey());
+    decodeValue(keyPtr);
+    decodeValue(vectorOfRegionEntries[i]->getValue());
+  }
+}
+
+void DecodedValue::decodeValue(const CacheablePtr & valuePtr, const FieldProjection * fieldProjection) {
+  if (valuePtr == NULLPTR) {
+    append(NULL_VALUE);
+    return;
+  }
+
+  // Only stored values are envelopes; what they hold, and the fields of other values, are not.
+  if (openEnvelopes) {
+    openEnvelopes = false;
+    try {
+      if (!decodeEnvelope(valuePtr, fieldProjection)) {
+        decodeValue(valuePtr, fieldProjection);
+      }
+    } catch (...) {
+      openEnvelopes = true;
+      throw;
+    }
+    openEnvelopes = true;
+    return;
+  }
+
+  switch (valuePtr->typeId()) {
+    case GeodeTypeIds::CacheableASCIIString:
+    case GeodeTypeIds::CacheableASCIIStringHuge:
+    case GeodeTypeIds::CacheableString:
+    case GeodeTypeIds::CacheableStringHuge:
+      decodeString(static_cast<CacheableStringPtr>(valuePtr));
+      return;
+    case GeodeTypeIds::CacheableBoolean:
+      append(BOOLEAN).boolean = static_cast<CacheableBooleanPtr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableDouble:
+      append(NUMBER).number = static_cast<CacheableDoublePtr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableFloat:
+      append(NUMBER).number = static_cast<CacheableFloatPtr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableInt16:
+      append(NUMBER).number = static_cast<CacheableInt16Ptr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableInt32:
+      append(NUMBER).number = static_cast<CacheableInt32Ptr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableInt64:
+      append(INT64).int64 = static_cast<CacheableInt64Ptr>(valuePtr)->value();
+      return;
+    case GeodeTypeIds::CacheableDate:
+      append(DATE).number = static_cast<double>(static_cast<CacheableDatePtr>(valuePtr)->milliseconds());
+      return;
+    case GeodeTypeIds::CacheableUndefined:
+      append(UNDEFINED_VALUE);
+      return;
+    case GeodeTypeIds::CacheableObjectArray:
+      decodeIterable(static_cast<CacheableObjectArrayPtr>(valuePtr));
+      return;
+    case GeodeTypeIds::CacheableArrayList:
+      decodeIterable(static_cast<CacheableArrayListPtr>(valuePtr));
+      return;
+    case GeodeTypeIds::CacheableVector:
+      decodeIterable(static_cast<CacheableVectorPtr>(valuePtr));
+      return;
+    case GeodeTypeIds::CacheableHashSet:
+      decodeIterable(static_cast<CacheableHashSetPtr>(valuePtr));
+      return;
+    case GeodeTypeIds::CacheableHashMap:
+      decodeMap(static_cast<CacheableHashMapPtr>(valuePtr));
+      return;
+  }
+
+  PdxInstance * pdxInstance = dynamic_cast<PdxInstance *>(valuePtr.ptr());
+  if (pdxInstance != NULL) {
+    if (fieldProjection != NULL) {
+      decodeProjectedPdx(PdxInstancePtr(pdxInstance), *fieldProjection);
+    } else {
+      decodePdx(PdxInstancePtr(pdxInstance));
+    }
+    return;
+  }
+
+  // Byte and typed arrays are wrapped without copying, and Structs, function exceptions and
+  // unknown types keep their existing conversions; all of them are left to v8Value().
+  appendCacheable(valuePtr);
+}
+
+void DecodedValue::decodeString(const CacheableStringPtr & stringPtr) {
+  uint32_t length = stringPtr->length();
+
+  if (stringPtr->isWideString()) {
+    const wchar_t * wide = stringPtr->asWChar();
+    uint32_t offset = appendBytes(NULL, length * sizeof(uint16_t), sizeof(uint16_t));
+    uint16_t * twoByte = reinterpret_cast<uint16_t *>(bytes.data() + offset);
+    for (uint32_t i = 0; i < length; i++) {
+      twoByte[i] = wide[i];
+    }
+    append(TWO_BYTE_STRING, length).offset = offset;
+    return;
+  }
+
+  decodeUtf8(reinterpret_cast<const uint8_t *>(stringPtr->asChar()), length);
+}
+
+void DecodedValue::decodeUtf8(const uint8_t * data, uint32_t length) {
+  uint32_t offset = appendBytes(data, length);
+  append(isAscii(data, length) ? ONE_BYTE_STRING : UTF8_STRING, length).offset = offset;
+}
+
+void DecodedValue::decodePdx(const PdxInstancePtr & pdxInstancePtr) {
+  CacheableStringArrayPtr gemfireKeys(pdxInstancePtr->getFieldNames());
+  int length = gemfireKeys == NULLPTR ? 0 : gemfireKeys->length();
+
+  const char * className = pdxInstancePtr->getClassName();
+  append(PDX, length).offset = appendBytes(className, strlen(className), 1, true);
+
+  for (int i = 0; i < length; i++) {
+    const char * key = gemfireKeys[i]->asChar();
+    append(FIELD_NAME).offset = appendBytes(key, strlen(key), 1, true);
+  }
+
+  for (int i = 0; i < length; i++) {
+    decodeValue(getPdxField(pdxInstancePtr, gemfireKeys[i]->asChar()));
+  }
+}
+
+// Only the selected fields are read from the PdxInstance. The projected object is interned apart
+// from whole objects of its type, since it has other field names.
+void DecodedValue::decodeProjectedPdx(const PdxInstancePtr & pdxInstancePtr,
+                                      const FieldProjection & fieldProjection) {
+  std::vector<const FieldProjection *> selected;
+  const std::vector<FieldProjection> & fields(fieldProjection.fields());
+  for (std::vector<FieldProjection>::const_iterator iterator(fields.begin());
+       iterator != fields.end();
+       ++iterator) {
+    if (pdxInstancePtr->hasField(iterator->name().c_str())) {
+      selected.push_back(&*iterator);
+    }
+  }
+
+  std::string typeKey(pdxInstancePtr->getClassName());
+  typeKey += fieldProjection.signature();
+  append(PDX, selected.size()).offset = appendBytes(typeKey.data(), typeKey.length(), 1, true);
+
+  for (size_t i = 0; i < selected.size(); i++) {
+    const std::string & name(selected[i]->name());
+    append(FIELD_NAME).offset = appendBytes(name.data(), name.length(), 1, true);
+  }
+
+  for (size_t i = 0; i < selected.size(); i++) {
+    decodeValue(getPdxField(pdxInstancePtr, selected[i]->name().c_str()),
+                selected[i]->selectsAll() ? NULL : selected[i]);
+  }
+}
+
+// Buffers that were put before the region's codec was set are not envelopes and stay Buffers.
+bool DecodedValue::decodeEnvelope(const CacheablePtr & valuePtr, const FieldProjection * fieldProjection) {
+  const uint8_t * messagePack = NULL;
+  size_t messagePackLength = 0;
+  CacheablePtr openedPtr;
+  if (!openEnvelope(valuePtr, decompressed, messagePack, messagePackLength, openedPtr)) {
+    return false;
+  }
+
+  if (messagePack == NULL) {
+    decodeValue(openedPtr, fieldProjection);
+    return true;
+  }
+
+  MessagePackReader reader(messagePack, messagePackLength);
+  decodeMessagePack(reader, fieldProjection);
+  if (!reader.atEnd()) {
+    throw IllegalStateException("Corrupt MessagePack value.");
+  }
+  return true;
+}
+
+void DecodedValue::decodeMessagePack(MessagePackReader & reader, const FieldProjection * fieldProjection,
+                                     unsigned int depth) {
+  MessagePackReader::Item item;
+  reader.read(item);
+  if (item.type == MessagePackReader::ARRAY || item.type == MessagePackReader::MAP) {
+    MessagePackReader::checkDepth(depth);
+  }
+
+  switch (item.type) {
+    case MessagePackReader::NIL:
+      append(NULL_VALUE);
+      return;
+    case MessagePackReader::BOOLEAN:
+      append(BOOLEAN).boolean = item.boolean;
+      return;
+    case MessagePackReader::INTEGER:
+      append(NUMBER).number = static_cast<double>(item.integer);
+      return;
+    case MessagePackReader::INT64:
+      append(INT64).int64 = item.integer;
+      return;
+    case MessagePackReader::DOUBLE:
+      append(NUMBER).number = item.number;
+      return;
+    case MessagePackReader::STRING:
+      decodeUtf8(item.data, item.length);
+      return;
+    case MessagePackReader::BINARY:
+      appendCacheable(CacheableBytes::create(item.data, item.length));
+      return;
+    case MessagePackReader::ARRAY: {
+      append(ARRAY, item.length);
+      for (uint32_t i = 0; i < item.length; i++) {
+        decodeMessagePack(reader, NULL, depth + 1);
+      }
+      return;
+    }
+    case MessagePackReader::MAP: {
+      if (fieldProjection != NULL) {
+        decodeProjectedMap(reader, item.length, *fieldProjection, depth);
+        return;
+      }
+
+      append(MAP, item.length);
+      for (uint32_t i = 0; i < item.length; i++) {
+        decodeMessagePack(reader, NULL, depth + 1);
+        decodeMessagePack(reader, NULL, depth + 1);
+      }
+      return;
+    }
+    case MessagePackReader::EXTENSION:
+      decodeExtension(item);
+      return;
+  }
+}
+
+// Members that are not selected are skipped without being decoded; the map's length is only known
+// once every key has been looked at.
+void DecodedValue::decodeProjectedMap(MessagePackReader & reader, uint32_t length,
+                                      const FieldProjection & fieldProjection, unsigned int depth) {
+  size_t mapIndex = nodes.size();
+  append(MAP);
+
+  uint32_t selectedLength = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    MessagePackReader::Item key;
+    reader.read(key);
+
+    const FieldProjection * selected = NULL;
+    if (key.type == MessagePackReader::STRING) {
+      selected = fieldProjection.find(reinterpret_cast<const char *>(key.data), key.length);
+    } else if (key.type == MessagePackReader::ARRAY || key.type == MessagePackReader::MAP) {
+      // A container key is never selected; its elements follow its header.
+      uint64_t elements = key.type == MessagePackReader::MAP ?
+        2 * static_cast<uint64_t>(key.length) : key.length;
+      MessagePackReader::checkDepth(depth + 1);
+      for (uint64_t j = 0; j < elements; j++) {
+        reader.skip(depth + 2);
+      }
+    }
+
+    if (selected == NULL) {
+      reader.skip(depth + 1);
+      continue;
+    }
+
+    decodeUtf8(key.data, key.length);
+    decodeMessagePack(reader, selected->selectsAll() ? NULL : selected, depth + 1);
+    selectedLength++;
+  }
+
+  nodes[mapIndex].length = selectedLength;
+}
+
+void DecodedValue::decodeExtension(const MessagePackReader::Item & item) {
+  switch (item.extensionType) {
+    case TIMESTAMP_EXTENSION:
+      append(DATE).number = MessagePackReader::timestamp(item);
+      return;
+    case UNDEFINED_EXTENSION:
+      append(UNDEFINED_VALUE);
+      return;
+    case INT16_ARRAY_EXTENSION:
+      decodeTypedArray<int16_t, CacheableInt16Array>(item);
+      return;
+    case INT32_ARRAY_EXTENSION:
+      decodeTypedArray<int32_t, CacheableInt32Array>(item);
+      return;
+    case FLOAT_ARRAY_EXTENSION:
+      decodeTypedArray<float, CacheableFloatArray>(item);
+      return;
+    case DOUBLE_ARRAY_EXTENSION:
+      decodeTypedArray<double, CacheableDoubleArray>(item);
+      return;
+    case INT64_ARRAY_EXTENSION:
+      decodeTypedArray<int64_t, CacheableInt64Array>(item);
+      return;
+  }
+
+  throw IllegalStateException("Unsupported MessagePack extension type.");
+}
+
+Local<Value> DecodedValue::v8Value() const {
+  Nan::EscapableHandleScope scope;
+
+  if (nodes.empty()) {
+    return scope.Escape(Nan::Undefined());
+  }
+
+  size_t cursor = 0;
+  return scope.Escape(materialize(cursor));
+}
+
+Local<Value> DecodedValue::materialize(size_t & cursor) const {
+  Nan::EscapableHandleScope scope;
+
+  const Node & node = nodes[cursor++];
+  switch (node.kind) {
+    case NULL_VALUE:
+      return scope.Escape(Nan::Null());
+    case UNDEFINED_VALUE:
+      return scope.Escape(Nan::Undefined());
+    case BOOLEAN:
+      return scope.Escape(Nan::New(node.boolean));
+    case NUMBER:
+      return scope.Escape(Nan::New(node.number));
+    case INT64:
+      return scope.Escape(v8Int64(node.int64));
+    case DATE:
+      return scope.Escape(Nan::New<Date>(node.number).ToLocalChecked());
+    case ONE_BYTE_STRING: {
+      const uint8_t * oneByte = reinterpret_cast<const uint8_t *>(bytes.data() + node.offset);
+      return scope.Escape(String::NewFromOneByte(Isolate::GetCurrent(), oneByte, NewStringType::kNormal,
+                                                 node.length).ToLocalChecked());
+    }
+    case UTF8_STRING:
+      return scope.Escape(Nan::New<String>(bytes.data() + node.offset, node.length).ToLocalChecked());
+    case TWO_BYTE_STRING:
+      return scope.Escape(Nan::New<String>(reinterpret_cast<const uint16_t *>(bytes.data() + node.offset),
+                                           node.length).ToLocalChecked());
+    case ARRAY: {
+      Local<Array> v8Array(Nan::New<Array>(node.length));
+      for (uint32_t i = 0; i < node.length; i++) {
+        Nan::Set(v8Array, i, materialize(cursor));
+      }
+      return scope.Escape(v8Array);
+    }
+    case MAP: {
+      Local<Object> v8Object(Nan::New<Object>());
+      for (uint32_t i = 0; i < node.length; i++) {
+        Local<Value> key(materialize(cursor));
+        Nan::Set(v8Object, key, materialize(cursor));
+      }
+      return scope.Escape(v8Object);
+    }
+    case KEYED_MAP: {
+      Local<Context> context(Nan::GetCurrentContext());
+      Local<v8::Map> v8Map(v8::Map::New(Isolate::GetCurrent()));
+      for (uint32_t i = 0; i < node.length; i++) {
+        Local<Value> key(materialize(cursor));
+        v8Map->Set(context, key, materialize(cursor)).ToLocalChecked();
+      }
+      return scope.Escape(v8Map);
+    }
+    case ENTRY: {
+      InternedFieldNamesPtr fieldNames(FieldNameCache::getInstance()->regionEntry());
+      Local<Object> v8Object(fieldNames->newObject());
+      Nan::Set(v8Object, fieldNames->get(0), materialize(cursor));
+      Nan::Set(v8Object, fieldNames->get(1), materialize(cursor));
+      return scope.Escape(v8Object);
+    }
+    case PDX: {
+      std::vector<const char *> keys;
+      keys.reserve(node.length);
+      for (uint32_t i = 0; i < node.length; i++) {
+        keys.push_back(bytes.data() + nodes[cursor++].offset);
+      }
+
+      if (node.length == 0) {
+        return scope.Escape(Nan::New<Object>());
+      }
+
+      InternedFieldNamesPtr fieldNames(FieldNameCache::getInstance()->find(bytes.data() + node.offset, keys));
+      Local<Object> v8Object(fieldNames->newObject());
+      for (uint32_t i = 0; i < node.length; i++) {
+        Nan::Set(v8Object, fieldNames->get(i), materialize(cursor));
+      }
+      return scope.Escape(v8Object);
+    }
+    case CACHEABLE:
+      return scope.Escape(node_gemfire::v8Value(cacheables[node.offset]));
+  }
+
+  return scope.Escape(Nan::Undefined());
+}
+
+}  // namespace node_gemfire
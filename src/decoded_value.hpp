@@ -0,0 +1,140 @@
+#ifndef __DECODED_VALUE_HPP__
+#define __DECODED_VALUE_HPP__
+
+#include <v8.h>
+#include <geode/GeodeCppCache.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "field_projection.hpp"
+#include "message_pack.hpp"
+#include "value_codec.hpp"
+
+namespace node_gemfire {
+
+// A V8-free copy of a GemFire value. decode() runs on a libuv worker thread and does all of the
+// getFieldNames()/getField() calls and string copies; v8Value() then only has to create handles on
+// the JavaScript thread. Nodes are stored in pre-order and every string lives in one byte arena.
+// Values encoded by a region's codec are decoded straight into nodes as well.
+class DecodedValue {
+ public:
+  explicit DecodedValue(const ValueCodecOptions & options = ValueCodecOptions()) :
+    openEnvelopes(options.usesEnvelopes()) {}
+
+  // Only the selected fields of objects are decoded from then on: of the value itself, or of each
+  // value of a map of results.
+  void project(const FieldProjection & fields) {
+    projection = fields;
+  }
+
+  void decode(const apache::geode::client::CacheablePtr & valuePtr);
+  // A map of results decoded asMap materializes as a JavaScript Map, which keeps the type of every
+  // key, rather than as an object with String keys.
+  void decode(const apache::geode::client::HashMapOfCacheablePtr & hashMapPtr, bool asMap = false);
+  void decode(const apache::geode::client::VectorOfCacheablePtr & vectorPtr);
+  void decode(const apache::geode::client::VectorOfRegionEntry & vectorOfRegionEntries);
+
+  v8::Local<v8::Value> v8Value() const;
+
+ private:
+  enum Kind {
+    NULL_VALUE,
+    UNDEFINED_VALUE,
+    BOOLEAN,
+    NUMBER,
+    INT64,
+    DATE,
+    ONE_BYTE_STRING,
+    UTF8_STRING,
+    TWO_BYTE_STRING,
+    ARRAY,
+    MAP,
+    KEYED_MAP,
+    PDX,
+    FIELD_NAME,
+    ENTRY,
+    CACHEABLE
+  };
+
+  // length is the child count for containers and the code unit count for strings. offset points
+  // into bytes for strings and names, or into cacheables for CACHEABLE.
+  struct Node {
+    uint8_t kind;
+    uint32_t length;
+    union {
+      double number;
+      int64_t int64;
+      uint32_t offset;
+      bool boolean;
+    };
+  };
+
+  void clear();
+  Node & append(Kind kind, uint32_t length = 0);
+  uint32_t appendBytes(const void * data, size_t byteLength, size_t alignment = 1, bool terminate = false);
+  void appendCacheable(const apache::geode::client::CacheablePtr & cacheablePtr);
+
+  // A NULL projection decodes the whole value.
+  void decodeValue(const apache::geode::client::CacheablePtr & valuePtr,
+                   const FieldProjection * fieldProjection = NULL);
+  void decodeString(const apache::geode::client::CacheableStringPtr & stringPtr);
+  void decodeUtf8(const uint8_t * data, uint32_t length);
+  void decodePdx(const apache::geode::client::PdxInstancePtr & pdxInstancePtr);
+  void decodeProjectedPdx(const apache::geode::client::PdxInstancePtr & pdxInstancePtr,
+                          const FieldProjection & fieldProjection);
+  bool decodeEnvelope(const apache::geode::client::CacheablePtr & valuePtr,
+                      const FieldProjection * fieldProjection);
+  void decodeMessagePack(MessagePackReader & reader, const FieldProjection * fieldProjection = NULL,
+                         unsigned int depth = 0);
+  void decodeProjectedMap(MessagePackReader & reader, uint32_t length,
+                          const FieldProjection & fieldProjection, unsigned int depth);
+  void decodeExtension(const MessagePackReader::Item & item);
+
+  template<typename T, typename C>
+  void decodeTypedArray(const MessagePackReader::Item & item) {
+    // The payload is not aligned, so the elements are copied out before the array is created.
+    std::vector<T> elements(item.length / sizeof(T));
+    memcpy(elements.data(), item.data, elements.size() * sizeof(T));
+    appendCacheable(C::create(elements.data(), elements.size()));
+  }
+
+  template<typename T>
+  void decodeIterable(const apache::geode::client::SharedPtr<T> & iterablePtr) {
+    append(ARRAY, iterablePtr->size());
+    for (typename T::Iterator iterator(iterablePtr->begin());
+         iterator != iterablePtr->end();
+         ++iterator) {
+      decodeValue(*iterator);
+    }
+  }
+
+  template<typename T>
+  void decodeMap(const apache::geode::client::SharedPtr<T> & hashMapPtr,
+                 const FieldProjection * valueProjection = NULL, Kind kind = MAP) {
+    append(kind, hashMapPtr->size());
+    for (typename T::Iterator iterator = hashMapPtr->begin();
+         iterator != hashMapPtr->end();
+         iterator++) {
+      apache::geode::client::CacheablePtr keyPtr(iterator.first());
+      decodeValue(keyPtr);
+      decodeValue(iterator.second(), valueProjection);
+    }
+  }
+
+  const FieldProjection * rootProjection() const {
+    return projection.empty() ? NULL : &projection;
+  }
+
+  v8::Local<v8::Value> materialize(size_t & cursor) const;
+
+  bool openEnvelopes;
+  FieldProjection projection;
+  std::vector<uint8_t> decompressed;
+  std::vector<Node> nodes;
+  std::vector<char> bytes;
+  std::vector<apache::geode::client::CacheablePtr> cacheables;
+};
+
+}  // namespace node_gemfire
+
+#endif
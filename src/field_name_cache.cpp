@@ -0,0 +1,120 @@
+#include "field_name_cache.hpp"
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace v8;
+
+namespace node_gemfire {
+
+InternedFieldNames::InternedFieldNames(const std::vector<const char *> & names) :
+  unique(true) {
+  Nan::HandleScope scope;
+
+  Isolate * isolate = Isolate::GetCurrent();
+  size_t length = names.size();
+  this->names.reserve(length);
+  strings.reserve(length);
+
+  for (size_t i = 0; i < length; i++) {
+    this->names.push_back(names[i]);
+
+    Local<String> v8String(
+        String::NewFromUtf8(isolate, names[i], NewStringType::kInternalized).ToLocalChecked());
+    strings.push_back(new Nan::Persistent<String>(v8String));
+  }
+
+  std::unordered_set<std::string> seen(this->names.begin(), this->names.end());
+  unique = (seen.size() == length);
+}
+
+InternedFieldNames::~InternedFieldNames() {
+  for (std::vector<Nan::Persistent<String> *>::iterator iterator(strings.begin());
+       iterator != strings.end();
+       ++iterator) {
+    (*iterator)->Reset();
+    delete *iterator;
+  }
+  objectTemplate.Reset();
+}
+
+bool InternedFieldNames::matches(const std::vector<const char *> & otherNames) const {
+  size_t length = names.size();
+  if (otherNames.size() != length) {
+    return false;
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    if (strcmp(names[i].c_str(), otherNames[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Local<String> InternedFieldNames::get(size_t index) const {
+  return Nan::New(*strings[index]);
+}
+
+Local<Object> InternedFieldNames::newObject() {
+  Nan::EscapableHandleScope scope;
+
+  if (!unique) {
+    return scope.Escape(Nan::New<Object>());
+  }
+
+  if (objectTemplate.IsEmpty()) {
+    Local<ObjectTemplate> v8ObjectTemplate(Nan::New<ObjectTemplate>());
+    for (size_t i = 0; i < strings.size(); i++) {
+      Nan::SetTemplate(v8ObjectTemplate, get(i), Nan::Undefined());
+    }
+    objectTemplate.Reset(v8ObjectTemplate);
+  }
+
+  return scope.Escape(Nan::NewInstance(Nan::New(objectTemplate)).ToLocalChecked());
+}
+
+FieldNameCache * FieldNameCache::getInstance() {
+  // Deliberately never destroyed; the Persistent handles must not outlive the isolate at exit.
+  static FieldNameCache * instance = new FieldNameCache();
+  return instance;
+}
+
+InternedFieldNamesPtr FieldNameCache::find(const std::string & typeKey,
+                                           const std::vector<const char *> & names) {
+  std::unordered_map<std::string, InternedFieldNamesPtr>::iterator iterator(fieldNames.find(typeKey));
+
+  // A PDX class name can map to several field lists as the type evolves, so confirm the names.
+  if (iterator != fieldNames.end() && iterator->second->matches(names)) {
+    hits++;
+    return iterator->second;
+  }
+
+  misses++;
+
+  InternedFieldNamesPtr internedFieldNames(new InternedFieldNames(names));
+
+  if (iterator != fieldNames.end()) {
+    iterator->second = internedFieldNames;
+  } else {
+    if (fieldNames.size() >= maxEntries) {
+      fieldNames.clear();
+    }
+    fieldNames.insert(std::make_pair(typeKey, internedFieldNames));
+  }
+
+  return internedFieldNames;
+}
+
+InternedFieldNamesPtr FieldNameCache::regionEntry() {
+  if (!regionEntryFieldNames) {
+    std::vector<const char *> names;
+    names.push_back("key");
+    names.push_back("value");
+    regionEntryFieldNames.reset(new InternedFieldNames(names));
+  }
+  return regionEntryFieldNames;
+}
+
+}  // namespace node_gemfire
@@ -0,0 +1,73 @@
+#ifndef __FIELD_NAME_CACHE_HPP__
+#define __FIELD_NAME_CACHE_HPP__
+
+#include <v8.h>
+#include <nan.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node_gemfire {
+
+// The V8 strings for the field names of one PDX type or Struct field set, created once as
+// internalized strings and reused for every object of that type. Objects of the type are created
+// from an ObjectTemplate that already has every field, so that they all share one hidden class
+// with in-object properties instead of transitioning through a new map per field.
+class InternedFieldNames {
+ public:
+  explicit InternedFieldNames(const std::vector<const char *> & names);
+  ~InternedFieldNames();
+
+  bool matches(const std::vector<const char *> & otherNames) const;
+
+  size_t size() const { return names.size(); }
+  const std::string & name(size_t index) const { return names[index]; }
+  v8::Local<v8::String> get(size_t index) const;
+  // An object with every field set to undefined, ready to be filled in with Nan::Set().
+  v8::Local<v8::Object> newObject();
+
+ private:
+  InternedFieldNames(const InternedFieldNames &);
+  InternedFieldNames & operator=(const InternedFieldNames &);
+
+  std::vector<std::string> names;
+  std::vector<Nan::Persistent<v8::String> *> strings;
+  // Templates cannot hold the same name twice, so Structs with repeated field names go without.
+  bool unique;
+  Nan::Persistent<v8::ObjectTemplate> objectTemplate;
+};
+
+typedef std::shared_ptr<InternedFieldNames> InternedFieldNamesPtr;
+
+// Only ever touched from the JavaScript thread. node-gemfire runs on the main isolate only, so a
+// single instance serves as the per-isolate intern table.
+class FieldNameCache {
+ public:
+  FieldNameCache() :
+    hits(0),
+    misses(0) {}
+
+  static FieldNameCache * getInstance();
+
+  InternedFieldNamesPtr find(const std::string & typeKey, const std::vector<const char *> & names);
+  // The "key" and "value" fields of the objects returned by region.entries().
+  InternedFieldNamesPtr regionEntry();
+
+  uint64_t getHits() const { return hits; }
+  uint64_t getMisses() const { return misses; }
+  size_t size() const { return fieldNames.size(); }
+
+ private:
+  static const size_t maxEntries = 4096;
+
+  std::unordered_map<std::string, InternedFieldNamesPtr> fieldNames;
+  InternedFieldNamesPtr regionEntryFieldNames;
+  uint64_t hits;
+  uint64_t misses;
+};
+
+}  // namespace node_gemfire
+
+#endif
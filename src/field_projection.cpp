@@ -0,0 +1,78 @@
+#include "field_projection.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace node_gemfire {
+
+void FieldProjection::add(const std::string & path) {
+  FieldProjection * projection = this;
+  bool created = true;
+  size_t start = 0;
+
+  while (start <= path.length()) {
+    size_t end = path.find('.', start);
+    if (end == std::string::npos) {
+      end = path.length();
+    }
+    std::string segment(path, start, end - start);
+
+    // A field that is already selected whole stays whole.
+    if (!created && projection->children.empty()) {
+      return;
+    }
+
+    std::vector<FieldProjection>::iterator iterator(projection->children.begin());
+    while (iterator != projection->children.end() && iterator->fieldName != segment) {
+      ++iterator;
+    }
+
+    created = iterator == projection->children.end();
+    if (created) {
+      projection->children.push_back(FieldProjection(segment));
+      projection = &projection->children.back();
+    } else {
+      projection = &*iterator;
+    }
+
+    start = end + 1;
+  }
+
+  // The last segment selects its field whole, even if deeper paths were added before.
+  projection->children.clear();
+}
+
+const FieldProjection * FieldProjection::find(const char * name, size_t length) const {
+  for (std::vector<FieldProjection>::const_iterator iterator(children.begin());
+       iterator != children.end();
+       ++iterator) {
+    if (iterator->fieldName.length() == length && memcmp(iterator->fieldName.data(), name, length) == 0) {
+      return &*iterator;
+    }
+  }
+  return NULL;
+}
+
+std::string FieldProjection::signature() const {
+  std::string output;
+  appendSignature(output);
+  return output;
+}
+
+void FieldProjection::appendSignature(std::string & output) const {
+  output += '{';
+  for (std::vector<FieldProjection>::const_iterator iterator(children.begin());
+       iterator != children.end();
+       ++iterator) {
+    if (iterator != children.begin()) {
+      output += ',';
+    }
+    output += iterator->fieldName;
+    if (!iterator->children.empty()) {
+      iterator->appendSignature(output);
+    }
+  }
+  output += '}';
+}
+
+}  // namespace node_gemfire
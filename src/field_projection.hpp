@@ -0,0 +1,53 @@
+#ifndef __FIELD_PROJECTION_HPP__
+#define __FIELD_PROJECTION_HPP__
+
+#include <string>
+#include <vector>
+
+namespace node_gemfire {
+
+// The fields selected by the fields option of get() and getAll(), as a tree built from dotted
+// paths such as "address.city". A field without children is selected whole; selecting "a" and
+// "a.b" selects all of "a". Copied into workers and only read on the worker thread afterwards.
+class FieldProjection {
+ public:
+  FieldProjection() {}
+
+  void add(const std::string & path);
+
+  bool empty() const {
+    return children.empty();
+  }
+
+  const std::vector<FieldProjection> & fields() const {
+    return children;
+  }
+
+  const std::string & name() const {
+    return fieldName;
+  }
+
+  // Set for a field selected whole, and for a value that has no fields to select from.
+  bool selectsAll() const {
+    return children.empty();
+  }
+
+  // The projection below a field, or NULL if the field is not selected.
+  const FieldProjection * find(const char * name, size_t length) const;
+
+  // A string that tells projections apart, for interning the field names of projected objects.
+  std::string signature() const;
+
+ private:
+  explicit FieldProjection(const std::string & fieldName) :
+    fieldName(fieldName) {}
+
+  void appendSignature(std::string & output) const;
+
+  std::string fieldName;
+  std::vector<FieldProjection> children;
+};
+
+}  // namespace node_gemfire
+
+#endif
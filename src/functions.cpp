@@ -8,6 +8,7 @@
 #include "dependencies.hpp"
 #include "exceptions.hpp"
 #include "events.hpp"
+#include "gemfire_executor.hpp"
 #include "streaming_result_collector.hpp"
 
 using namespace v8;
@@ -34,7 +35,6 @@ class ExecuteFunctionWorker {
     ended(false),
     executeCompleted(false) {
       emitter.Reset(emitterHandle);
-      request.data = reinterpret_cast<void *>(this);
     }
 
   ~ExecuteFunctionWorker() {
@@ -42,13 +42,13 @@ class ExecuteFunctionWorker {
     delete resultStream;
   }
 
-  static void Execute(uv_work_t * request) {
-    ExecuteFunctionWorker * worker = static_cast<ExecuteFunctionWorker *>(request->data);
+  static void Execute(void * data) {
+    ExecuteFunctionWorker * worker = static_cast<ExecuteFunctionWorker *>(data);
     worker->Execute();
   }
 
-  static void ExecuteComplete(uv_work_t * request, int status) {
-    ExecuteFunctionWorker * worker = static_cast<ExecuteFunctionWorker *>(request->data);
+  static void ExecuteComplete(void * data) {
+    ExecuteFunctionWorker * worker = static_cast<ExecuteFunctionWorker *>(data);
     worker->ExecuteComplete();
   }
 
@@ -129,8 +129,6 @@ class ExecuteFunctionWorker {
     }
   }
 
-  uv_work_t request;
-
  private:
   ResultStream * resultStream;
 
@@ -238,11 +236,10 @@ Local<Value> executeFunction(Nan::NAN_METHOD_ARGS_TYPE info,
     ExecuteFunctionWorker * worker =
       new ExecuteFunctionWorker(executionPtr, functionName, functionArguments, functionFilter, eventEmitter);
 
-    uv_queue_work(
-        uv_default_loop(),
-        &worker->request,
+    GemfireExecutor::getInstance()->queue(
         ExecuteFunctionWorker::Execute,
-        ExecuteFunctionWorker::ExecuteComplete);
+        ExecuteFunctionWorker::ExecuteComplete,
+        worker);
 
     return scope.Escape(eventEmitter);
   }
@@ -0,0 +1,163 @@
+#include "gemfire_executor.hpp"
+#include <cstdlib>
+
+namespace node_gemfire {
+
+namespace {
+
+// Sized for threads that mostly wait on the network; override with GEMFIRE_THREADPOOL_SIZE or
+// gemfire.setThreadPoolSize().
+const size_t defaultThreadCount = 8;
+const size_t maxThreadCount = 1024;
+
+size_t initialThreadCount() {
+  const char * configured = getenv("GEMFIRE_THREADPOOL_SIZE");
+  long threadCount = configured ? strtol(configured, NULL, 10) : 0;
+  if (threadCount <= 0) {
+    return defaultThreadCount;
+  }
+  return static_cast<size_t>(threadCount) > maxThreadCount ? maxThreadCount : threadCount;
+}
+
+void executeWorker(void * data) {
+  static_cast<Nan::AsyncWorker *>(data)->Execute();
+}
+
+void completeWorker(void * data) {
+  Nan::AsyncWorker * worker = static_cast<Nan::AsyncWorker *>(data);
+  worker->WorkComplete();
+  worker->Destroy();
+}
+
+}  // namespace
+
+GemfireExecutor::GemfireExecutor() :
+    threadCount(initialThreadCount()),
+    outstanding(0) {
+  uv_mutex_init(&mutex);
+  uv_cond_init(&taskAvailable);
+}
+
+GemfireExecutor * GemfireExecutor::getInstance() {
+  static GemfireExecutor * instance = new GemfireExecutor();
+  return instance;
+}
+
+bool GemfireExecutor::setThreadCount(size_t newThreadCount) {
+  if (started() || newThreadCount == 0 || newThreadCount > maxThreadCount) {
+    return false;
+  }
+  threadCount = newThreadCount;
+  return true;
+}
+
+size_t GemfireExecutor::getThreadCount() const {
+  return threadCount;
+}
+
+bool GemfireExecutor::started() const {
+  return !threads.empty();
+}
+
+void GemfireExecutor::start() {
+  uv_async_init(uv_default_loop(), &completedAsync, completedCallback);
+  completedAsync.data = this;
+  uv_unref(reinterpret_cast<uv_handle_t *>(&completedAsync));
+
+  threads.resize(threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    uv_thread_create(&threads[i], threadMain, this);
+  }
+}
+
+void GemfireExecutor::queue(TaskCallback execute, TaskCallback complete, void * data) {
+  if (!started()) {
+    start();
+  }
+
+  if (outstanding++ == 0) {
+    uv_ref(reinterpret_cast<uv_handle_t *>(&completedAsync));
+  }
+
+  Task task = { execute, complete, data, uv_hrtime() };
+
+  uv_mutex_lock(&mutex);
+  tasks.push_back(task);
+  stats.queueDepth = tasks.size();
+  if (stats.queueDepth > stats.maxQueueDepth) {
+    stats.maxQueueDepth = stats.queueDepth;
+  }
+  uv_cond_signal(&taskAvailable);
+  uv_mutex_unlock(&mutex);
+}
+
+void GemfireExecutor::threadMain(void * executor) {
+  static_cast<GemfireExecutor *>(executor)->run();
+}
+
+void GemfireExecutor::run() {
+  uv_mutex_lock(&mutex);
+  while (true) {
+    while (tasks.empty()) {
+      uv_cond_wait(&taskAvailable, &mutex);
+    }
+
+    Task task(tasks.front());
+    tasks.pop_front();
+
+    uint64_t startedAt = uv_hrtime();
+    uint64_t waitNanoseconds = startedAt - task.queuedAt;
+    stats.queueDepth = tasks.size();
+    stats.active++;
+    stats.waitNanoseconds += waitNanoseconds;
+    if (waitNanoseconds > stats.maxWaitNanoseconds) {
+      stats.maxWaitNanoseconds = waitNanoseconds;
+    }
+    uv_mutex_unlock(&mutex);
+
+    task.execute(task.data);
+    uint64_t runNanoseconds = uv_hrtime() - startedAt;
+
+    uv_mutex_lock(&mutex);
+    stats.active--;
+    stats.runNanoseconds += runNanoseconds;
+    completedTasks.push_back(task);
+    uv_async_send(&completedAsync);
+  }
+}
+
+void GemfireExecutor::completedCallback(uv_async_t * async) {
+  static_cast<GemfireExecutor *>(async->data)->completeTasks();
+}
+
+// uv_async_send() coalesces, so every task completed since the last call is handled here.
+void GemfireExecutor::completeTasks() {
+  std::vector<Task> completed;
+  uv_mutex_lock(&mutex);
+  completed.swap(completedTasks);
+  stats.completed += completed.size();
+  uv_mutex_unlock(&mutex);
+
+  for (std::vector<Task>::iterator iterator(completed.begin()); iterator != completed.end(); ++iterator) {
+    iterator->complete(iterator->data);
+  }
+
+  outstanding -= completed.size();
+  if (outstanding == 0) {
+    uv_unref(reinterpret_cast<uv_handle_t *>(&completedAsync));
+  }
+}
+
+GemfireExecutor::Stats GemfireExecutor::getStats() {
+  uv_mutex_lock(&mutex);
+  Stats current(stats);
+  uv_mutex_unlock(&mutex);
+  current.threads = threads.size() > 0 ? threads.size() : threadCount;
+  return current;
+}
+
+void queueGemfireWorker(Nan::AsyncWorker * worker) {
+  GemfireExecutor::getInstance()->queue(executeWorker, completeWorker, worker);
+}
+
+}  // namespace node_gemfire
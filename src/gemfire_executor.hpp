@@ -0,0 +1,91 @@
+#ifndef __GEMFIRE_EXECUTOR_HPP__
+#define __GEMFIRE_EXECUTOR_HPP__
+
+#include <nan.h>
+#include <uv.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace node_gemfire {
+
+// A thread pool for blocking GemFire calls, separate from the libuv thread pool so that slow
+// servers cannot hold up fs, dns or zlib work, and the other way around. Tasks are queued and
+// completed on the JavaScript thread; only the queues and the stats are shared with the pool
+// threads.
+class GemfireExecutor {
+ public:
+  typedef void (*TaskCallback)(void * data);
+
+  struct Stats {
+    Stats() :
+      threads(0),
+      queueDepth(0),
+      maxQueueDepth(0),
+      active(0),
+      completed(0),
+      waitNanoseconds(0),
+      maxWaitNanoseconds(0),
+      runNanoseconds(0) {}
+
+    size_t threads;
+    size_t queueDepth;
+    size_t maxQueueDepth;
+    size_t active;
+    uint64_t completed;
+    // Time tasks spent queued before a thread picked them up, and running on it.
+    uint64_t waitNanoseconds;
+    uint64_t maxWaitNanoseconds;
+    uint64_t runNanoseconds;
+  };
+
+  static GemfireExecutor * getInstance();
+
+  // Runs execute(data) on a pool thread, then complete(data) on the JavaScript thread.
+  void queue(TaskCallback execute, TaskCallback complete, void * data);
+
+  // The number of threads can only be changed before the first task starts the pool.
+  bool setThreadCount(size_t threadCount);
+  size_t getThreadCount() const;
+  bool started() const;
+
+  Stats getStats();
+
+ private:
+  struct Task {
+    TaskCallback execute;
+    TaskCallback complete;
+    void * data;
+    uint64_t queuedAt;
+  };
+
+  GemfireExecutor();
+
+  void start();
+  void run();
+  void completeTasks();
+
+  static void threadMain(void * executor);
+  static void completedCallback(uv_async_t * async);
+
+  size_t threadCount;
+  std::vector<uv_thread_t> threads;
+
+  uv_mutex_t mutex;
+  uv_cond_t taskAvailable;
+  std::deque<Task> tasks;
+  std::vector<Task> completedTasks;
+  Stats stats;
+
+  // Keeps the event loop alive only while tasks are outstanding. Touched on the JavaScript thread.
+  uv_async_t completedAsync;
+  size_t outstanding;
+};
+
+// Queues a Nan::AsyncWorker on the GemFire thread pool instead of the libuv one.
+void queueGemfireWorker(Nan::AsyncWorker * worker);
+
+}  // namespace node_gemfire
+
+#endif
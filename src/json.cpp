@@ -0,0 +1,1405 @@
+#include "json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "message_pack.hpp"
+#include "string_conversions.hpp"
+
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+namespace {
+
+const unsigned int maxDepth = 4096;
+
+// Word-at-a-time byte tests in the style of isAscii(): each looks at eight bytes per operation.
+const uint64_t lowBits = 0x0101010101010101ULL;
+const uint64_t highBits = 0x8080808080808080ULL;
+
+inline uint64_t hasByteLessThan(uint64_t word, uint8_t limit) {
+  return (word - lowBits * limit) & ~word & highBits;
+}
+
+inline uint64_t hasByte(uint64_t word, uint8_t byte) {
+  return hasByteLessThan(word ^ (lowBits * byte), 1);
+}
+
+inline bool isDigit(char character) {
+  return character >= '0' && character <= '9';
+}
+
+// V8 enumerates integer-like property names ("0" to "4294967294") before all others.
+bool isArrayIndex(const std::string & name, uint32_t & index) {
+  size_t length = name.length();
+  if (length == 0 || length > 10) {
+    return false;
+  }
+  if (name[0] == '0') {
+    index = 0;
+    return length == 1;
+  }
+
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; i++) {
+    if (!isDigit(name[i])) {
+      return false;
+    }
+    value = (value * 10) + (name[i] - '0');
+  }
+  if (value >= 4294967295ULL) {
+    return false;
+  }
+
+  index = static_cast<uint32_t>(value);
+  return true;
+}
+
+// Returns which of the named members to emit, in the order V8 enumerates the own properties of an
+// object built from them: array indices ascending, then the other names in insertion order. A
+// repeated name keeps its first position but takes its last value.
+std::vector<size_t> propertyOrder(const std::vector<std::string> & names) {
+  size_t length = names.size();
+  std::vector<size_t> order;
+  order.reserve(length);
+
+  if (length <= 8) {
+    for (size_t i = 0; i < length; i++) {
+      size_t j = 0;
+      while (j < order.size() && names[order[j]] != names[i]) {
+        j++;
+      }
+      if (j < order.size()) {
+        order[j] = i;
+      } else {
+        order.push_back(i);
+      }
+    }
+  } else {
+    std::unordered_map<std::string, size_t> positions;
+    for (size_t i = 0; i < length; i++) {
+      std::pair<std::unordered_map<std::string, size_t>::iterator, bool> inserted(
+          positions.insert(std::make_pair(names[i], order.size())));
+      if (inserted.second) {
+        order.push_back(i);
+      } else {
+        order[inserted.first->second] = i;
+      }
+    }
+  }
+
+  std::vector<std::pair<uint32_t, size_t> > indices;
+  std::vector<size_t> others;
+  for (size_t i = 0; i < order.size(); i++) {
+    uint32_t index;
+    if (isArrayIndex(names[order[i]], index)) {
+      indices.push_back(std::make_pair(index, order[i]));
+    } else {
+      others.push_back(order[i]);
+    }
+  }
+
+  if (indices.empty()) {
+    return order;
+  }
+
+  std::sort(indices.begin(), indices.end());
+  order.clear();
+  for (size_t i = 0; i < indices.size(); i++) {
+    order.push_back(indices[i].second);
+  }
+  order.insert(order.end(), others.begin(), others.end());
+  return order;
+}
+
+// JSON escapes can produce lone surrogates, which are kept as three byte sequences. V8 turns them
+// into U+FFFD when it writes a property name as UTF-8, so PDX field names do the same.
+std::string pdxFieldName(const std::string & name) {
+  std::string fieldName;
+  fieldName.reserve(name.length());
+  for (size_t i = 0; i < name.length(); i++) {
+    if (static_cast<uint8_t>(name[i]) == 0xED && i + 2 < name.length() &&
+        static_cast<uint8_t>(name[i + 1]) >= 0xA0) {
+      fieldName += "\xEF\xBF\xBD";
+      i += 2;
+    } else {
+      fieldName += name[i];
+    }
+  }
+  return fieldName;
+}
+
+void appendUtf8(std::string & utf8, uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    utf8 += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    utf8 += static_cast<char>(0xC0 | (codePoint >> 6));
+    utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    utf8 += static_cast<char>(0xE0 | (codePoint >> 12));
+    utf8 += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    utf8 += static_cast<char>(0xF0 | (codePoint >> 18));
+    utf8 += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    utf8 += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+// Parses into a tape of tokens first, so that the members of an object are known before its PDX
+// type is chosen, and then stages the tape.
+class JsonParser {
+ public:
+  JsonParser(const char * json, size_t length) :
+    json(json),
+    length(length),
+    position(0) {}
+
+  bool parse(std::string & errorMessage);
+  bool stage(StagingBuffer & stagingBuffer, bool entries, std::string & errorMessage);
+
+ private:
+  enum Type {
+    NULL_TOKEN,
+    TRUE_TOKEN,
+    FALSE_TOKEN,
+    NUMBER_TOKEN,
+    STRING_TOKEN,
+    ARRAY_TOKEN,
+    OBJECT_TOKEN
+  };
+
+  // end is the index of the first token after this token's subtree. Strings are unescaped into
+  // the strings arena; count is the number of elements or members of a container.
+  struct Token {
+    uint8_t type;
+    uint32_t end;
+    uint32_t count;
+    uint32_t offset;
+    uint32_t length;
+    double number;
+  };
+
+  Token & push(Type type);
+  bool unexpected();
+  void skipWhitespace();
+  bool parseValue(unsigned int depth);
+  bool parseContainer(Type type, unsigned int depth);
+  bool parseString();
+  bool parseHex4(uint32_t & codeUnit);
+  bool parseNumber();
+  bool parseLiteral(const char * literal, Type type);
+
+  void members(size_t index, std::vector<std::string> & names, std::vector<size_t> & values) const;
+  void stageToken(size_t index, StagingBuffer & stagingBuffer) const;
+
+  const char * json;
+  size_t length;
+  size_t position;
+  std::vector<Token> tokens;
+  std::string strings;
+  std::string error;
+};
+
+JsonParser::Token & JsonParser::push(Type type) {
+  tokens.push_back(Token());
+  Token & token = tokens.back();
+  token.type = type;
+  token.end = tokens.size();
+  return token;
+}
+
+bool JsonParser::unexpected() {
+  if (position >= length) {
+    error = "Unexpected end of JSON input";
+    return false;
+  }
+
+  uint8_t lead = json[position];
+  size_t characterLength = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+  characterLength = std::min(characterLength, length - position);
+
+  error = "Unexpected token ";
+  error.append(json + position, characterLength);
+  error += " in JSON at position ";
+  error += std::to_string(position);
+  return false;
+}
+
+void JsonParser::skipWhitespace() {
+  while (position < length) {
+    switch (json[position]) {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        position++;
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+bool JsonParser::parse(std::string & errorMessage) {
+  skipWhitespace();
+  bool parsed = parseValue(0);
+  if (parsed) {
+    skipWhitespace();
+    if (position < length) {
+      parsed = unexpected();
+    }
+  }
+
+  if (!parsed) {
+    errorMessage = error;
+  }
+  return parsed;
+}
+
+bool JsonParser::parseValue(unsigned int depth) {
+  if (position >= length) {
+    return unexpected();
+  }
+
+  switch (json[position]) {
+    case '{':
+      return parseContainer(OBJECT_TOKEN, depth);
+    case '[':
+      return parseContainer(ARRAY_TOKEN, depth);
+    case '"':
+      return parseString();
+    case 't':
+      return parseLiteral("true", TRUE_TOKEN);
+    case 'f':
+      return parseLiteral("false", FALSE_TOKEN);
+    case 'n':
+      return parseLiteral("null", NULL_TOKEN);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return parseNumber();
+    default:
+      return unexpected();
+  }
+}
+
+bool JsonParser::parseContainer(Type type, unsigned int depth) {
+  if (depth >= maxDepth) {
+    error = "JSON is nested too deeply";
+    return false;
+  }
+
+  char close = (type == OBJECT_TOKEN) ? '}' : ']';
+  size_t index = tokens.size();
+  push(type);
+  position++;
+  skipWhitespace();
+
+  uint32_t count = 0;
+  if (position < length && json[position] == close) {
+    position++;
+  } else {
+    for (;;) {
+      if (type == OBJECT_TOKEN) {
+        if (position >= length || json[position] != '"') {
+          return unexpected();
+        }
+        if (!parseString()) {
+          return false;
+        }
+        skipWhitespace();
+        if (position >= length || json[position] != ':') {
+          return unexpected();
+        }
+        position++;
+        skipWhitespace();
+      }
+
+      if (!parseValue(depth + 1)) {
+        return false;
+      }
+      count++;
+
+      skipWhitespace();
+      if (position >= length) {
+        return unexpected();
+      }
+      if (json[position] == ',') {
+        position++;
+        skipWhitespace();
+      } else if (json[position] == close) {
+        position++;
+        break;
+      } else {
+        return unexpected();
+      }
+    }
+  }
+
+  tokens[index].count = count;
+  tokens[index].end = tokens.size();
+  return true;
+}
+
+bool JsonParser::parseString() {
+  position++;
+  size_t offset = strings.size();
+
+  for (;;) {
+    // Copy runs without quotes, escapes or control characters eight bytes at a time.
+    while (position + sizeof(uint64_t) <= length) {
+      uint64_t word;
+      memcpy(&word, json + position, sizeof(word));
+      if (hasByte(word, '"') | hasByte(word, '\\') | hasByteLessThan(word, 0x20)) {
+        break;
+      }
+      strings.append(json + position, sizeof(word));
+      position += sizeof(word);
+    }
+
+    if (position >= length) {
+      return unexpected();
+    }
+
+    char character = json[position];
+    if (character == '"') {
+      position++;
+      break;
+    }
+    if (static_cast<uint8_t>(character) < 0x20) {
+      return unexpected();
+    }
+    if (character != '\\') {
+      strings += character;
+      position++;
+      continue;
+    }
+
+    position++;
+    if (position >= length) {
+      return unexpected();
+    }
+
+    switch (json[position]) {
+      case '"':
+        strings += '"';
+        break;
+      case '\\':
+        strings += '\\';
+        break;
+      case '/':
+        strings += '/';
+        break;
+      case 'b':
+        strings += '\b';
+        break;
+      case 'f':
+        strings += '\f';
+        break;
+      case 'n':
+        strings += '\n';
+        break;
+      case 'r':
+        strings += '\r';
+        break;
+      case 't':
+        strings += '\t';
+        break;
+      case 'u': {
+        uint32_t codeUnit;
+        if (!parseHex4(codeUnit)) {
+          return false;
+        }
+
+        if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF &&
+            position + 1 < length && json[position] == '\\' && json[position + 1] == 'u') {
+          position++;
+          uint32_t lowSurrogate;
+          if (!parseHex4(lowSurrogate)) {
+            return false;
+          }
+          if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF) {
+            appendUtf8(strings, 0x10000 + ((codeUnit - 0xD800) << 10) + (lowSurrogate - 0xDC00));
+          } else {
+            appendUtf8(strings, codeUnit);
+            appendUtf8(strings, lowSurrogate);
+          }
+        } else {
+          appendUtf8(strings, codeUnit);
+        }
+        continue;
+      }
+      default:
+        return unexpected();
+    }
+    position++;
+  }
+
+  Token & token = push(STRING_TOKEN);
+  token.offset = offset;
+  token.length = strings.size() - offset;
+  return true;
+}
+
+// Reads the four hex digits after the 'u' at the current position and moves past them.
+bool JsonParser::parseHex4(uint32_t & codeUnit) {
+  codeUnit = 0;
+  for (int i = 0; i < 4; i++) {
+    position++;
+    if (position >= length) {
+      return unexpected();
+    }
+
+    char character = json[position];
+    uint32_t digit;
+    if (character >= '0' && character <= '9') {
+      digit = character - '0';
+    } else if (character >= 'a' && character <= 'f') {
+      digit = character - 'a' + 10;
+    } else if (character >= 'A' && character <= 'F') {
+      digit = character - 'A' + 10;
+    } else {
+      return unexpected();
+    }
+    codeUnit = (codeUnit * 16) + digit;
+  }
+  position++;
+  return true;
+}
+
+bool JsonParser::parseNumber() {
+  size_t start = position;
+  bool negative = false;
+  bool integral = true;
+
+  if (json[position] == '-') {
+    negative = true;
+    position++;
+  }
+
+  if (position >= length) {
+    return unexpected();
+  }
+  if (json[position] == '0') {
+    position++;
+  } else if (isDigit(json[position])) {
+    while (position < length && isDigit(json[position])) {
+      position++;
+    }
+  } else {
+    return unexpected();
+  }
+
+  if (position < length && json[position] == '.') {
+    integral = false;
+    position++;
+    if (position >= length || !isDigit(json[position])) {
+      return unexpected();
+    }
+    while (position < length && isDigit(json[position])) {
+      position++;
+    }
+  }
+
+  if (position < length && (json[position] == 'e' || json[position] == 'E')) {
+    integral = false;
+    position++;
+    if (position < length && (json[position] == '+' || json[position] == '-')) {
+      position++;
+    }
+    if (position >= length || !isDigit(json[position])) {
+      return unexpected();
+    }
+    while (position < length && isDigit(json[position])) {
+      position++;
+    }
+  }
+
+  size_t digitsStart = start + (negative ? 1 : 0);
+  size_t textLength = position - start;
+  double number;
+
+  if (integral && position - digitsStart <= 15) {
+    // Exact in a double, so there is no need for strtod.
+    int64_t value = 0;
+    for (size_t i = digitsStart; i < position; i++) {
+      value = (value * 10) + (json[i] - '0');
+    }
+    number = negative ? -static_cast<double>(value) : static_cast<double>(value);
+  } else {
+    // strtod needs a terminated copy, and must not see anything past the JSON number.
+    std::string text(json + start, textLength);
+    number = strtod(text.c_str(), NULL);
+  }
+
+  push(NUMBER_TOKEN).number = number;
+  return true;
+}
+
+bool JsonParser::parseLiteral(const char * literal, Type type) {
+  for (const char * character = literal; *character != '\0'; character++) {
+    if (position >= length || json[position] != *character) {
+      return unexpected();
+    }
+    position++;
+  }
+  push(type);
+  return true;
+}
+
+void JsonParser::members(size_t index, std::vector<std::string> & names, std::vector<size_t> & values) const {
+  const Token & object = tokens[index];
+  names.reserve(object.count);
+  values.reserve(object.count);
+
+  size_t i = index + 1;
+  while (i < object.end) {
+    const Token & name = tokens[i];
+    names.push_back(std::string(strings.data() + name.offset, name.length));
+    values.push_back(i + 1);
+    i = tokens[i + 1].end;
+  }
+}
+
+void JsonParser::stageToken(size_t index, StagingBuffer & stagingBuffer) const {
+  const Token & token = tokens[index];
+
+  switch (token.type) {
+    case NULL_TOKEN:
+      stagingBuffer.stageNull();
+      return;
+    case TRUE_TOKEN:
+      stagingBuffer.stageBoolean(true);
+      return;
+    case FALSE_TOKEN:
+      stagingBuffer.stageBoolean(false);
+      return;
+    case NUMBER_TOKEN:
+      stagingBuffer.stageNumber(token.number);
+      return;
+    case STRING_TOKEN:
+      stagingBuffer.stageUtf8String(strings.data() + token.offset, token.length);
+      return;
+    case ARRAY_TOKEN:
+      stagingBuffer.stageArrayStart(token.count);
+      for (size_t i = index + 1; i < token.end; i = tokens[i].end) {
+        stageToken(i, stagingBuffer);
+      }
+      return;
+    case OBJECT_TOKEN: {
+      std::vector<std::string> names;
+      std::vector<size_t> values;
+      members(index, names, values);
+
+      std::vector<size_t> order(propertyOrder(names));
+      std::string shapeKey;
+      for (size_t i = 0; i < order.size(); i++) {
+        std::string fieldName(pdxFieldName(names[order[i]]));
+        PdxTypeCache::appendToShapeKey(shapeKey, fieldName.data(), fieldName.length(),
+                                       tokens[values[order[i]]].type == ARRAY_TOKEN);
+      }
+
+      stagingBuffer.stageObjectStart(shapeKey);
+      for (size_t i = 0; i < order.size(); i++) {
+        stageToken(values[order[i]], stagingBuffer);
+      }
+      return;
+    }
+  }
+}
+
+bool JsonParser::stage(StagingBuffer & stagingBuffer, bool entries, std::string & errorMessage) {
+  if (!entries) {
+    stageToken(0, stagingBuffer);
+    return true;
+  }
+
+  if (tokens[0].type != OBJECT_TOKEN) {
+    errorMessage = "The JSON text must be an object.";
+    return false;
+  }
+
+  std::vector<std::string> names;
+  std::vector<size_t> values;
+  members(0, names, values);
+
+  std::vector<size_t> order(propertyOrder(names));
+  stagingBuffer.stageEntriesStart(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    const std::string & name(names[order[i]]);
+    stagingBuffer.stageUtf8String(name.data(), name.length());
+    stageToken(values[order[i]], stagingBuffer);
+  }
+  return true;
+}
+
+class JsonWriter {
+ public:
+  JsonWriter(Int64Mode int64Mode, bool openEnvelopes, std::string & json, std::string & error) :
+    int64Mode(int64Mode),
+    openEnvelopes(openEnvelopes),
+    json(json),
+    error(error) {}
+
+  // Returns false for undefined, which has no JSON form, or with error set if the value cannot
+  // be serialized.
+  bool write(const CacheablePtr & valuePtr);
+
+  template<typename T>
+  bool writeMap(const SharedPtr<T> & hashMapPtr) {
+    std::vector<std::string> names;
+    std::vector<CacheablePtr> values;
+    names.reserve(hashMapPtr->size());
+    values.reserve(hashMapPtr->size());
+
+    for (typename T::Iterator iterator = hashMapPtr->begin();
+         iterator != hashMapPtr->end();
+         iterator++) {
+      CacheablePtr keyPtr(iterator.first());
+      std::string name;
+      if (!propertyName(keyPtr, name)) {
+        return false;
+      }
+      names.push_back(name);
+      values.push_back(iterator.second());
+    }
+
+    return writeMembers(names, values);
+  }
+
+ private:
+  template<typename T>
+  bool writeArray(const SharedPtr<T> & iterablePtr) {
+    json += '[';
+    bool first = true;
+    for (typename T::Iterator iterator(iterablePtr->begin());
+         iterator != iterablePtr->end();
+         ++iterator) {
+      if (!first) {
+        json += ',';
+      }
+      first = false;
+
+      if (!write(*iterator)) {
+        if (!error.empty()) {
+          return false;
+        }
+        json += "null";
+      }
+    }
+    json += ']';
+    return true;
+  }
+
+  // JSON.stringify() writes typed arrays as objects keyed by index.
+  template<typename T>
+  void writeTypedArray(const SharedPtr<T> & arrayPtr) {
+    json += '{';
+    int32_t length = arrayPtr->length();
+    for (int32_t i = 0; i < length; i++) {
+      if (i > 0) {
+        json += ',';
+      }
+      json += '"';
+      json += std::to_string(i);
+      json += "\":";
+      writeNumber((*arrayPtr)[i]);
+    }
+    json += '}';
+  }
+
+  // The same for the unaligned elements of a MessagePack typed array extension.
+  template<typename T>
+  void writeTypedArray(const uint8_t * data, size_t byteLength) {
+    json += '{';
+    size_t length = byteLength / sizeof(T);
+    for (size_t i = 0; i < length; i++) {
+      if (i > 0) {
+        json += ',';
+      }
+      T element;
+      memcpy(&element, data + i * sizeof(T), sizeof(T));
+      json += '"';
+      json += std::to_string(i);
+      json += "\":";
+      writeNumber(element);
+    }
+    json += '}';
+  }
+
+  bool writeStored(const CacheablePtr & valuePtr);
+  bool writeMembers(const std::vector<std::string> & names, const std::vector<CacheablePtr> & values);
+  bool writeMessagePack(MessagePackReader & reader, unsigned int depth = 0);
+  bool writeMessagePackItem(MessagePackReader & reader, const MessagePackReader::Item & item,
+                            unsigned int depth);
+  bool writeExtension(const MessagePackReader::Item & item);
+  void writeBuffer(const uint8_t * bytes, size_t length);
+  bool propertyName(const CacheablePtr & keyPtr, std::string & name);
+  void writeString(const char * utf8, size_t length);
+  void writeString(const wchar_t * utf16, size_t length);
+  void writeEscaped(uint32_t codeUnit);
+  void writeNumber(double value);
+  void writeInt64(int64_t value);
+  void writeDate(int64_t milliseconds);
+
+  Int64Mode int64Mode;
+  bool openEnvelopes;
+  std::vector<uint8_t> decompressed;
+  std::string & json;
+  std::string & error;
+};
+
+// Encoded values are written straight from their MessagePack, without Cacheables in between.
+bool JsonWriter::writeStored(const CacheablePtr & valuePtr) {
+  const uint8_t * messagePack = NULL;
+  size_t messagePackLength = 0;
+  CacheablePtr openedPtr;
+  if (!openEnvelope(valuePtr, decompressed, messagePack, messagePackLength, openedPtr)) {
+    return write(valuePtr);
+  }
+  if (messagePack == NULL) {
+    return write(openedPtr);
+  }
+
+  MessagePackReader reader(messagePack, messagePackLength);
+  bool defined = writeMessagePack(reader);
+  if (error.empty() && !reader.atEnd()) {
+    throw IllegalStateException("Corrupt MessagePack value.");
+  }
+  return defined;
+}
+
+bool JsonWriter::write(const CacheablePtr & valuePtr) {
+  if (valuePtr == NULLPTR) {
+    json += "null";
+    return true;
+  }
+
+  // Only stored values are envelopes; what they hold, and the fields of other values, are not.
+  if (openEnvelopes) {
+    openEnvelopes = false;
+    try {
+      bool defined = writeStored(valuePtr);
+      openEnvelopes = true;
+      return defined;
+    } catch (...) {
+      openEnvelopes = true;
+      throw;
+    }
+  }
+
+  int typeId = valuePtr->typeId();
+  switch (typeId) {
+    case GeodeTypeIds::CacheableASCIIString:
+    case GeodeTypeIds::CacheableASCIIStringHuge:
+    case GeodeTypeIds::CacheableString:
+    case GeodeTypeIds::CacheableStringHuge: {
+      CacheableStringPtr stringPtr(static_cast<CacheableStringPtr>(valuePtr));
+      if (stringPtr->isWideString()) {
+        writeString(stringPtr->asWChar(), stringPtr->length());
+      } else {
+        writeString(stringPtr->asChar(), stringPtr->length());
+      }
+      return true;
+    }
+    case GeodeTypeIds::CacheableBoolean:
+      json += static_cast<CacheableBooleanPtr>(valuePtr)->value() ? "true" : "false";
+      return true;
+    case GeodeTypeIds::CacheableDouble:
+      writeNumber(static_cast<CacheableDoublePtr>(valuePtr)->value());
+      return true;
+    case GeodeTypeIds::CacheableFloat:
+      writeNumber(static_cast<CacheableFloatPtr>(valuePtr)->value());
+      return true;
+    case GeodeTypeIds::CacheableInt16:
+      writeNumber(static_cast<CacheableInt16Ptr>(valuePtr)->value());
+      return true;
+    case GeodeTypeIds::CacheableInt32:
+      writeNumber(static_cast<CacheableInt32Ptr>(valuePtr)->value());
+      return true;
+    case GeodeTypeIds::CacheableInt64:
+      writeInt64(static_cast<CacheableInt64Ptr>(valuePtr)->value());
+      return true;
+    case GeodeTypeIds::CacheableDate:
+      writeDate(static_cast<CacheableDatePtr>(valuePtr)->milliseconds());
+      return true;
+    case GeodeTypeIds::CacheableUndefined:
+      return false;
+    case GeodeTypeIds::CacheableBytes: {
+      CacheableBytesPtr bytesPtr(static_cast<CacheableBytesPtr>(valuePtr));
+      writeBuffer(bytesPtr->value(), bytesPtr->length());
+      return true;
+    }
+    case GeodeTypeIds::CacheableInt16Array:
+      writeTypedArray(static_cast<CacheableInt16ArrayPtr>(valuePtr));
+      return true;
+    case GeodeTypeIds::CacheableInt32Array:
+      writeTypedArray(static_cast<CacheableInt32ArrayPtr>(valuePtr));
+      return true;
+    case GeodeTypeIds::CacheableFloatArray:
+      writeTypedArray(static_cast<CacheableFloatArrayPtr>(valuePtr));
+      return true;
+    case GeodeTypeIds::CacheableDoubleArray:
+      writeTypedArray(static_cast<CacheableDoubleArrayPtr>(valuePtr));
+      return true;
+    case GeodeTypeIds::CacheableInt64Array: {
+      CacheableInt64ArrayPtr int64ArrayPtr(static_cast<CacheableInt64ArrayPtr>(valuePtr));
+      json += '[';
+      int32_t length = int64ArrayPtr->length();
+      for (int32_t i = 0; i < length; i++) {
+        if (i > 0) {
+          json += ',';
+        }
+        writeInt64((*int64ArrayPtr)[i]);
+      }
+      json += ']';
+      return true;
+    }
+    case GeodeTypeIds::Struct: {
+      StructPtr structPtr(static_cast<StructPtr>(valuePtr));
+      int32_t length = structPtr->length();
+      std::vector<std::string> names;
+      std::vector<CacheablePtr> values;
+      for (int32_t i = 0; i < length; i++) {
+        names.push_back(structPtr->getFieldName(i));
+        values.push_back((*structPtr)[i]);
+      }
+      return writeMembers(names, values);
+    }
+    case GeodeTypeIds::CacheableObjectArray:
+      return writeArray(static_cast<CacheableObjectArrayPtr>(valuePtr));
+    case GeodeTypeIds::CacheableArrayList:
+      return writeArray(static_cast<CacheableArrayListPtr>(valuePtr));
+    case GeodeTypeIds::CacheableVector:
+      return writeArray(static_cast<CacheableVectorPtr>(valuePtr));
+    case GeodeTypeIds::CacheableHashSet:
+      return writeArray(static_cast<CacheableHashSetPtr>(valuePtr));
+    case GeodeTypeIds::CacheableHashMap:
+      return writeMap(static_cast<CacheableHashMapPtr>(valuePtr));
+  }
+
+  PdxInstance * pdxInstance = dynamic_cast<PdxInstance *>(valuePtr.ptr());
+  if (pdxInstance != NULL) {
+    PdxInstancePtr pdxInstancePtr(pdxInstance);
+    CacheableStringArrayPtr gemfireKeys(pdxInstancePtr->getFieldNames());
+    int length = gemfireKeys == NULLPTR ? 0 : gemfireKeys->length();
+
+    std::vector<std::string> names;
+    std::vector<CacheablePtr> values;
+    names.reserve(length);
+    values.reserve(length);
+    for (int i = 0; i < length; i++) {
+      const char * key = gemfireKeys[i]->asChar();
+      names.push_back(key);
+      values.push_back(getPdxField(pdxInstancePtr, key));
+    }
+    return writeMembers(names, values);
+  }
+
+  error = "Unable to serialize value from GemFire to JSON; unknown typeId: ";
+  error += std::to_string(typeId);
+  return false;
+}
+
+bool JsonWriter::writeMembers(const std::vector<std::string> & names,
+                              const std::vector<CacheablePtr> & values) {
+  std::vector<size_t> order(propertyOrder(names));
+
+  json += '{';
+  bool first = true;
+  for (size_t i = 0; i < order.size(); i++) {
+    const CacheablePtr & valuePtr(values[order[i]]);
+    if (valuePtr != NULLPTR && valuePtr->typeId() == GeodeTypeIds::CacheableUndefined) {
+      continue;
+    }
+
+    size_t memberStart = json.length();
+    if (!first) {
+      json += ',';
+    }
+
+    const std::string & name(names[order[i]]);
+    writeString(name.data(), name.length());
+    json += ':';
+    if (!write(valuePtr)) {
+      if (!error.empty()) {
+        return false;
+      }
+      // An encoded undefined, which is only found out by decoding it.
+      json.resize(memberStart);
+      continue;
+    }
+    first = false;
+  }
+  json += '}';
+  return true;
+}
+
+bool JsonWriter::writeMessagePack(MessagePackReader & reader, unsigned int depth) {
+  MessagePackReader::Item item;
+  reader.read(item);
+  return writeMessagePackItem(reader, item, depth);
+}
+
+bool JsonWriter::writeMessagePackItem(MessagePackReader & reader, const MessagePackReader::Item & item,
+                                      unsigned int depth) {
+  if ((item.type == MessagePackReader::ARRAY || item.type == MessagePackReader::MAP) &&
+      depth >= MessagePackReader::maxDepth) {
+    error = "Unable to serialize value from GemFire to JSON; the value is nested too deeply.";
+    return false;
+  }
+
+  switch (item.type) {
+    case MessagePackReader::NIL:
+      json += "null";
+      return true;
+    case MessagePackReader::BOOLEAN:
+      json += item.boolean ? "true" : "false";
+      return true;
+    case MessagePackReader::INTEGER:
+      writeNumber(static_cast<double>(item.integer));
+      return true;
+    case MessagePackReader::INT64:
+      writeInt64(item.integer);
+      return true;
+    case MessagePackReader::DOUBLE:
+      writeNumber(item.number);
+      return true;
+    case MessagePackReader::STRING:
+      writeString(reinterpret_cast<const char *>(item.data), item.length);
+      return true;
+    case MessagePackReader::BINARY:
+      writeBuffer(item.data, item.length);
+      return true;
+    case MessagePackReader::ARRAY:
+      json += '[';
+      for (uint32_t i = 0; i < item.length; i++) {
+        if (i > 0) {
+          json += ',';
+        }
+        if (!writeMessagePack(reader, depth + 1)) {
+          if (!error.empty()) {
+            return false;
+          }
+          json += "null";
+        }
+      }
+      json += ']';
+      return true;
+    case MessagePackReader::MAP: {
+      // The encoder wrote the members in property order already.
+      json += '{';
+      bool first = true;
+      for (uint32_t i = 0; i < item.length; i++) {
+        MessagePackReader::Item key;
+        MessagePackReader::Item value;
+        reader.read(key);
+        reader.read(value);
+        if (key.type != MessagePackReader::STRING) {
+          error = "Unable to serialize value from GemFire to JSON; MessagePack map keys must be strings.";
+          return false;
+        }
+        if (value.type == MessagePackReader::EXTENSION && value.extensionType == UNDEFINED_EXTENSION) {
+          continue;
+        }
+
+        if (!first) {
+          json += ',';
+        }
+        first = false;
+
+        writeString(reinterpret_cast<const char *>(key.data), key.length);
+        json += ':';
+        if (!writeMessagePackItem(reader, value, depth + 1)) {
+          return false;
+        }
+      }
+      json += '}';
+      return true;
+    }
+    case MessagePackReader::EXTENSION:
+      return writeExtension(item);
+  }
+
+  throw IllegalStateException("Corrupt MessagePack value.");
+}
+
+bool JsonWriter::writeExtension(const MessagePackReader::Item & item) {
+  switch (item.extensionType) {
+    case TIMESTAMP_EXTENSION:
+      writeDate(static_cast<int64_t>(MessagePackReader::timestamp(item)));
+      return true;
+    case UNDEFINED_EXTENSION:
+      return false;
+    case INT16_ARRAY_EXTENSION:
+      writeTypedArray<int16_t>(item.data, item.length);
+      return true;
+    case INT32_ARRAY_EXTENSION:
+      writeTypedArray<int32_t>(item.data, item.length);
+      return true;
+    case FLOAT_ARRAY_EXTENSION:
+      writeTypedArray<float>(item.data, item.length);
+      return true;
+    case DOUBLE_ARRAY_EXTENSION:
+      writeTypedArray<double>(item.data, item.length);
+      return true;
+    case INT64_ARRAY_EXTENSION: {
+      json += '[';
+      size_t length = item.length / sizeof(int64_t);
+      for (size_t i = 0; i < length; i++) {
+        if (i > 0) {
+          json += ',';
+        }
+        int64_t element;
+        memcpy(&element, item.data + i * sizeof(int64_t), sizeof(int64_t));
+        writeInt64(element);
+      }
+      json += ']';
+      return true;
+    }
+  }
+
+  error = "Unable to serialize value from GemFire to JSON; unsupported MessagePack extension type: ";
+  error += std::to_string(item.extensionType);
+  return false;
+}
+
+void JsonWriter::writeBuffer(const uint8_t * bytes, size_t length) {
+  json += "{\"type\":\"Buffer\",\"data\":[";
+  for (size_t i = 0; i < length; i++) {
+    if (i > 0) {
+      json += ',';
+    }
+    json += std::to_string(bytes[i]);
+  }
+  json += "]}";
+}
+
+// The name a key gets as a property of the object that getAll() and v8Value() build.
+bool JsonWriter::propertyName(const CacheablePtr & keyPtr, std::string & name) {
+  if (keyPtr == NULLPTR) {
+    name = "null";
+    return true;
+  }
+
+  std::string json;
+  JsonWriter keyWriter(int64Mode, false, json, error);
+
+  switch (keyPtr->typeId()) {
+    case GeodeTypeIds::CacheableASCIIString:
+    case GeodeTypeIds::CacheableASCIIStringHuge:
+    case GeodeTypeIds::CacheableString:
+    case GeodeTypeIds::CacheableStringHuge: {
+      CacheableStringPtr stringPtr(static_cast<CacheableStringPtr>(keyPtr));
+      if (!stringPtr->isWideString()) {
+        name.assign(stringPtr->asChar(), stringPtr->length());
+        return true;
+      }
+      const wchar_t * utf16 = stringPtr->asWChar();
+      int32_t length = stringPtr->length();
+      for (int32_t i = 0; i < length; i++) {
+        uint32_t codeUnit = utf16[i];
+        if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF && i + 1 < length &&
+            utf16[i + 1] >= 0xDC00 && utf16[i + 1] <= 0xDFFF) {
+          codeUnit = 0x10000 + ((codeUnit - 0xD800) << 10) + (utf16[i + 1] - 0xDC00);
+          i++;
+        }
+        appendUtf8(name, codeUnit);
+      }
+      return true;
+    }
+    case GeodeTypeIds::CacheableBoolean:
+    case GeodeTypeIds::CacheableDouble:
+    case GeodeTypeIds::CacheableFloat:
+    case GeodeTypeIds::CacheableInt16:
+    case GeodeTypeIds::CacheableInt32:
+    case GeodeTypeIds::CacheableInt64:
+      keyWriter.write(keyPtr);
+      name = json;
+      return true;
+  }
+
+  error = "Unable to serialize key from GemFire to JSON; unsupported typeId: ";
+  error += std::to_string(keyPtr->typeId());
+  return false;
+}
+
+void JsonWriter::writeEscaped(uint32_t codeUnit) {
+  static const char hexDigits[] = "0123456789abcdef";
+  json += "\\u";
+  json += hexDigits[(codeUnit >> 12) & 0xF];
+  json += hexDigits[(codeUnit >> 8) & 0xF];
+  json += hexDigits[(codeUnit >> 4) & 0xF];
+  json += hexDigits[codeUnit & 0xF];
+}
+
+void JsonWriter::writeString(const char * utf8, size_t length) {
+  json += '"';
+
+  size_t i = 0;
+  while (i < length) {
+    // Copy runs that need no escaping, including multibyte UTF-8, eight bytes at a time.
+    while (i + sizeof(uint64_t) <= length) {
+      uint64_t word;
+      memcpy(&word, utf8 + i, sizeof(word));
+      if (hasByte(word, '"') | hasByte(word, '\\') | hasByteLessThan(word, 0x20) | hasByte(word, 0xED)) {
+        break;
+      }
+      json.append(utf8 + i, sizeof(word));
+      i += sizeof(word);
+    }
+    if (i >= length) {
+      break;
+    }
+
+    uint8_t character = utf8[i];
+    switch (character) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      case '\b':
+        json += "\\b";
+        break;
+      case '\f':
+        json += "\\f";
+        break;
+      case '\n':
+        json += "\\n";
+        break;
+      case '\r':
+        json += "\\r";
+        break;
+      case '\t':
+        json += "\\t";
+        break;
+      default:
+        if (character < 0x20) {
+          writeEscaped(character);
+        } else if (character == 0xED && i + 2 < length && static_cast<uint8_t>(utf8[i + 1]) >= 0xA0) {
+          // A lone surrogate, which JSON.stringify() escapes.
+          writeEscaped(0xD000 | ((utf8[i + 1] & 0x3F) << 6) | (utf8[i + 2] & 0x3F));
+          i += 2;
+        } else {
+          json += static_cast<char>(character);
+        }
+    }
+    i++;
+  }
+
+  json += '"';
+}
+
+void JsonWriter::writeString(const wchar_t * utf16, size_t length) {
+  json += '"';
+
+  for (size_t i = 0; i < length; i++) {
+    uint32_t codeUnit = utf16[i];
+    switch (codeUnit) {
+      case '"':
+        json += "\\\"";
+        continue;
+      case '\\':
+        json += "\\\\";
+        continue;
+      case '\b':
+        json += "\\b";
+        continue;
+      case '\f':
+        json += "\\f";
+        continue;
+      case '\n':
+        json += "\\n";
+        continue;
+      case '\r':
+        json += "\\r";
+        continue;
+      case '\t':
+        json += "\\t";
+        continue;
+    }
+
+    if (codeUnit < 0x20) {
+      writeEscaped(codeUnit);
+    } else if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF && i + 1 < length &&
+               static_cast<uint32_t>(utf16[i + 1]) >= 0xDC00 &&
+               static_cast<uint32_t>(utf16[i + 1]) <= 0xDFFF) {
+      appendUtf8(json, 0x10000 + ((codeUnit - 0xD800) << 10) + (utf16[i + 1] - 0xDC00));
+      i++;
+    } else if (codeUnit >= 0xD800 && codeUnit <= 0xDFFF) {
+      writeEscaped(codeUnit);
+    } else {
+      appendUtf8(json, codeUnit);
+    }
+  }
+
+  json += '"';
+}
+
+// Formats a number the way Number.prototype.toString() does: the shortest digits that round trip,
+// in positional notation from 1e-7 up to 1e21 and in exponential notation outside that range.
+void JsonWriter::writeNumber(double value) {
+  if (std::isnan(value) || std::isinf(value)) {
+    json += "null";
+    return;
+  }
+  if (value == 0) {
+    json += '0';
+    return;
+  }
+  if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0) {
+    json += std::to_string(static_cast<int64_t>(value));
+    return;
+  }
+
+  char buffer[32];
+  for (int precision = 1; precision <= 17; precision++) {
+    snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, value);
+    if (strtod(buffer, NULL) == value) {
+      break;
+    }
+  }
+
+  // buffer is now [-]d[.ddd]e[+-]xx
+  const char * character = buffer;
+  if (*character == '-') {
+    json += '-';
+    character++;
+  }
+
+  std::string digits;
+  while (*character != 'e') {
+    if (*character != '.') {
+      digits += *character;
+    }
+    character++;
+  }
+  int exponent = atoi(character + 1);
+  while (digits.length() > 1 && digits[digits.length() - 1] == '0') {
+    digits.erase(digits.length() - 1);
+  }
+
+  int k = digits.length();
+  int n = exponent + 1;
+
+  if (k <= n && n <= 21) {
+    json += digits;
+    json.append(n - k, '0');
+  } else if (0 < n && n <= 21) {
+    json.append(digits, 0, n);
+    json += '.';
+    json.append(digits, n, std::string::npos);
+  } else if (-6 < n && n <= 0) {
+    json += "0.";
+    json.append(-n, '0');
+    json += digits;
+  } else {
+    json += digits[0];
+    if (k > 1) {
+      json += '.';
+      json.append(digits, 1, std::string::npos);
+    }
+    json += 'e';
+    json += (n - 1 < 0) ? '-' : '+';
+    json += std::to_string(std::abs(n - 1));
+  }
+}
+
+// JSON has no BigInt, so when longs are read as BigInts their exact digits are written instead.
+void JsonWriter::writeInt64(int64_t value) {
+  if (int64Mode == INT64_AS_NUMBER) {
+    writeNumber(static_cast<double>(value));
+  } else {
+    json += std::to_string(value);
+  }
+}
+
+// Formats a date the way Date.prototype.toJSON() does.
+void JsonWriter::writeDate(int64_t milliseconds) {
+  static const int64_t maxMilliseconds = 8640000000000000LL;
+  static const int64_t millisecondsPerDay = 86400000LL;
+
+  if (milliseconds > maxMilliseconds || milliseconds < -maxMilliseconds) {
+    json += "null";
+    return;
+  }
+
+  int64_t days = milliseconds / millisecondsPerDay;
+  int64_t millisecondOfDay = milliseconds % millisecondsPerDay;
+  if (millisecondOfDay < 0) {
+    millisecondOfDay += millisecondsPerDay;
+    days--;
+  }
+
+  // Civil date from days since the epoch, after Howard Hinnant's days_from_civil algorithms.
+  int64_t z = days + 719468;
+  int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  int64_t dayOfEra = z - era * 146097;
+  int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  int64_t year = yearOfEra + era * 400;
+  int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+  int64_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+  int64_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+  if (month <= 2) {
+    year++;
+  }
+
+  char buffer[48];
+  char yearBuffer[16];
+  if (year >= 0 && year <= 9999) {
+    snprintf(yearBuffer, sizeof(yearBuffer), "%04lld", static_cast<long long>(year));
+  } else {
+    snprintf(yearBuffer, sizeof(yearBuffer), "%c%06lld", year < 0 ? '-' : '+',
+             static_cast<long long>(year < 0 ? -year : year));
+  }
+  snprintf(buffer, sizeof(buffer), "\"%s-%02d-%02dT%02d:%02d:%02d.%03dZ\"",
+           yearBuffer,
+           static_cast<int>(month),
+           static_cast<int>(day),
+           static_cast<int>(millisecondOfDay / 3600000),
+           static_cast<int>((millisecondOfDay / 60000) % 60),
+           static_cast<int>((millisecondOfDay / 1000) % 60),
+           static_cast<int>(millisecondOfDay % 1000));
+  json += buffer;
+}
+
+}  // namespace
+
+bool stageJson(const char * json, size_t length, StagingBuffer & stagingBuffer,
+               std::string & errorMessage, bool entries) {
+  JsonParser parser(json, length);
+  return parser.parse(errorMessage) && parser.stage(stagingBuffer, entries, errorMessage);
+}
+
+bool writeJson(const CacheablePtr & valuePtr, Int64Mode int64Mode, const ValueCodecOptions & codecOptions,
+               std::string & json, std::string & errorMessage) {
+  JsonWriter writer(int64Mode, codecOptions.usesEnvelopes(), json, errorMessage);
+  return writer.write(valuePtr);
+}
+
+bool writeJson(const HashMapOfCacheablePtr & hashMapPtr, Int64Mode int64Mode,
+               const ValueCodecOptions & codecOptions, std::string & json, std::string & errorMessage) {
+  JsonWriter writer(int64Mode, codecOptions.usesEnvelopes(), json, errorMessage);
+  return writer.writeMap(hashMapPtr);
+}
+
+}  // namespace node_gemfire
@@ -0,0 +1,29 @@
+#ifndef __JSON_HPP__
+#define __JSON_HPP__
+
+#include <geode/GeodeCppCache.hpp>
+#include <string>
+#include "conversions.hpp"
+#include "staging_buffer.hpp"
+#include "value_codec.hpp"
+
+namespace node_gemfire {
+
+// Parses JSON text into a StagingBuffer without going through V8. Objects get the same PDX types as
+// JSON.parse() followed by a put() would give them. With entries set the text must be an object,
+// whose members are staged as putAll() entries. Safe to call on worker threads.
+bool stageJson(const char * json, size_t length, StagingBuffer & stagingBuffer,
+               std::string & errorMessage, bool entries = false);
+
+// Serializes a GemFire value the way JSON.stringify(region.get()) would. Returns false with an
+// empty errorMessage if the value has no JSON representation (undefined). Safe to call on worker
+// threads; int64Mode should be read from conversionOptions(), and codecOptions from the region's
+// ValueCodecRegistry entry, on the JavaScript thread.
+bool writeJson(const apache::geode::client::CacheablePtr & valuePtr, Int64Mode int64Mode,
+               const ValueCodecOptions & codecOptions, std::string & json, std::string & errorMessage);
+bool writeJson(const apache::geode::client::HashMapOfCacheablePtr & hashMapPtr, Int64Mode int64Mode,
+               const ValueCodecOptions & codecOptions, std::string & json, std::string & errorMessage);
+
+}  // namespace node_gemfire
+
+#endif
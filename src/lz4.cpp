@@ -0,0 +1,177 @@
+#include "lz4.hpp"
+#include <cstring>
+#include <vector>
+
+namespace node_gemfire {
+
+namespace {
+
+const size_t minMatch = 4;
+// The last five bytes are always literals, and the last match starts at least twelve bytes before
+// the end of the block.
+const size_t lastLiterals = 5;
+const size_t matchFindLimit = 12;
+const size_t maxOffset = 65535;
+const unsigned int hashLog = 14;
+
+inline uint32_t read32(const uint8_t * data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - hashLog);
+}
+
+void writeLength(std::vector<uint8_t> & output, size_t length) {
+  while (length >= 255) {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<uint8_t>(length));
+}
+
+// A token, the literals, and unless this is the last sequence, the offset and match length.
+void writeSequence(std::vector<uint8_t> & output, const uint8_t * literals, size_t literalLength,
+                   size_t offset, size_t matchLength) {
+  size_t matchCode = matchLength >= minMatch ? matchLength - minMatch : 0;
+  uint8_t token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                       (matchCode < 15 ? matchCode : 15));
+  output.push_back(token);
+  if (literalLength >= 15) {
+    writeLength(output, literalLength - 15);
+  }
+  output.insert(output.end(), literals, literals + literalLength);
+
+  if (matchLength == 0) {
+    return;
+  }
+
+  output.push_back(static_cast<uint8_t>(offset));
+  output.push_back(static_cast<uint8_t>(offset >> 8));
+  if (matchCode >= 15) {
+    writeLength(output, matchCode - 15);
+  }
+}
+
+}  // namespace
+
+size_t lz4CompressBound(size_t length) {
+  return length + length / 255 + 16;
+}
+
+void lz4Compress(const uint8_t * input, size_t length, std::vector<uint8_t> & output) {
+  output.reserve(output.size() + lz4CompressBound(length));
+
+  size_t anchor = 0;
+  if (length > matchFindLimit) {
+    // Positions of the last sequence seen per hash. Stale entries are harmless: every candidate is
+    // checked against the input before it is used.
+    static thread_local std::vector<uint32_t> table;
+    table.assign(1 << hashLog, 0);
+
+    size_t matchLimit = length - lastLiterals;
+    size_t position = 1;
+    table[hashSequence(read32(input))] = 0;
+
+    while (position + matchFindLimit <= length) {
+      uint32_t sequence = read32(input + position);
+      uint32_t hash = hashSequence(sequence);
+      size_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(position);
+
+      if (position - candidate > maxOffset || read32(input + candidate) != sequence) {
+        // Skip ahead faster through data that does not compress.
+        position += 1 + ((position - anchor) >> 6);
+        continue;
+      }
+
+      // Extend the match backwards over pending literals, then forwards.
+      while (position > anchor && candidate > 0 && input[position - 1] == input[candidate - 1]) {
+        position--;
+        candidate--;
+      }
+      size_t matchLength = minMatch;
+      while (position + matchLength < matchLimit &&
+             input[candidate + matchLength] == input[position + matchLength]) {
+        matchLength++;
+      }
+
+      writeSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+      position += matchLength;
+      anchor = position;
+    }
+  }
+
+  writeSequence(output, input + anchor, length - anchor, 0, 0);
+}
+
+bool lz4Decompress(const uint8_t * input, size_t length, uint8_t * output, size_t outputLength) {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < length) {
+    uint8_t token = input[in++];
+
+    size_t literalLength = token >> 4;
+    if (literalLength == 15) {
+      uint8_t extra;
+      do {
+        if (in >= length) {
+          return false;
+        }
+        extra = input[in++];
+        literalLength += extra;
+      } while (extra == 255);
+    }
+    if (literalLength > length - in || literalLength > outputLength - out) {
+      return false;
+    }
+    if (literalLength > 0) {
+      memcpy(output + out, input + in, literalLength);
+    }
+    in += literalLength;
+    out += literalLength;
+
+    if (in == length) {
+      break;
+    }
+
+    if (length - in < 2) {
+      return false;
+    }
+    size_t offset = input[in] | (input[in + 1] << 8);
+    in += 2;
+    if (offset == 0 || offset > out) {
+      return false;
+    }
+
+    size_t matchLength = token & 0x0f;
+    if (matchLength == 15) {
+      uint8_t extra;
+      do {
+        if (in >= length) {
+          return false;
+        }
+        extra = input[in++];
+        matchLength += extra;
+      } while (extra == 255);
+    }
+    matchLength += minMatch;
+    if (matchLength > outputLength - out) {
+      return false;
+    }
+
+    // Matches may overlap the bytes they produce, so they are copied a byte at a time.
+    const uint8_t * match = output + out - offset;
+    for (size_t i = 0; i < matchLength; i++) {
+      output[out + i] = match[i];
+    }
+    out += matchLength;
+  }
+
+  return out == outputLength;
+}
+
+}  // namespace node_gemfire
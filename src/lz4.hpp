@@ -0,0 +1,22 @@
+#ifndef __LZ4_HPP__
+#define __LZ4_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace node_gemfire {
+
+// The LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), with a
+// single-pass greedy compressor like LZ4's fast mode. Blocks are readable by any LZ4 decoder.
+size_t lz4CompressBound(size_t length);
+
+// Appends the compressed block to output.
+void lz4Compress(const uint8_t * input, size_t length, std::vector<uint8_t> & output);
+
+// Returns false unless the block decompresses to exactly outputLength bytes.
+bool lz4Decompress(const uint8_t * input, size_t length, uint8_t * output, size_t outputLength);
+
+}  // namespace node_gemfire
+
+#endif
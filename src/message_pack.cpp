@@ -0,0 +1,361 @@
+#include "message_pack.hpp"
+#include <geode/GeodeCppCache.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+template<typename T>
+void MessagePackWriter::writeBigEndian(T value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(T));
+
+  size_t offset = output.size();
+  output.resize(offset + sizeof(T));
+  for (size_t i = 0; i < sizeof(T); i++) {
+    output[offset + sizeof(T) - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+}
+
+template<typename T>
+void MessagePackWriter::writeBigEndian(uint8_t marker, T value) {
+  output.push_back(marker);
+  writeBigEndian<T>(value);
+}
+
+void MessagePackWriter::writeNil() {
+  output.push_back(0xc0);
+}
+
+void MessagePackWriter::writeBoolean(bool value) {
+  output.push_back(value ? 0xc3 : 0xc2);
+}
+
+void MessagePackWriter::writeInteger(int32_t value) {
+  if (value >= -32 && value <= 0x7f) {
+    output.push_back(static_cast<uint8_t>(value));
+  } else if (value > 0) {
+    if (value <= 0xff) {
+      writeBigEndian<uint8_t>(0xcc, value);
+    } else if (value <= 0xffff) {
+      writeBigEndian<uint16_t>(0xcd, value);
+    } else {
+      writeBigEndian<uint32_t>(0xce, value);
+    }
+  } else if (value >= INT8_MIN) {
+    writeBigEndian<int8_t>(0xd0, value);
+  } else if (value >= INT16_MIN) {
+    writeBigEndian<int16_t>(0xd1, value);
+  } else {
+    writeBigEndian<int32_t>(0xd2, value);
+  }
+}
+
+void MessagePackWriter::writeInt64(int64_t value) {
+  writeBigEndian<int64_t>(0xd3, value);
+}
+
+void MessagePackWriter::writeDouble(double value) {
+  writeBigEndian<double>(0xcb, value);
+}
+
+// Uses the 32, 64 or 96 bit form of the standard timestamp extension, whichever fits. An invalid
+// Date has no timestamp and is written as nil, which is what JSON.stringify() makes of it.
+void MessagePackWriter::writeDate(double millisecondsSinceEpoch) {
+  if (std::isnan(millisecondsSinceEpoch)) {
+    writeNil();
+    return;
+  }
+
+  double seconds = std::floor(millisecondsSinceEpoch / 1000);
+  uint32_t nanoseconds = static_cast<uint32_t>((millisecondsSinceEpoch - seconds * 1000) * 1000000);
+
+  if (seconds >= 0 && seconds < 17179869184.0) {
+    uint64_t secondsBits = static_cast<uint64_t>(seconds);
+    if (nanoseconds == 0 && secondsBits <= 0xffffffff) {
+      writeExtensionHeader(TIMESTAMP_EXTENSION, 4);
+      writeBigEndian<uint32_t>(static_cast<uint32_t>(secondsBits));
+    } else {
+      writeExtensionHeader(TIMESTAMP_EXTENSION, 8);
+      writeBigEndian<uint64_t>((static_cast<uint64_t>(nanoseconds) << 34) | secondsBits);
+    }
+    return;
+  }
+
+  writeExtensionHeader(TIMESTAMP_EXTENSION, 12);
+  writeBigEndian<uint32_t>(nanoseconds);
+  writeBigEndian<int64_t>(static_cast<int64_t>(seconds));
+}
+
+void MessagePackWriter::writeStringHeader(uint32_t byteLength) {
+  if (byteLength < 32) {
+    output.push_back(static_cast<uint8_t>(0xa0 | byteLength));
+  } else if (byteLength <= 0xff) {
+    writeBigEndian<uint8_t>(0xd9, byteLength);
+  } else if (byteLength <= 0xffff) {
+    writeBigEndian<uint16_t>(0xda, byteLength);
+  } else {
+    writeBigEndian<uint32_t>(0xdb, byteLength);
+  }
+}
+
+void MessagePackWriter::writeBinaryHeader(uint32_t byteLength) {
+  if (byteLength <= 0xff) {
+    writeBigEndian<uint8_t>(0xc4, byteLength);
+  } else if (byteLength <= 0xffff) {
+    writeBigEndian<uint16_t>(0xc5, byteLength);
+  } else {
+    writeBigEndian<uint32_t>(0xc6, byteLength);
+  }
+}
+
+void MessagePackWriter::writeArrayHeader(uint32_t length) {
+  if (length < 16) {
+    output.push_back(static_cast<uint8_t>(0x90 | length));
+  } else if (length <= 0xffff) {
+    writeBigEndian<uint16_t>(0xdc, length);
+  } else {
+    writeBigEndian<uint32_t>(0xdd, length);
+  }
+}
+
+void MessagePackWriter::writeMapHeader(uint32_t length) {
+  if (length < 16) {
+    output.push_back(static_cast<uint8_t>(0x80 | length));
+  } else if (length <= 0xffff) {
+    writeBigEndian<uint16_t>(0xde, length);
+  } else {
+    writeBigEndian<uint32_t>(0xdf, length);
+  }
+}
+
+void MessagePackWriter::writeExtensionHeader(int8_t type, uint32_t byteLength) {
+  switch (byteLength) {
+    case 1:
+      output.push_back(0xd4);
+      break;
+    case 2:
+      output.push_back(0xd5);
+      break;
+    case 4:
+      output.push_back(0xd6);
+      break;
+    case 8:
+      output.push_back(0xd7);
+      break;
+    case 16:
+      output.push_back(0xd8);
+      break;
+    default:
+      if (byteLength <= 0xff) {
+        writeBigEndian<uint8_t>(0xc7, byteLength);
+      } else if (byteLength <= 0xffff) {
+        writeBigEndian<uint16_t>(0xc8, byteLength);
+      } else {
+        writeBigEndian<uint32_t>(0xc9, byteLength);
+      }
+  }
+  output.push_back(static_cast<uint8_t>(type));
+}
+
+void MessagePackWriter::writeBytes(const void * data, size_t byteLength) {
+  const uint8_t * bytes = static_cast<const uint8_t *>(data);
+  output.insert(output.end(), bytes, bytes + byteLength);
+}
+
+const uint8_t * MessagePackReader::consume(size_t byteLength) {
+  if (byteLength > length - cursor) {
+    throw IllegalStateException("Corrupt MessagePack value.");
+  }
+  const uint8_t * bytes = data + cursor;
+  cursor += byteLength;
+  return bytes;
+}
+
+template<typename T>
+T MessagePackReader::readBigEndian() {
+  const uint8_t * bytes = consume(sizeof(T));
+  uint64_t bits = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    bits = (bits << 8) | bytes[i];
+  }
+
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+void MessagePackReader::readPayload(Item & item, Type type, uint32_t byteLength) {
+  item.type = type;
+  item.length = byteLength;
+  item.data = consume(byteLength);
+}
+
+void MessagePackReader::read(Item & item) {
+  uint8_t marker = *consume(1);
+
+  if (marker <= 0x7f || marker >= 0xe0) {
+    item.type = INTEGER;
+    item.integer = static_cast<int8_t>(marker);
+    return;
+  }
+  if (marker <= 0x8f || (marker >= 0x90 && marker <= 0x9f)) {
+    item.type = marker <= 0x8f ? MAP : ARRAY;
+    item.length = marker & 0x0f;
+    return;
+  }
+  if (marker >= 0xa0 && marker <= 0xbf) {
+    readPayload(item, STRING, marker & 0x1f);
+    return;
+  }
+
+  switch (marker) {
+    case 0xc0:
+      item.type = NIL;
+      return;
+    case 0xc2:
+    case 0xc3:
+      item.type = BOOLEAN;
+      item.boolean = marker == 0xc3;
+      return;
+    case 0xc4:
+      readPayload(item, BINARY, readBigEndian<uint8_t>());
+      return;
+    case 0xc5:
+      readPayload(item, BINARY, readBigEndian<uint16_t>());
+      return;
+    case 0xc6:
+      readPayload(item, BINARY, readBigEndian<uint32_t>());
+      return;
+    case 0xc7:
+    case 0xc8:
+    case 0xc9: {
+      uint32_t byteLength = marker == 0xc7 ? readBigEndian<uint8_t>() :
+        marker == 0xc8 ? readBigEndian<uint16_t>() : readBigEndian<uint32_t>();
+      item.extensionType = readBigEndian<int8_t>();
+      readPayload(item, EXTENSION, byteLength);
+      return;
+    }
+    case 0xca:
+      item.type = DOUBLE;
+      item.number = readBigEndian<float>();
+      return;
+    case 0xcb:
+      item.type = DOUBLE;
+      item.number = readBigEndian<double>();
+      return;
+    case 0xcc:
+      item.type = INTEGER;
+      item.integer = readBigEndian<uint8_t>();
+      return;
+    case 0xcd:
+      item.type = INTEGER;
+      item.integer = readBigEndian<uint16_t>();
+      return;
+    case 0xce:
+      item.type = INTEGER;
+      item.integer = readBigEndian<uint32_t>();
+      return;
+    case 0xcf:
+      // Other encoders use uint 64 for large positive numbers; only int 64 means a long.
+      item.type = DOUBLE;
+      item.number = static_cast<double>(readBigEndian<uint64_t>());
+      return;
+    case 0xd0:
+      item.type = INTEGER;
+      item.integer = readBigEndian<int8_t>();
+      return;
+    case 0xd1:
+      item.type = INTEGER;
+      item.integer = readBigEndian<int16_t>();
+      return;
+    case 0xd2:
+      item.type = INTEGER;
+      item.integer = readBigEndian<int32_t>();
+      return;
+    case 0xd3:
+      item.type = INT64;
+      item.integer = readBigEndian<int64_t>();
+      return;
+    case 0xd4:
+    case 0xd5:
+    case 0xd6:
+    case 0xd7:
+    case 0xd8:
+      item.extensionType = readBigEndian<int8_t>();
+      readPayload(item, EXTENSION, 1 << (marker - 0xd4));
+      return;
+    case 0xd9:
+      readPayload(item, STRING, readBigEndian<uint8_t>());
+      return;
+    case 0xda:
+      readPayload(item, STRING, readBigEndian<uint16_t>());
+      return;
+    case 0xdb:
+      readPayload(item, STRING, readBigEndian<uint32_t>());
+      return;
+    case 0xdc:
+    case 0xdd:
+    case 0xde:
+    case 0xdf:
+      item.type = marker <= 0xdd ? ARRAY : MAP;
+      item.length = (marker & 1) == 0 ? readBigEndian<uint16_t>() : readBigEndian<uint32_t>();
+      // Every element takes at least a byte, which rules out absurd lengths before allocating.
+      if (item.length > length - cursor) {
+        throw IllegalStateException("Corrupt MessagePack value.");
+      }
+      return;
+  }
+
+  throw IllegalStateException("Corrupt MessagePack value.");
+}
+
+void MessagePackReader::skip(unsigned int depth) {
+  Item item;
+  read(item);
+
+  if (item.type == ARRAY || item.type == MAP) {
+    checkDepth(depth);
+    uint64_t remaining = item.type == MAP ? 2 * static_cast<uint64_t>(item.length) : item.length;
+    for (uint64_t i = 0; i < remaining; i++) {
+      skip(depth + 1);
+    }
+  }
+}
+
+void MessagePackReader::checkDepth(unsigned int depth) {
+  if (depth >= maxDepth) {
+    throw IllegalStateException("MessagePack value is nested too deeply.");
+  }
+}
+
+double MessagePackReader::timestamp(const Item & item) {
+  double seconds;
+  double nanoseconds = 0;
+
+  MessagePackReader payload(item.data, item.length);
+  switch (item.length) {
+    case 4:
+      seconds = payload.readBigEndian<uint32_t>();
+      break;
+    case 8: {
+      uint64_t bits = payload.readBigEndian<uint64_t>();
+      nanoseconds = static_cast<double>(bits >> 34);
+      seconds = static_cast<double>(bits & 0x3ffffffffULL);
+      break;
+    }
+    case 12:
+      nanoseconds = payload.readBigEndian<uint32_t>();
+      seconds = static_cast<double>(payload.readBigEndian<int64_t>());
+      break;
+    default:
+      throw IllegalStateException("Corrupt MessagePack value.");
+  }
+
+  return seconds * 1000 + std::floor(nanoseconds / 1000000);
+}
+
+}  // namespace node_gemfire
@@ -0,0 +1,115 @@
+#ifndef __MESSAGE_PACK_HPP__
+#define __MESSAGE_PACK_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace node_gemfire {
+
+// Extension types used by the msgpack region codec on top of the standard MessagePack types.
+// Typed array payloads are the raw little-endian elements.
+enum MessagePackExtension {
+  TIMESTAMP_EXTENSION = -1,
+  UNDEFINED_EXTENSION = 0x01,
+  INT16_ARRAY_EXTENSION = 0x10,
+  INT32_ARRAY_EXTENSION = 0x11,
+  FLOAT_ARRAY_EXTENSION = 0x12,
+  DOUBLE_ARRAY_EXTENSION = 0x13,
+  INT64_ARRAY_EXTENSION = 0x14
+};
+
+// Appends MessagePack to a byte vector, always choosing the shortest form.
+class MessagePackWriter {
+ public:
+  explicit MessagePackWriter(std::vector<uint8_t> & output) :
+    output(output) {}
+
+  void writeNil();
+  void writeBoolean(bool value);
+  // Integers outside the int 32 range are written by the caller as doubles or with writeInt64().
+  void writeInteger(int32_t value);
+  // Always written as int 64, so that the value reads back as a GemFire long.
+  void writeInt64(int64_t value);
+  void writeDouble(double value);
+  void writeDate(double millisecondsSinceEpoch);
+  void writeStringHeader(uint32_t byteLength);
+  void writeBinaryHeader(uint32_t byteLength);
+  void writeArrayHeader(uint32_t length);
+  void writeMapHeader(uint32_t length);
+  void writeExtensionHeader(int8_t type, uint32_t byteLength);
+  void writeBytes(const void * data, size_t byteLength);
+
+ private:
+  template<typename T>
+  void writeBigEndian(T value);
+  template<typename T>
+  void writeBigEndian(uint8_t marker, T value);
+
+  std::vector<uint8_t> & output;
+};
+
+// Reads MessagePack back one item at a time. Containers give their length and are followed by their
+// elements (maps by alternating keys and values). Throws IllegalStateException on malformed input.
+class MessagePackReader {
+ public:
+  enum Type {
+    NIL,
+    BOOLEAN,
+    INTEGER,
+    INT64,
+    DOUBLE,
+    STRING,
+    BINARY,
+    ARRAY,
+    MAP,
+    EXTENSION
+  };
+
+  struct Item {
+    Type type;
+    // The element count for ARRAY and MAP, the byte length for STRING, BINARY and EXTENSION.
+    uint32_t length;
+    int8_t extensionType;
+    bool boolean;
+    int64_t integer;
+    double number;
+    const uint8_t * data;
+  };
+
+  MessagePackReader(const uint8_t * data, size_t length) :
+    data(data),
+    length(length),
+    cursor(0) {}
+
+  // Containers are read recursively, so values nested deeper than this are rejected before they
+  // can exhaust the worker thread's stack.
+  static const unsigned int maxDepth = 4096;
+
+  void read(Item & item);
+  // Reads past the next value, including every element of a container. depth is the number of
+  // containers the value is nested in.
+  void skip(unsigned int depth = 0);
+  // Throws IllegalStateException if a container at depth is nested too deeply.
+  static void checkDepth(unsigned int depth);
+  bool atEnd() const {
+    return cursor == length;
+  }
+
+  // The milliseconds since the epoch of a TIMESTAMP_EXTENSION payload.
+  static double timestamp(const Item & item);
+
+ private:
+  const uint8_t * consume(size_t byteLength);
+  template<typename T>
+  T readBigEndian();
+  void readPayload(Item & item, Type type, uint32_t byteLength);
+
+  const uint8_t * data;
+  size_t length;
+  size_t cursor;
+};
+
+}  // namespace node_gemfire
+
+#endif
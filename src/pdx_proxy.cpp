@@ -0,0 +1,169 @@
+#include "pdx_proxy.hpp"
+#include <string>
+#include <vector>
+#include "conversions.hpp"
+#include "exceptions.hpp"
+
+using namespace v8;
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+NAN_MODULE_INIT(PdxProxy::Init) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> constructorTemplate = Nan::New<FunctionTemplate>();
+  constructorTemplate->SetClassName(Nan::New("PdxProxy").ToLocalChecked());
+
+  Local<ObjectTemplate> instanceTemplate(constructorTemplate->InstanceTemplate());
+  instanceTemplate->SetInternalFieldCount(1);
+  Nan::SetNamedPropertyHandler(instanceTemplate,
+                               PdxProxy::Getter,
+                               PdxProxy::Setter,
+                               PdxProxy::Query,
+                               PdxProxy::Deleter,
+                               PdxProxy::Enumerator);
+
+  constructor().Reset(Nan::GetFunction(constructorTemplate).ToLocalChecked());
+}
+
+PdxProxy::PdxProxy(const PdxInstancePtr & pdxInstancePtr) :
+  pdxInstancePtr(pdxInstancePtr) {
+    CacheableStringArrayPtr gemfireKeys(pdxInstancePtr->getFieldNames());
+    if (gemfireKeys != NULLPTR) {
+      int length = gemfireKeys->length();
+      fieldNames.reserve(length);
+      for (int i = 0; i < length; i++) {
+        fieldNames.push_back(gemfireKeys[i]->asChar());
+      }
+      fieldNameSet.insert(fieldNames.begin(), fieldNames.end());
+    }
+
+    Local<Object> memoObject(Nan::New<Object>());
+    Nan::SetPrototype(memoObject, Nan::Null());
+    memo.Reset(memoObject);
+  }
+
+Local<Object> PdxProxy::NewInstance(const PdxInstancePtr & pdxInstancePtr) {
+  Nan::EscapableHandleScope scope;
+
+  const unsigned int argc = 0;
+  Local<Value> argv[argc] = {};
+  Local<Object> instance(Nan::NewInstance(Nan::New(constructor()), argc, argv).ToLocalChecked());
+
+  PdxProxy * pdxProxy = new PdxProxy(pdxInstancePtr);
+  pdxProxy->Wrap(instance);
+
+  return scope.Escape(instance);
+}
+
+bool PdxProxy::hasPdxField(const std::string & fieldName) const {
+  return fieldNameSet.count(fieldName) > 0 && deletedFieldNames.count(fieldName) == 0;
+}
+
+// Symbols such as Symbol.iterator or util.inspect.custom are never PDX fields, and are left to the
+// object itself.
+NAN_PROPERTY_GETTER(PdxProxy::Getter) {
+  if (property->IsSymbol()) {
+    return;
+  }
+
+  PdxProxy * pdxProxy = Nan::ObjectWrap::Unwrap<PdxProxy>(info.Holder());
+  Local<Object> memo(Nan::New(pdxProxy->memo));
+
+  if (Nan::HasOwnProperty(memo, property).FromJust()) {
+    info.GetReturnValue().Set(Nan::Get(memo, property).ToLocalChecked());
+    return;
+  }
+
+  std::string fieldName(*Nan::Utf8String(property));
+  if (!pdxProxy->hasPdxField(fieldName)) {
+    return;
+  }
+
+  try {
+    Local<Value> value(v8LazyValue(getPdxField(pdxProxy->pdxInstancePtr, fieldName.c_str())));
+    Nan::Set(memo, property, value);
+    info.GetReturnValue().Set(value);
+  } catch (const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+  }
+}
+
+NAN_PROPERTY_SETTER(PdxProxy::Setter) {
+  if (property->IsSymbol()) {
+    return;
+  }
+
+  PdxProxy * pdxProxy = Nan::ObjectWrap::Unwrap<PdxProxy>(info.Holder());
+  Nan::Set(Nan::New(pdxProxy->memo), property, value);
+  info.GetReturnValue().Set(value);
+}
+
+NAN_PROPERTY_QUERY(PdxProxy::Query) {
+  if (property->IsSymbol()) {
+    return;
+  }
+
+  PdxProxy * pdxProxy = Nan::ObjectWrap::Unwrap<PdxProxy>(info.Holder());
+
+  if (Nan::HasOwnProperty(Nan::New(pdxProxy->memo), property).FromJust() ||
+      pdxProxy->hasPdxField(*Nan::Utf8String(property))) {
+    info.GetReturnValue().Set(Nan::New<Integer>(None));
+  }
+}
+
+NAN_PROPERTY_DELETER(PdxProxy::Deleter) {
+  if (property->IsSymbol()) {
+    return;
+  }
+
+  PdxProxy * pdxProxy = Nan::ObjectWrap::Unwrap<PdxProxy>(info.Holder());
+  Local<Object> memo(Nan::New(pdxProxy->memo));
+
+  bool deleted = false;
+  if (Nan::HasOwnProperty(memo, property).FromJust()) {
+    Nan::Delete(memo, property);
+    deleted = true;
+  }
+
+  std::string fieldName(*Nan::Utf8String(property));
+  if (pdxProxy->hasPdxField(fieldName)) {
+    pdxProxy->deletedFieldNames.insert(fieldName);
+    deleted = true;
+  }
+
+  if (deleted) {
+    info.GetReturnValue().Set(true);
+  }
+}
+
+NAN_PROPERTY_ENUMERATOR(PdxProxy::Enumerator) {
+  PdxProxy * pdxProxy = Nan::ObjectWrap::Unwrap<PdxProxy>(info.Holder());
+  Local<Object> memo(Nan::New(pdxProxy->memo));
+
+  Local<Array> names(Nan::New<Array>());
+  unsigned int length = 0;
+
+  for (std::vector<std::string>::const_iterator iterator(pdxProxy->fieldNames.begin());
+       iterator != pdxProxy->fieldNames.end();
+       ++iterator) {
+    if (pdxProxy->deletedFieldNames.count(*iterator) == 0) {
+      Nan::Set(names, length++, Nan::New(*iterator).ToLocalChecked());
+    }
+  }
+
+  // Fields assigned from JavaScript that are not part of the PDX type, or were deleted from it and
+  // assigned again, come last.
+  Local<Array> memoNames(Nan::GetOwnPropertyNames(memo).ToLocalChecked());
+  for (unsigned int i = 0; i < memoNames->Length(); i++) {
+    Local<Value> memoName(Nan::Get(memoNames, i).ToLocalChecked());
+    if (!pdxProxy->hasPdxField(*Nan::Utf8String(memoName))) {
+      Nan::Set(names, length++, memoName);
+    }
+  }
+
+  info.GetReturnValue().Set(names);
+}
+
+}  // namespace node_gemfire
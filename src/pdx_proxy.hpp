@@ -0,0 +1,52 @@
+#ifndef __PDX_PROXY_HPP__
+#define __PDX_PROXY_HPP__
+
+#include <v8.h>
+#include <nan.h>
+#include <geode/PdxInstance.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace node_gemfire {
+
+// A JavaScript object backed by a PdxInstance. Each field is converted the first time it is read
+// and then remembered; enumerating the object (Object.keys, JSON.stringify) reads every field.
+class PdxProxy : public Nan::ObjectWrap {
+ public:
+  static NAN_MODULE_INIT(Init);
+  static v8::Local<v8::Object> NewInstance(const apache::geode::client::PdxInstancePtr & pdxInstancePtr);
+
+ protected:
+  explicit PdxProxy(const apache::geode::client::PdxInstancePtr & pdxInstancePtr);
+
+  virtual ~PdxProxy() {
+    memo.Reset();
+  }
+
+  static NAN_PROPERTY_GETTER(Getter);
+  static NAN_PROPERTY_SETTER(Setter);
+  static NAN_PROPERTY_QUERY(Query);
+  static NAN_PROPERTY_DELETER(Deleter);
+  static NAN_PROPERTY_ENUMERATOR(Enumerator);
+
+ private:
+  bool hasPdxField(const std::string & fieldName) const;
+
+  apache::geode::client::PdxInstancePtr pdxInstancePtr;
+  std::vector<std::string> fieldNames;
+  std::unordered_set<std::string> fieldNameSet;
+  std::unordered_set<std::string> deletedFieldNames;
+
+  // Fields that have been read or assigned, on an object with a null prototype.
+  Nan::Persistent<v8::Object> memo;
+
+  static inline Nan::Persistent<v8::Function> & constructor() {
+    static Nan::Persistent<v8::Function> my_constructor;
+    return my_constructor;
+  }
+};
+
+}  // namespace node_gemfire
+
+#endif
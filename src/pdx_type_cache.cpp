@@ -0,0 +1,127 @@
+#include "pdx_type_cache.hpp"
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace node_gemfire {
+
+std::string pdxClassName(const std::vector<PdxTypeDescriptor::Field> & fields) {
+  std::set<std::string> fieldNames;
+  size_t totalSize = 0;
+
+  for (std::vector<PdxTypeDescriptor::Field>::const_iterator iterator(fields.begin());
+       iterator != fields.end();
+       ++iterator) {
+    const std::string & fieldName(iterator->name);
+
+    std::string fullFieldName;
+    fullFieldName.reserve((fieldName.length() * 2) + 3);  // escape every character, plus '[],'
+
+    for (std::string::const_iterator character(fieldName.begin());
+         character != fieldName.end();
+         ++character) {
+      switch (*character) {
+        case ',':
+        case '[':
+        case ']':
+        case '\\':
+          fullFieldName += '\\';
+      }
+      fullFieldName += *character;
+    }
+
+    if (iterator->isArray) {
+      fullFieldName += "[]";
+    }
+    fullFieldName += ',';
+
+    fieldNames.insert(fullFieldName);
+    totalSize += fullFieldName.length();
+  }
+
+  std::string className;
+  className.reserve(totalSize + 7);
+  className += "JSON: ";
+
+  for (std::set<std::string>::iterator i(fieldNames.begin()); i != fieldNames.end(); ++i) {
+    className += *i;
+  }
+  return className;
+}
+
+PdxTypeDescriptor::PdxTypeDescriptor(const std::vector<Field> & fields) :
+  fields(fields),
+  className(pdxClassName(fields)) {}
+
+PdxTypeCache * PdxTypeCache::getInstance() {
+  static PdxTypeCache instance;
+  return &instance;
+}
+
+void PdxTypeCache::appendToShapeKey(std::string & shapeKey,
+                                    const char * fieldName,
+                                    uint32_t fieldNameLength,
+                                    bool isArray) {
+  // Length-prefixed so that field names containing any byte sequence stay unambiguous.
+  shapeKey.append(reinterpret_cast<const char *>(&fieldNameLength), sizeof(fieldNameLength));
+  shapeKey.append(fieldName, fieldNameLength);
+  shapeKey += isArray ? '[' : '.';
+}
+
+PdxTypeDescriptorPtr PdxTypeCache::find(const std::string & shapeKey) {
+  uv_mutex_lock(&mutex);
+
+  std::unordered_map<std::string, PdxTypeDescriptorPtr>::const_iterator iterator(
+      descriptors.find(shapeKey));
+
+  if (iterator != descriptors.end()) {
+    hits++;
+    PdxTypeDescriptorPtr descriptor(iterator->second);
+    uv_mutex_unlock(&mutex);
+    return descriptor;
+  }
+
+  misses++;
+
+  if (descriptors.size() >= maxEntries) {
+    descriptors.clear();
+  }
+
+  PdxTypeDescriptorPtr descriptor(compile(shapeKey));
+  descriptors.insert(std::make_pair(shapeKey, descriptor));
+
+  uv_mutex_unlock(&mutex);
+  return descriptor;
+}
+
+size_t PdxTypeCache::size() {
+  uv_mutex_lock(&mutex);
+  size_t size = descriptors.size();
+  uv_mutex_unlock(&mutex);
+  return size;
+}
+
+PdxTypeDescriptorPtr PdxTypeCache::compile(const std::string & shapeKey) {
+  std::vector<PdxTypeDescriptor::Field> fields;
+
+  const char * position = shapeKey.data();
+  const char * end = position + shapeKey.length();
+  while (position < end) {
+    uint32_t fieldNameLength;
+    memcpy(&fieldNameLength, position, sizeof(fieldNameLength));
+    position += sizeof(fieldNameLength);
+
+    std::string fieldName(position, fieldNameLength);
+    position += fieldNameLength;
+
+    bool isArray = (*position == '[');
+    position++;
+
+    fields.push_back(PdxTypeDescriptor::Field(fieldName, isArray));
+  }
+
+  return PdxTypeDescriptorPtr(new PdxTypeDescriptor(fields));
+}
+
+}  // namespace node_gemfire
@@ -0,0 +1,77 @@
+#ifndef __PDX_TYPE_CACHE_HPP__
+#define __PDX_TYPE_CACHE_HPP__
+
+#include <uv.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node_gemfire {
+
+class PdxTypeDescriptor {
+ public:
+  struct Field {
+    Field(const std::string & name, bool isArray) :
+      name(name),
+      isArray(isArray) {}
+
+    std::string name;
+    bool isArray;
+  };
+
+  explicit PdxTypeDescriptor(const std::vector<Field> & fields);
+
+  // Fields are kept in the property enumeration order of the object that produced the shape.
+  const std::vector<Field> fields;
+  const std::string className;
+};
+
+typedef std::shared_ptr<const PdxTypeDescriptor> PdxTypeDescriptorPtr;
+
+// Maps the shape of a JavaScript object (its own property names in enumeration order, plus whether
+// each value is an array) to the PDX type it serializes to, so that objects sharing a shape skip
+// the sorting and escaping done by pdxClassName(). Lookups are locked because JSON values are
+// parsed into PDX on worker threads.
+class PdxTypeCache {
+ public:
+  PdxTypeCache() :
+    hits(0),
+    misses(0) {
+      uv_mutex_init(&mutex);
+    }
+
+  ~PdxTypeCache() {
+    uv_mutex_destroy(&mutex);
+  }
+
+  static PdxTypeCache * getInstance();
+
+  static void appendToShapeKey(std::string & shapeKey,
+                               const char * fieldName,
+                               uint32_t fieldNameLength,
+                               bool isArray);
+
+  PdxTypeDescriptorPtr find(const std::string & shapeKey);
+
+  uint64_t getHits() const { return hits; }
+  uint64_t getMisses() const { return misses; }
+  size_t size();
+
+ private:
+  static const size_t maxEntries = 4096;
+
+  static PdxTypeDescriptorPtr compile(const std::string & shapeKey);
+
+  std::unordered_map<std::string, PdxTypeDescriptorPtr> descriptors;
+  uint64_t hits;
+  uint64_t misses;
+  uv_mutex_t mutex;
+};
+
+std::string pdxClassName(const std::vector<PdxTypeDescriptor::Field> & fields);
+
+}  // namespace node_gemfire
+
+#endif
@@ -0,0 +1,38 @@
+#include "promise_worker.hpp"
+
+using namespace v8;
+
+namespace node_gemfire {
+
+namespace {
+
+NAN_METHOD(RunReactions) {}
+
+// Promises settled outside of a MakeCallback() leave their reactions queued until the next one.
+// Calling an empty function through Nan::Callback runs them, and the nextTick queue, right away.
+Nan::Callback * reactionsCallback() {
+  static Nan::Callback * callback =
+    new Nan::Callback(Nan::GetFunction(Nan::New<FunctionTemplate>(RunReactions)).ToLocalChecked());
+  return callback;
+}
+
+}  // namespace
+
+Local<Promise::Resolver> newResolver() {
+  Nan::EscapableHandleScope scope;
+  return scope.Escape(Promise::Resolver::New(Nan::GetCurrentContext()).ToLocalChecked());
+}
+
+void settlePromise(const Local<Promise::Resolver> & resolver, bool rejected, const Local<Value> & value) {
+  Nan::HandleScope scope;
+  Local<Context> context(Nan::GetCurrentContext());
+  if (rejected) {
+    resolver->Reject(context, value).FromJust();
+  } else {
+    resolver->Resolve(context, value).FromJust();
+  }
+
+  reactionsCallback()->Call(0, NULL);
+}
+
+}  // namespace node_gemfire
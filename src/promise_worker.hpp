@@ -0,0 +1,46 @@
+#ifndef __PROMISE_WORKER_HPP__
+#define __PROMISE_WORKER_HPP__
+
+#include <nan.h>
+#include <v8.h>
+#include <utility>
+
+namespace node_gemfire {
+
+v8::Local<v8::Promise::Resolver> newResolver();
+
+// Resolves or rejects the promise, then runs its reactions before returning to the event loop.
+void settlePromise(const v8::Local<v8::Promise::Resolver> & resolver, bool rejected,
+                   const v8::Local<v8::Value> & value);
+
+// Settles a promise with the outcome of Worker instead of calling a callback. Worker must provide
+// result(), the value its callback would have been passed.
+template <typename Worker>
+class PromiseWorker final : public Worker {
+ public:
+  template <typename... Args>
+  explicit PromiseWorker(const v8::Local<v8::Promise::Resolver> & resolver, Args &&... args) :
+      Worker(std::forward<Args>(args)...),
+      resolver(resolver) {}
+
+  ~PromiseWorker() {
+    resolver.Reset();
+  }
+
+  void HandleOKCallback() {
+    Nan::HandleScope scope;
+    settlePromise(Nan::New(resolver), false, this->result());
+  }
+
+  void HandleErrorCallback() {
+    Nan::HandleScope scope;
+    settlePromise(Nan::New(resolver), true, this->errorObject());
+  }
+
+ private:
+  Nan::Persistent<v8::Promise::Resolver> resolver;
+};
+
+}  // namespace node_gemfire
+
+#endif
@@ -5,13 +5,20 @@
 #include <string>
 #include <vector>
 #include "conversions.hpp"
+#include "decoded_value.hpp"
+#include "json.hpp"
+#include "staging_buffer.hpp"
 #include "exceptions.hpp"
 #include "cache.hpp"
 #include "gemfire_worker.hpp"
+#include "gemfire_executor.hpp"
 #include "events.hpp"
 #include "functions.hpp"
 #include "region_event_registry.hpp"
 #include "dependencies.hpp"
+#include "value_codec.hpp"
+#include "promise_worker.hpp"
+#include "region_cursor.hpp"
 
 using namespace v8;
 using namespace apache::geode::client;
@@ -22,6 +29,11 @@ inline bool isFunctionOrUndefined(const Local<Value> & value) {
   return value->IsUndefined() || value->IsFunction();
 }
 
+const size_t defaultCursorBatchSize = 1000;
+
+// Passed as the callback of workers that settle a promise instead.
+Nan::Callback * const noCallback = NULL;
+
 inline Nan::Callback * getCallback(const Local<Value> & value) {
   if (value->IsUndefined()) {
     return NULL;
@@ -29,6 +41,77 @@ inline Nan::Callback * getCallback(const Local<Value> & value) {
   return new Nan::Callback(Local<Function>::Cast(value));
 }
 
+// Options accepted by get(), getSync(), getAll() and getAllSync().
+struct GetOptions {
+  GetOptions() :
+    lazy(false),
+    map(false) {}
+
+  bool lazy;
+  // getAll() results come back as a Map instead of an object with String keys.
+  bool map;
+  // Empty unless the fields option was passed.
+  FieldProjection fields;
+};
+
+bool parseGetOptions(const Local<Value> & value, GetOptions & options, const char * methodName) {
+  if (value->IsUndefined()) {
+    return true;
+  }
+
+  if (!value->IsObject() || value->IsArray() || value->IsFunction()) {
+    std::stringstream errorMessageStream;
+    errorMessageStream << "You must pass an object as the options to " << methodName << "().";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+
+  Local<Object> v8Options(value.As<Object>());
+  Local<Value> lazy(Nan::Get(v8Options, Nan::New("lazy").ToLocalChecked()).ToLocalChecked());
+  options.lazy = Nan::To<bool>(lazy).FromJust();
+
+  Local<Value> map(Nan::Get(v8Options, Nan::New("map").ToLocalChecked()).ToLocalChecked());
+  options.map = Nan::To<bool>(map).FromJust();
+
+  Local<Value> fields(Nan::Get(v8Options, Nan::New("fields").ToLocalChecked()).ToLocalChecked());
+  if (fields->IsUndefined()) {
+    return true;
+  }
+
+  bool validFields = fields->IsArray();
+  if (validFields) {
+    Local<Array> v8Fields(fields.As<Array>());
+    for (uint32_t i = 0; validFields && i < v8Fields->Length(); i++) {
+      Local<Value> field(Nan::Get(v8Fields, i).ToLocalChecked());
+      std::string path(field->IsString() ? *Nan::Utf8String(field) : "");
+      validFields = !path.empty() && path[0] != '.' && path[path.length() - 1] != '.' &&
+        path.find("..") == std::string::npos;
+      if (validFields) {
+        options.fields.add(path);
+      }
+    }
+  }
+
+  if (!validFields) {
+    std::stringstream errorMessageStream;
+    errorMessageStream << "You must pass an array of field names as the fields option to "
+                       << methodName << "().";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+
+  // Projected values are decoded eagerly, so that only the selected fields are ever converted.
+  if (!options.fields.empty()) {
+    options.lazy = false;
+  }
+
+  return true;
+}
+
+inline ValueCodecOptions regionCodecOptions(const RegionPtr & regionPtr) {
+  return ValueCodecRegistry::getInstance()->get(regionPtr);
+}
+
 v8::Local<v8::Object> Region::NewInstance(RegionPtr regionPtr) {
   Nan::EscapableHandleScope scope;
   const unsigned int argc = 0;
@@ -42,11 +125,18 @@ v8::Local<v8::Object> Region::NewInstance(RegionPtr regionPtr) {
 
 class GemfireEventedWorker : public GemfireWorker {
  public:
+  // v8Object, which errors are emitted on when there is no callback, is empty for promise workers.
   GemfireEventedWorker( const Local<Object> & v8Object, Nan::Callback * callback) :
       GemfireWorker(callback) {
-        SaveToPersistent("v8Object", v8Object);
+        if (!v8Object.IsEmpty()) {
+          SaveToPersistent("v8Object", v8Object);
+        }
       }
 
+  Local<Value> result() {
+    return Nan::Undefined();
+  }
+
   virtual void HandleOKCallback() {
     if (callback) {
       Nan::Call(*callback, 0, NULL);
@@ -93,7 +183,7 @@ NAN_METHOD(Region::Clear) {
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   Nan::Callback * callback = getCallback(info[0]);
   ClearWorker * worker = new ClearWorker(info.Holder(), region, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -104,11 +194,15 @@ std::string unableToPutValueError(Local<Value> v8Value) {
   return errorMessageStream.str();
 }
 
-CachePtr getCacheFromRegion(RegionPtr regionPtr) {
+// The cache is looked up once per Region object; afterwards it is only checked for being closed.
+CachePtr getCacheFromRegion(Region * region) {
   Nan::HandleScope scope;
+  RegionPtr regionPtr(region->regionPtr);
   try {
-    //TODO: need to fix this since it gets any instance and doesn't use the region.
-    CachePtr cachePtr = CacheFactory::getAnyInstance();
+    if (region->cachePtr == NULLPTR) {
+      region->cachePtr = CacheFactory::getAnyInstance();
+    }
+    CachePtr cachePtr(region->cachePtr);
     if(cachePtr == NULLPTR || cachePtr->isClosed()){
       if(regionPtr != NULLPTR){
         std::string msg("Region name ");
@@ -120,7 +214,7 @@ CachePtr getCacheFromRegion(RegionPtr regionPtr) {
       }
       return NULLPTR;
     }
-    return CacheFactory::getAnyInstance();
+    return cachePtr;
   } catch (const RegionDestroyedException & exception) {
     ThrowGemfireException(exception);
   }
@@ -131,29 +225,35 @@ class PutWorker : public GemfireEventedWorker {
  public:
   PutWorker(
     const Local<Object> & regionObject,
-    Region * region,
+    const RegionPtr & regionPtr,
+    const CachePtr & cachePtr,
     const CacheableKeyPtr & keyPtr,
-    const CacheablePtr & valuePtr,
+    ValueCodecOptions codecOptions,
     Nan::Callback * callback) :
       GemfireEventedWorker(regionObject, callback),
-      region(region),
+      regionPtr(regionPtr),
+      cachePtr(cachePtr),
       keyPtr(keyPtr),
-      valuePtr(valuePtr) { }
+      codecOptions(codecOptions) { }
 
   void ExecuteGemfireWork() {
     if (keyPtr == NULLPTR) {
       SetError("InvalidKeyError", "Invalid GemFire key.");
       return;
     }
+
+    CacheablePtr valuePtr(stagingBuffer.build(cachePtr, codecOptions));
     if (valuePtr == NULLPTR) {
       SetError("InvalidValueError", "Invalid GemFire value.");
       return;
     }
-    region->regionPtr->put(keyPtr, valuePtr);
+    regionPtr->put(keyPtr, valuePtr);
   }
-  Region * region;
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
   CacheableKeyPtr keyPtr;
-  CacheablePtr valuePtr;
+  ValueCodecOptions codecOptions;
+  StagingBuffer stagingBuffer;
 };
 
 NAN_METHOD(Region::Put) {
@@ -171,17 +271,23 @@ NAN_METHOD(Region::Put) {
 
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
 
   CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
-  CacheablePtr valuePtr(gemfireValue(info[1], cachePtr));
 
+  // The value is only staged here; its PdxInstances are created on the worker thread.
   Nan::Callback * callback = getCallback(info[2]);
-  PutWorker * putWorker = new PutWorker(info.Holder(), region, keyPtr, valuePtr, callback);
-  Nan::AsyncQueueWorker(putWorker);
+  PutWorker * putWorker =
+    new PutWorker(info.Holder(), region->regionPtr, cachePtr, keyPtr, regionCodecOptions(region->regionPtr),
+                  callback);
+  if (!putWorker->stagingBuffer.stage(info[1])) {
+    delete putWorker;
+    return;
+  }
+  queueGemfireWorker(putWorker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -199,7 +305,7 @@ NAN_METHOD(Region::PutSync) {
 
     Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
 
-    CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+    CachePtr cachePtr(getCacheFromRegion(region));
     if (cachePtr == NULLPTR) {
       info.GetReturnValue().Set(Nan::Undefined());
       return;
@@ -212,7 +318,19 @@ NAN_METHOD(Region::PutSync) {
       return;
     }
 
-    CacheablePtr valuePtr(gemfireValue(info[1], cachePtr));
+    CacheablePtr valuePtr;
+    ValueCodecOptions codecOptions(regionCodecOptions(region->regionPtr));
+    if (!codecOptions.usesEnvelopes()) {
+      valuePtr = gemfireValue(info[1], cachePtr);
+    } else {
+      StagingBuffer stagingBuffer;
+      if (!stagingBuffer.stage(info[1])) {
+        info.GetReturnValue().Set(Nan::Undefined());
+        return;
+      }
+      valuePtr = stagingBuffer.build(cachePtr, codecOptions);
+    }
+
     if (valuePtr == NULLPTR) {
       Nan::ThrowError("Invalid GemFire value.");
       info.GetReturnValue().Set(Nan::Undefined());
@@ -227,14 +345,388 @@ NAN_METHOD(Region::PutSync) {
   }
 }
 
+// The server-side function that merges changed fields into the stored PdxInstance. See server/ for
+// the implementation, which has to be deployed to the servers.
+const char * const updateFunctionId = "io.pivotal.node_gemfire.UpdateFields";
+
+// Server functions write the entry on the server only. A caching region would keep answering gets
+// with its own copy of the old value, so that copy is invalidated once the function has run.
+void invalidateCachedEntry(const RegionPtr & regionPtr, const CacheableKeyPtr & keyPtr) {
+  if (!regionPtr->getAttributes()->getCachingEnabled()) {
+    return;
+  }
+
+  try {
+    regionPtr->localInvalidate(keyPtr);
+  } catch (const EntryNotFoundException & exception) {
+    // Nothing was cached for the key.
+  }
+}
+
+class UpdateWorker : public GemfireEventedWorker {
+ public:
+  UpdateWorker(
+    const Local<Object> & regionObject,
+    const RegionPtr & regionPtr,
+    const CachePtr & cachePtr,
+    const CacheableKeyPtr & keyPtr,
+    Nan::Callback * callback) :
+      GemfireEventedWorker(regionObject, callback),
+      regionPtr(regionPtr),
+      cachePtr(cachePtr),
+      keyPtr(keyPtr) { }
+
+  // Only the changed fields travel to the server, as the function's argument; the key is the
+  // filter, so the function runs on the member hosting the entry.
+  void ExecuteGemfireWork() {
+    if (keyPtr == NULLPTR) {
+      SetError("InvalidKeyError", "Invalid GemFire key.");
+      return;
+    }
+
+    CacheablePtr changesPtr(stagingBuffer.build(cachePtr));
+    CacheableVectorPtr filterPtr(CacheableVector::create());
+    filterPtr->push_back(keyPtr);
+
+    ExecutionPtr executionPtr(
+        FunctionService::onRegion(regionPtr)->withFilter(filterPtr)->withArgs(changesPtr));
+    executionPtr->execute(updateFunctionId)->getResult();
+    invalidateCachedEntry(regionPtr, keyPtr);
+  }
+
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
+  CacheableKeyPtr keyPtr;
+  StagingBuffer stagingBuffer;
+};
+
+NAN_METHOD(Region::Update) {
+  Nan::HandleScope scope;
+
+  if (info.Length() < 2 || !info[1]->IsObject() || info[1]->IsArray() || info[1]->IsDate() ||
+      info[1]->IsFunction() || isPrimitiveArray(info[1])) {
+    Nan::ThrowError("You must pass a key and an object of changed fields to update().");
+    return;
+  }
+  if (!isFunctionOrUndefined(info[2])) {
+    Nan::ThrowError("You must pass a function as the callback to update().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  if (regionCodecOptions(region->regionPtr).usesEnvelopes()) {
+    Nan::ThrowError("update() requires a region that stores values as uncompressed PDX.");
+    return;
+  }
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
+
+  Nan::Callback * callback = getCallback(info[2]);
+  UpdateWorker * updateWorker =
+    new UpdateWorker(info.Holder(), region->regionPtr, cachePtr, keyPtr, callback);
+  if (!updateWorker->stagingBuffer.stage(info[1])) {
+    delete updateWorker;
+    return;
+  }
+  queueGemfireWorker(updateWorker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+// putIfAbsent(), replace() and increment() have no native client operation, and run in this server
+// function instead. See server/ for the implementation, which has to be deployed to the servers.
+const char * const conditionalWriteFunctionId = "io.pivotal.node_gemfire.ConditionalWrite";
+
+enum ConditionalOperation {
+  PUT_IF_ABSENT,
+  REPLACE,
+  REMOVE_IF_EQUALS,
+  INCREMENT
+};
+
+const char * conditionalOperationName(ConditionalOperation operation) {
+  switch (operation) {
+    case PUT_IF_ABSENT:
+      return "putIfAbsent";
+    case REPLACE:
+      return "replace";
+    case REMOVE_IF_EQUALS:
+      return "removeIfEquals";
+    default:
+      return "increment";
+  }
+}
+
+// Sends the operation to the server as a single request, and returns its result: the previous
+// value for putIfAbsent(), whether the entry was written for replace() and removeIfEquals(), and
+// the new value for increment(). removeIfEquals() is the native remove(key, value).
+CacheablePtr executeConditional(const RegionPtr & regionPtr, ConditionalOperation operation,
+                                const CacheableKeyPtr & keyPtr, const CacheablePtr & firstPtr,
+                                const CacheablePtr & secondPtr) {
+  if (operation == REMOVE_IF_EQUALS) {
+    return CacheableBoolean::create(regionPtr->remove(keyPtr, firstPtr));
+  }
+
+  CacheableVectorPtr argumentsPtr(CacheableVector::create());
+  argumentsPtr->push_back(CacheableString::create(conditionalOperationName(operation)));
+  argumentsPtr->push_back(firstPtr);
+  if (operation == REPLACE) {
+    argumentsPtr->push_back(secondPtr);
+  }
+
+  // The key is the filter, so the function runs on the member hosting the entry.
+  CacheableVectorPtr filterPtr(CacheableVector::create());
+  filterPtr->push_back(keyPtr);
+
+  ExecutionPtr executionPtr(
+      FunctionService::onRegion(regionPtr)->withFilter(filterPtr)->withArgs(argumentsPtr));
+  CacheableVectorPtr resultsPtr(executionPtr->execute(conditionalWriteFunctionId)->getResult());
+  invalidateCachedEntry(regionPtr, keyPtr);
+  if (resultsPtr->size() == 0) {
+    return NULLPTR;
+  }
+  return (*resultsPtr)[0];
+}
+
+// The number of values each conditional operation takes after the key.
+inline int conditionalValueCount(ConditionalOperation operation) {
+  return operation == REPLACE ? 2 : 1;
+}
+
+class ConditionalWorker : public GemfireEventedWorker {
+ public:
+  ConditionalWorker(
+    const Local<Object> & regionObject,
+    const RegionPtr & regionPtr,
+    const CachePtr & cachePtr,
+    const CacheableKeyPtr & keyPtr,
+    ConditionalOperation operation,
+    ValueCodecOptions codecOptions,
+    Nan::Callback * callback) :
+      GemfireEventedWorker(regionObject, callback),
+      regionPtr(regionPtr),
+      cachePtr(cachePtr),
+      keyPtr(keyPtr),
+      operation(operation),
+      codecOptions(codecOptions),
+      decodedValue(codecOptions) { }
+
+  void ExecuteGemfireWork() {
+    if (keyPtr == NULLPTR) {
+      SetError("InvalidKeyError", "Invalid GemFire key.");
+      return;
+    }
+
+    CacheablePtr valuePtrs[2];
+    for (int i = 0; i < conditionalValueCount(operation); i++) {
+      valuePtrs[i] = stagingBuffers[i].build(cachePtr, codecOptions);
+      if (valuePtrs[i] == NULLPTR) {
+        SetError("InvalidValueError", "Invalid GemFire value.");
+        return;
+      }
+    }
+
+    decodedValue.decode(executeConditional(regionPtr, operation, keyPtr, valuePtrs[0], valuePtrs[1]));
+  }
+
+  void HandleOKCallback() {
+    if (callback) {
+      Nan::HandleScope scope;
+      Local<Value> argv[2] = { Nan::Undefined(), decodedValue.v8Value() };
+      Nan::Call(*callback, 2, argv);
+    }
+  }
+
+  StagingBuffer stagingBuffers[2];
+
+ private:
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
+  CacheableKeyPtr keyPtr;
+  ConditionalOperation operation;
+  ValueCodecOptions codecOptions;
+  DecodedValue decodedValue;
+};
+
+// Checks the arguments shared by the conditional methods: the key, then the values, then an
+// optional callback for the asynchronous forms. Sync forms take exactly the key and values.
+bool checkConditionalArguments(const Nan::FunctionCallbackInfo<Value> & info,
+                               ConditionalOperation operation, bool synchronous) {
+  const char * name = conditionalOperationName(operation);
+  int valueCount = conditionalValueCount(operation);
+  int argsLength = info.Length();
+  std::stringstream errorMessageStream;
+
+  bool validValues = synchronous ? argsLength == valueCount + 1 : argsLength >= valueCount + 1;
+  if (validValues && operation == INCREMENT) {
+    validValues = info[1]->IsNumber();
+  }
+
+  if (!validValues) {
+    errorMessageStream << "You must pass a key and ";
+    switch (operation) {
+      case REPLACE:
+        errorMessageStream << "the expected and new values";
+        break;
+      case REMOVE_IF_EQUALS:
+        errorMessageStream << "the expected value";
+        break;
+      case INCREMENT:
+        errorMessageStream << "a number";
+        break;
+      default:
+        errorMessageStream << "value";
+        break;
+    }
+    errorMessageStream << " to " << name << (synchronous ? "Sync" : "") << "().";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+
+  if (!synchronous && !isFunctionOrUndefined(info[valueCount + 1])) {
+    errorMessageStream << "You must pass a function as the callback to " << name << "().";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+
+  // The server cannot add to a number it cannot read.
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  if (operation == INCREMENT && regionCodecOptions(region->regionPtr).usesEnvelopes()) {
+    errorMessageStream << name << (synchronous ? "Sync" : "")
+                       << "() requires a region that stores values as uncompressed PDX.";
+    Nan::ThrowError(errorMessageStream.str().c_str());
+    return false;
+  }
+
+  return true;
+}
+
+void queueConditional(const Nan::FunctionCallbackInfo<Value> & info, ConditionalOperation operation) {
+  if (!checkConditionalArguments(info, operation, false)) {
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  int valueCount = conditionalValueCount(operation);
+  Nan::Callback * callback = getCallback(info[valueCount + 1]);
+  ConditionalWorker * worker =
+    new ConditionalWorker(info.Holder(), region->regionPtr, cachePtr, gemfireKey(info[0], cachePtr),
+                          operation, regionCodecOptions(region->regionPtr), callback);
+  for (int i = 0; i < valueCount; i++) {
+    if (!worker->stagingBuffers[i].stage(info[i + 1])) {
+      delete worker;
+      return;
+    }
+  }
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+void executeConditionalSync(const Nan::FunctionCallbackInfo<Value> & info, ConditionalOperation operation) {
+  if (!checkConditionalArguments(info, operation, true)) {
+    return;
+  }
+
+  try {
+    Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+    CachePtr cachePtr(getCacheFromRegion(region));
+    if (cachePtr == NULLPTR) {
+      return;
+    }
+
+    CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
+    if (keyPtr == NULLPTR) {
+      Nan::ThrowError("Invalid GemFire key.");
+      return;
+    }
+
+    ValueCodecOptions codecOptions(regionCodecOptions(region->regionPtr));
+    CacheablePtr valuePtrs[2];
+    for (int i = 0; i < conditionalValueCount(operation); i++) {
+      StagingBuffer stagingBuffer;
+      if (!stagingBuffer.stage(info[i + 1])) {
+        return;
+      }
+      valuePtrs[i] = stagingBuffer.build(cachePtr, codecOptions);
+      if (valuePtrs[i] == NULLPTR) {
+        Nan::ThrowError("Invalid GemFire value.");
+        return;
+      }
+    }
+
+    DecodedValue decodedValue(codecOptions);
+    decodedValue.decode(executeConditional(region->regionPtr, operation, keyPtr, valuePtrs[0], valuePtrs[1]));
+    info.GetReturnValue().Set(decodedValue.v8Value());
+  } catch(const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+  }
+}
+
+NAN_METHOD(Region::PutIfAbsent) {
+  Nan::HandleScope scope;
+  queueConditional(info, PUT_IF_ABSENT);
+}
+
+NAN_METHOD(Region::PutIfAbsentSync) {
+  Nan::HandleScope scope;
+  executeConditionalSync(info, PUT_IF_ABSENT);
+}
+
+NAN_METHOD(Region::Replace) {
+  Nan::HandleScope scope;
+  queueConditional(info, REPLACE);
+}
+
+NAN_METHOD(Region::ReplaceSync) {
+  Nan::HandleScope scope;
+  executeConditionalSync(info, REPLACE);
+}
+
+NAN_METHOD(Region::RemoveIfEquals) {
+  Nan::HandleScope scope;
+  queueConditional(info, REMOVE_IF_EQUALS);
+}
+
+NAN_METHOD(Region::RemoveIfEqualsSync) {
+  Nan::HandleScope scope;
+  executeConditionalSync(info, REMOVE_IF_EQUALS);
+}
+
+NAN_METHOD(Region::Increment) {
+  Nan::HandleScope scope;
+  queueConditional(info, INCREMENT);
+}
+
+NAN_METHOD(Region::IncrementSync) {
+  Nan::HandleScope scope;
+  executeConditionalSync(info, INCREMENT);
+}
+
 class GetWorker : public GemfireWorker {
  public:
   GetWorker(Nan::Callback * callback,
            const RegionPtr & regionPtr,
-           const CacheableKeyPtr & keyPtr) :
+           const CacheableKeyPtr & keyPtr,
+           const GetOptions & options,
+           ValueCodecOptions codecOptions) :
       GemfireWorker(callback),
       regionPtr(regionPtr),
-      keyPtr(keyPtr) {}
+      keyPtr(keyPtr),
+      options(options),
+      decodedValue(codecOptions) {
+    decodedValue.project(options.fields);
+  }
 
   void ExecuteGemfireWork() {
     if (keyPtr == NULLPTR) {
@@ -244,6 +736,10 @@ class GetWorker : public GemfireWorker {
 
     valuePtr = regionPtr->get(keyPtr);
 
+    if (!options.lazy) {
+      decodedValue.decode(valuePtr);
+    }
+
     //TODO switching up behavior no error for key not found
     /*
     if (valuePtr == NULLPTR) {
@@ -252,15 +748,21 @@ class GetWorker : public GemfireWorker {
     */
   }
 
+  Local<Value> result() {
+    return options.lazy ? v8LazyValue(valuePtr) : decodedValue.v8Value();
+  }
+
   void HandleOKCallback() {
     Nan::HandleScope scope;
-    Local<Value> argv[2] = { Nan::Undefined(), v8Value(valuePtr) };
+    Local<Value> argv[2] = { Nan::Undefined(), result() };
     Nan::Call(*callback, 2, argv);
   }
 
   RegionPtr regionPtr;
   CacheableKeyPtr keyPtr;
   CacheablePtr valuePtr;
+  GetOptions options;
+  DecodedValue decodedValue;
 };
 
 NAN_METHOD(Region::Get) {
@@ -268,29 +770,39 @@ NAN_METHOD(Region::Get) {
 
   unsigned int argsLength = info.Length();
 
-  if (argsLength != 2) {
+  if (argsLength != 2 && argsLength != 3) {
     Nan::ThrowError("You must pass a key and a callback to get().");
     return;
   }
 
-  if (!info[1]->IsFunction()) {
+  Local<Value> v8Callback(info[argsLength - 1]);
+  if (!v8Callback->IsFunction()) {
     Nan::ThrowError("You must pass a function as the callback to get().");
     return;
   }
 
+  GetOptions options;
+  if (argsLength == 3 && !parseGetOptions(info[1], options, "get")) {
+    return;
+  }
+
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   RegionPtr regionPtr(region->regionPtr);
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  // Encoded values have no PdxInstances to proxy, so they are always decoded eagerly.
+  ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+  options.lazy = options.lazy && !codecOptions.usesEnvelopes();
+
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
 
   CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
 
-  Nan::Callback * callback = new Nan::Callback(info[1].As<Function>());
-  GetWorker * getWorker = new GetWorker(callback, regionPtr, keyPtr);
-  Nan::AsyncQueueWorker(getWorker);
+  Nan::Callback * callback = new Nan::Callback(v8Callback.As<Function>());
+  GetWorker * getWorker = new GetWorker(callback, regionPtr, keyPtr, options, codecOptions);
+  queueGemfireWorker(getWorker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -298,6 +810,7 @@ NAN_METHOD(Region::Get) {
 NAN_METHOD(Region::GetSync) {
   Nan::HandleScope scope;
   CacheablePtr valuePtr = NULLPTR;
+  GetOptions options;
   try{
     unsigned int argsLength = info.Length();
     if (argsLength == 0) {
@@ -306,20 +819,33 @@ NAN_METHOD(Region::GetSync) {
       return;
     }
 
+    if (!parseGetOptions(info[1], options, "getSync")) {
+      return;
+    }
+
     Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
     RegionPtr regionPtr(region->regionPtr);
 
-    CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+    CachePtr cachePtr(getCacheFromRegion(region));
     if (cachePtr == NULLPTR) {
       info.GetReturnValue().Set(Nan::Undefined());
       return;
     }
     CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
     valuePtr = regionPtr->get(keyPtr);
+
+    ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+    if (codecOptions.usesEnvelopes() || !options.fields.empty()) {
+      DecodedValue decodedValue(codecOptions);
+      decodedValue.project(options.fields);
+      decodedValue.decode(valuePtr);
+      info.GetReturnValue().Set(decodedValue.v8Value());
+      return;
+    }
   } catch(apache::geode::client::Exception & exception) {
     ThrowGemfireException(exception);
   }
-  info.GetReturnValue().Set(v8Value(valuePtr));
+  info.GetReturnValue().Set(options.lazy ? v8LazyValue(valuePtr) : v8Value(valuePtr));
 }
 
 class GetAllWorker : public GemfireWorker {
@@ -327,190 +853,583 @@ class GetAllWorker : public GemfireWorker {
   GetAllWorker(
       const RegionPtr & regionPtr,
       const VectorOfCacheableKeyPtr & gemfireKeysPtr,
+      const GetOptions & options,
+      ValueCodecOptions codecOptions,
       Nan::Callback * callback) :
     GemfireWorker(callback),
     regionPtr(regionPtr),
-    gemfireKeysPtr(gemfireKeysPtr) {}
+    gemfireKeysPtr(gemfireKeysPtr),
+    options(options),
+    decodedValue(codecOptions) {
+    decodedValue.project(options.fields);
+  }
 
   void ExecuteGemfireWork() {
-    resultsPtr = new HashMapOfCacheable();
-
     if (gemfireKeysPtr == NULLPTR) {
+      resultsPtr = new HashMapOfCacheable();
+      SetError("InvalidKeyError", "Invalid GemFire key.");
+      return;
+    }
+
+    resultsPtr = new HashMapOfCacheable(gemfireKeysPtr->size());
+    if (gemfireKeysPtr->size() == 0) {
+      return;
+    }
+
+    regionPtr->getAll(*gemfireKeysPtr, resultsPtr, NULLPTR);
+
+    if (!options.lazy) {
+      decodedValue.decode(resultsPtr, options.map);
+    }
+  }
+
+  Local<Value> result() {
+    if (options.map && (options.lazy || resultsPtr->size() == 0)) {
+      return v8Map(resultsPtr, options.lazy);
+    }
+    if (options.lazy || resultsPtr->size() == 0) {
+      return v8LazyValue(resultsPtr);
+    }
+    return decodedValue.v8Value();
+  }
+
+  void HandleOKCallback() {
+    Nan::HandleScope scope;
+    Local<Value> argv[2] = { Nan::Undefined(), result() };
+    Nan::Call(*callback, 2, argv);
+  }
+
+ private:
+  RegionPtr regionPtr;
+  VectorOfCacheableKeyPtr gemfireKeysPtr;
+  HashMapOfCacheablePtr resultsPtr;
+  GetOptions options;
+  DecodedValue decodedValue;
+};
+
+NAN_METHOD(Region::GetAll) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0 || !info[0]->IsArray()) {
+    Nan::ThrowError("You must pass an array of keys and a callback to getAll().");
+    return;
+  }
+
+  if (info.Length() == 1) {
+    Nan::ThrowError("You must pass a callback to getAll().");
+    return;
+  }
+
+  Local<Value> v8Callback(info[info.Length() - 1]);
+  if (!v8Callback->IsFunction()) {
+    Nan::ThrowError("You must pass a function as the callback to getAll().");
+    return;
+  }
+
+  GetOptions options;
+  if (info.Length() > 2 && !parseGetOptions(info[1], options, "getAll")) {
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+  options.lazy = options.lazy && !codecOptions.usesEnvelopes();
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
+
+  Nan::Callback * callback = new Nan::Callback(v8Callback.As<Function>());
+
+  GetAllWorker * worker = new GetAllWorker(regionPtr, gemfireKeysPtr, options, codecOptions, callback);
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+NAN_METHOD(Region::GetAllSync) {
+  Nan::HandleScope scope;
+  try{
+    if (info.Length() == 0 || info.Length() > 2 || !info[0]->IsArray()) {
+      Nan::ThrowError("You must pass an array of keys to getAllSync().");
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+
+    GetOptions options;
+    if (!parseGetOptions(info[1], options, "getAllSync")) {
+      return;
+    }
+    Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+    RegionPtr regionPtr(region->regionPtr);
+    CachePtr cachePtr(getCacheFromRegion(region));
+
+    if (cachePtr == NULLPTR) {
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+
+    VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
+    if (gemfireKeysPtr == NULLPTR) {
+      Nan::ThrowError("Invalid GemFire key.");
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+    HashMapOfCacheablePtr resultsPtr(new HashMapOfCacheable(gemfireKeysPtr->size()));
+    if (gemfireKeysPtr->size() == 0) {
+      if (options.map) {
+        info.GetReturnValue().Set(v8Map(resultsPtr));
+      } else {
+        info.GetReturnValue().Set(v8Object(resultsPtr));
+      }
+    }else{
+      regionPtr->getAll(*gemfireKeysPtr, resultsPtr, NULLPTR);
+
+      ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+      if (codecOptions.usesEnvelopes() || !options.fields.empty()) {
+        DecodedValue decodedValue(codecOptions);
+        decodedValue.project(options.fields);
+        decodedValue.decode(resultsPtr, options.map);
+        info.GetReturnValue().Set(decodedValue.v8Value());
+        return;
+      }
+      if (options.map) {
+        info.GetReturnValue().Set(v8Map(resultsPtr, options.lazy));
+      } else {
+        info.GetReturnValue().Set(options.lazy ? v8LazyValue(resultsPtr) : v8Value(resultsPtr));
+      }
+    }
+  } catch(apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+    info.GetReturnValue().Set(Nan::Undefined());
+  }
+}
+
+class PutAllWorker : public GemfireEventedWorker {
+ public:
+  PutAllWorker(
+      const Local<Object> & regionObject,
+      const RegionPtr & regionPtr,
+      const CachePtr & cachePtr,
+      ValueCodecOptions codecOptions,
+      Nan::Callback * callback) :
+    GemfireEventedWorker(regionObject, callback),
+    regionPtr(regionPtr),
+    cachePtr(cachePtr),
+    codecOptions(codecOptions) { }
+
+  void ExecuteGemfireWork() {
+    HashMapOfCacheablePtr hashMapPtr(stagingBuffer.buildHashMap(cachePtr, codecOptions));
+    if (hashMapPtr == NULLPTR) {
+      SetError("InvalidValueError", "Invalid GemFire value.");
+      return;
+    }
+    regionPtr->putAll(*hashMapPtr);
+  }
+
+  StagingBuffer stagingBuffer;
+
+ private:
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
+  ValueCodecOptions codecOptions;
+};
+
+NAN_METHOD(Region::PutAll) {
+  Nan::HandleScope scope;
+  if (info.Length() == 0 || !info[0]->IsObject()) {
+    Nan::ThrowError("You must pass an object and a callback to putAll().");
+    return;
+  }
+  if (!isFunctionOrUndefined(info[1])) {
+    Nan::ThrowError("You must pass a function as the callback to putAll().");
+    return;
+  }
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Nan::Callback * callback = getCallback(info[1]);
+  PutAllWorker * worker =
+    new PutAllWorker(info.Holder(), regionPtr, cachePtr, regionCodecOptions(regionPtr), callback);
+  if (!worker->stagingBuffer.stageEntries(info[0]->ToObject())) {
+    delete worker;
+    return;
+  }
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+NAN_METHOD(Region::PutAllSync) {
+  Nan::HandleScope scope;
+  try{
+    if (info.Length() != 1 || !info[0]->IsObject()) {
+      Nan::ThrowError("You must pass an object to putAllSync().");
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+
+    Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+    RegionPtr regionPtr(region->regionPtr);
+
+    CachePtr cachePtr(getCacheFromRegion(region));
+    if (cachePtr == NULLPTR) {
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+    HashMapOfCacheablePtr hashMapPtr;
+    ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+    if (!codecOptions.usesEnvelopes()) {
+      hashMapPtr = gemfireHashMap(info[0]->ToObject(), cachePtr);
+    } else {
+      StagingBuffer stagingBuffer;
+      if (!stagingBuffer.stageEntries(info[0]->ToObject())) {
+        info.GetReturnValue().Set(Nan::Undefined());
+        return;
+      }
+      hashMapPtr = stagingBuffer.buildHashMap(cachePtr, codecOptions);
+    }
+
+    if (hashMapPtr == NULLPTR) {
+      Nan::ThrowError("Invalid GemFire value.");
+      info.GetReturnValue().Set(Nan::Undefined());
+      return;
+    }
+    regionPtr->putAll(*hashMapPtr);
+    info.GetReturnValue().Set(info.Holder());
+  }catch (const apache::geode::client::Exception & exception) {
+    ThrowGemfireException(exception);
+    info.GetReturnValue().Set(Nan::Undefined());
+  }
+}
+
+// The JSON methods keep V8 out of the conversion entirely: the text is copied on the JavaScript
+// thread and parsed into PDX, or serialized from PDX, on the worker thread.
+class PutJSONWorker : public GemfireEventedWorker {
+ public:
+  PutJSONWorker(
+    const Local<Object> & regionObject,
+    const RegionPtr & regionPtr,
+    const CachePtr & cachePtr,
+    const CacheableKeyPtr & keyPtr,
+    const Local<Value> & v8Json,
+    ValueCodecOptions codecOptions,
+    Nan::Callback * callback) :
+      GemfireEventedWorker(regionObject, callback),
+      regionPtr(regionPtr),
+      cachePtr(cachePtr),
+      keyPtr(keyPtr),
+      codecOptions(codecOptions) {
+        Nan::Utf8String utf8Json(v8Json);
+        json.assign(*utf8Json, utf8Json.length());
+      }
+
+  void ExecuteGemfireWork() {
+    if (keyPtr == NULLPTR) {
+      SetError("InvalidKeyError", "Invalid GemFire key.");
+      return;
+    }
+
+    std::string errorMessage;
+    if (!stageJson(json.data(), json.length(), stagingBuffer, errorMessage)) {
+      SetError("SyntaxError", errorMessage.c_str());
+      return;
+    }
+
+    CacheablePtr valuePtr(stagingBuffer.build(cachePtr, codecOptions));
+    if (valuePtr == NULLPTR) {
+      SetError("InvalidValueError", "Invalid GemFire value.");
+      return;
+    }
+    regionPtr->put(keyPtr, valuePtr);
+  }
+
+ private:
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
+  CacheableKeyPtr keyPtr;
+  ValueCodecOptions codecOptions;
+  std::string json;
+  // Created with the worker, on the JavaScript thread, so that it sees the conversion options.
+  StagingBuffer stagingBuffer;
+};
+
+NAN_METHOD(Region::PutJSON) {
+  Nan::HandleScope scope;
+
+  if (info.Length() < 2 || !info[1]->IsString()) {
+    Nan::ThrowError("You must pass a key and a JSON string to putJSON().");
+    return;
+  }
+  if (!isFunctionOrUndefined(info[2])) {
+    Nan::ThrowError("You must pass a function as the callback to putJSON().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
+
+  Nan::Callback * callback = getCallback(info[2]);
+  PutJSONWorker * worker =
+    new PutJSONWorker(info.Holder(), region->regionPtr, cachePtr, keyPtr, info[1],
+                      regionCodecOptions(region->regionPtr), callback);
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+class PutAllJSONWorker : public GemfireEventedWorker {
+ public:
+  PutAllJSONWorker(
+    const Local<Object> & regionObject,
+    const RegionPtr & regionPtr,
+    const CachePtr & cachePtr,
+    const Local<Value> & v8Json,
+    ValueCodecOptions codecOptions,
+    Nan::Callback * callback) :
+      GemfireEventedWorker(regionObject, callback),
+      regionPtr(regionPtr),
+      cachePtr(cachePtr),
+      codecOptions(codecOptions) {
+        Nan::Utf8String utf8Json(v8Json);
+        json.assign(*utf8Json, utf8Json.length());
+      }
+
+  void ExecuteGemfireWork() {
+    std::string errorMessage;
+    if (!stageJson(json.data(), json.length(), stagingBuffer, errorMessage, true)) {
+      SetError("SyntaxError", errorMessage.c_str());
+      return;
+    }
+
+    HashMapOfCacheablePtr hashMapPtr(stagingBuffer.buildHashMap(cachePtr, codecOptions));
+    if (hashMapPtr == NULLPTR) {
+      SetError("InvalidValueError", "Invalid GemFire value.");
+      return;
+    }
+    regionPtr->putAll(*hashMapPtr);
+  }
+
+ private:
+  RegionPtr regionPtr;
+  CachePtr cachePtr;
+  ValueCodecOptions codecOptions;
+  std::string json;
+  StagingBuffer stagingBuffer;
+};
+
+NAN_METHOD(Region::PutAllJSON) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0 || !info[0]->IsString()) {
+    Nan::ThrowError("You must pass a JSON string to putAllJSON().");
+    return;
+  }
+  if (!isFunctionOrUndefined(info[1])) {
+    Nan::ThrowError("You must pass a function as the callback to putAllJSON().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Nan::Callback * callback = getCallback(info[1]);
+  PutAllJSONWorker * worker =
+    new PutAllJSONWorker(info.Holder(), region->regionPtr, cachePtr, info[0],
+                         regionCodecOptions(region->regionPtr), callback);
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+class GetJSONWorker : public GemfireWorker {
+ public:
+  GetJSONWorker(
+    const RegionPtr & regionPtr,
+    const CacheableKeyPtr & keyPtr,
+    Int64Mode int64Mode,
+    ValueCodecOptions codecOptions,
+    Nan::Callback * callback) :
+      GemfireWorker(callback),
+      regionPtr(regionPtr),
+      keyPtr(keyPtr),
+      int64Mode(int64Mode),
+      codecOptions(codecOptions),
+      found(false),
+      defined(false) {}
+
+  void ExecuteGemfireWork() {
+    if (keyPtr == NULLPTR) {
       SetError("InvalidKeyError", "Invalid GemFire key.");
       return;
     }
 
-    if (gemfireKeysPtr->size() == 0) {
+    CacheablePtr valuePtr(regionPtr->get(keyPtr));
+    found = (valuePtr != NULLPTR);
+    if (!found) {
       return;
     }
 
-    regionPtr->getAll(*gemfireKeysPtr, resultsPtr, NULLPTR);
+    std::string errorMessage;
+    defined = writeJson(valuePtr, int64Mode, codecOptions, json, errorMessage);
+    if (!errorMessage.empty()) {
+      SetError("InvalidValueError", errorMessage.c_str());
+    }
   }
 
   void HandleOKCallback() {
     Nan::HandleScope scope;
 
-    Local<Value> argv[2] = { Nan::Undefined(), v8Value(resultsPtr) };
+    Local<Value> v8Json;
+    if (!found) {
+      v8Json = Nan::Null();
+    } else if (!defined) {
+      v8Json = Nan::Undefined();
+    } else {
+      v8Json = Nan::New(json.data(), json.length()).ToLocalChecked();
+    }
+
+    Local<Value> argv[2] = { Nan::Undefined(), v8Json };
     Nan::Call(*callback, 2, argv);
   }
 
  private:
   RegionPtr regionPtr;
-  VectorOfCacheableKeyPtr gemfireKeysPtr;
-  HashMapOfCacheablePtr resultsPtr;
+  CacheableKeyPtr keyPtr;
+  Int64Mode int64Mode;
+  ValueCodecOptions codecOptions;
+  bool found;
+  bool defined;
+  std::string json;
 };
 
-NAN_METHOD(Region::GetAll) {
+NAN_METHOD(Region::GetJSON) {
   Nan::HandleScope scope;
 
-  if (info.Length() == 0 || !info[0]->IsArray()) {
-    Nan::ThrowError("You must pass an array of keys and a callback to getAll().");
-    return;
-  }
-
-  if (info.Length() == 1) {
-    Nan::ThrowError("You must pass a callback to getAll().");
+  if (info.Length() != 2) {
+    Nan::ThrowError("You must pass a key and a callback to getJSON().");
     return;
   }
-
   if (!info[1]->IsFunction()) {
-    Nan::ThrowError("You must pass a function as the callback to getAll().");
+    Nan::ThrowError("You must pass a function as the callback to getJSON().");
     return;
   }
 
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
-  RegionPtr regionPtr(region->regionPtr);
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
 
-  VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
+  CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
 
   Nan::Callback * callback = new Nan::Callback(info[1].As<Function>());
-
-  GetAllWorker * worker = new GetAllWorker(regionPtr, gemfireKeysPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  GetJSONWorker * worker =
+    new GetJSONWorker(region->regionPtr, keyPtr, conversionOptions().int64Mode,
+                      regionCodecOptions(region->regionPtr), callback);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
 
-NAN_METHOD(Region::GetAllSync) {
-  Nan::HandleScope scope;
-  try{
-    if (info.Length() != 1 || !info[0]->IsArray()) {
-      Nan::ThrowError("You must pass an array of keys to getAllSync().");
-      info.GetReturnValue().Set(Nan::Undefined());
-      return;
-    }
-    Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
-    RegionPtr regionPtr(region->regionPtr);
-    CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
-
-    if (cachePtr == NULLPTR) {
-      info.GetReturnValue().Set(Nan::Undefined());
-      return;
-    }
+class GetAllJSONWorker : public GemfireWorker {
+ public:
+  GetAllJSONWorker(
+    const RegionPtr & regionPtr,
+    const VectorOfCacheableKeyPtr & gemfireKeysPtr,
+    Int64Mode int64Mode,
+    ValueCodecOptions codecOptions,
+    Nan::Callback * callback) :
+      GemfireWorker(callback),
+      regionPtr(regionPtr),
+      gemfireKeysPtr(gemfireKeysPtr),
+      int64Mode(int64Mode),
+      codecOptions(codecOptions) {}
 
-    VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
+  void ExecuteGemfireWork() {
     if (gemfireKeysPtr == NULLPTR) {
-      Nan::ThrowError("Invalid GemFire key.");
-      info.GetReturnValue().Set(Nan::Undefined());
+      SetError("InvalidKeyError", "Invalid GemFire key.");
       return;
     }
+
     HashMapOfCacheablePtr resultsPtr(new HashMapOfCacheable());
-    if (gemfireKeysPtr->size() == 0) {
-      info.GetReturnValue().Set(v8Object(resultsPtr));
-    }else{
+    if (gemfireKeysPtr->size() > 0) {
       regionPtr->getAll(*gemfireKeysPtr, resultsPtr, NULLPTR);
-      info.GetReturnValue().Set(v8Value(resultsPtr));
     }
-  } catch(apache::geode::client::Exception & exception) {
-    ThrowGemfireException(exception);
-    info.GetReturnValue().Set(Nan::Undefined());
-  }
-}
-
-class PutAllWorker : public GemfireEventedWorker {
- public:
-  PutAllWorker(
-      const Local<Object> & regionObject,
-      const RegionPtr & regionPtr,
-      const HashMapOfCacheablePtr & hashMapPtr,
-      Nan::Callback * callback) :
-    GemfireEventedWorker(regionObject, callback),
-    regionPtr(regionPtr),
-    hashMapPtr(hashMapPtr) { }
 
-  void ExecuteGemfireWork() {
-    if (hashMapPtr == NULLPTR) {
-      SetError("InvalidValueError", "Invalid GemFire value.");
-      return;
+    std::string errorMessage;
+    writeJson(resultsPtr, int64Mode, codecOptions, json, errorMessage);
+    if (!errorMessage.empty()) {
+      SetError("InvalidValueError", errorMessage.c_str());
     }
-    regionPtr->putAll(*hashMapPtr);
+  }
+
+  void HandleOKCallback() {
+    Nan::HandleScope scope;
+    Local<Value> argv[2] = {
+      Nan::Undefined(),
+      Nan::New(json.data(), json.length()).ToLocalChecked()
+    };
+    Nan::Call(*callback, 2, argv);
   }
 
  private:
   RegionPtr regionPtr;
-  HashMapOfCacheablePtr hashMapPtr;
+  VectorOfCacheableKeyPtr gemfireKeysPtr;
+  Int64Mode int64Mode;
+  ValueCodecOptions codecOptions;
+  std::string json;
 };
 
-NAN_METHOD(Region::PutAll) {
+NAN_METHOD(Region::GetAllJSON) {
   Nan::HandleScope scope;
-  if (info.Length() == 0 || !info[0]->IsObject()) {
-    Nan::ThrowError("You must pass an object and a callback to putAll().");
+
+  if (info.Length() == 0 || !info[0]->IsArray()) {
+    Nan::ThrowError("You must pass an array of keys and a callback to getAllJSON().");
     return;
   }
-  if (!isFunctionOrUndefined(info[1])) {
-    Nan::ThrowError("You must pass a function as the callback to putAll().");
+  if (!info[1]->IsFunction()) {
+    Nan::ThrowError("You must pass a function as the callback to getAllJSON().");
     return;
   }
+
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
-  RegionPtr regionPtr(region->regionPtr);
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
 
-  HashMapOfCacheablePtr hashMapPtr(gemfireHashMap(info[0]->ToObject(), cachePtr));
-  Nan::Callback * callback = getCallback(info[1]);
-  PutAllWorker * worker = new PutAllWorker(info.Holder(), regionPtr, hashMapPtr, callback);
-  Nan::AsyncQueueWorker(worker);
-
-  info.GetReturnValue().Set(info.Holder());
-}
-
-NAN_METHOD(Region::PutAllSync) {
-  Nan::HandleScope scope;
-  try{
-    if (info.Length() != 1 || !info[0]->IsObject()) {
-      Nan::ThrowError("You must pass an object to putAllSync().");
-      info.GetReturnValue().Set(Nan::Undefined());
-      return;
-    }
+  VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
 
-    Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
-    RegionPtr regionPtr(region->regionPtr);
+  Nan::Callback * callback = new Nan::Callback(info[1].As<Function>());
+  GetAllJSONWorker * worker =
+    new GetAllJSONWorker(region->regionPtr, gemfireKeysPtr, conversionOptions().int64Mode,
+                         regionCodecOptions(region->regionPtr), callback);
+  queueGemfireWorker(worker);
 
-    CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
-    if (cachePtr == NULLPTR) {
-      info.GetReturnValue().Set(Nan::Undefined());
-      return;
-    }
-    HashMapOfCacheablePtr hashMapPtr(gemfireHashMap(info[0]->ToObject(), cachePtr));
-    if (hashMapPtr == NULLPTR) {
-      Nan::ThrowError("Invalid GemFire value.");
-      info.GetReturnValue().Set(Nan::Undefined());
-      return;
-    }
-    regionPtr->putAll(*hashMapPtr);
-    info.GetReturnValue().Set(info.Holder());
-  }catch (const apache::geode::client::Exception & exception) {
-    ThrowGemfireException(exception);
-    info.GetReturnValue().Set(Nan::Undefined());
-  }
+  info.GetReturnValue().Set(info.Holder());
 }
 
 class RemoveWorker : public GemfireEventedWorker {
@@ -557,7 +1476,7 @@ NAN_METHOD(Region::Remove) {
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   RegionPtr regionPtr(region->regionPtr);
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
@@ -565,18 +1484,163 @@ NAN_METHOD(Region::Remove) {
   CacheableKeyPtr keyPtr(gemfireKey(info[0], cachePtr));
   Nan::Callback * callback = getCallback(info[1]);
   RemoveWorker * worker = new RemoveWorker(info.Holder(), regionPtr, keyPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
 
+// The promise methods validate their arguments like the callback methods, and throw for invalid ones.
+NAN_METHOD(Region::GetAsync) {
+  Nan::HandleScope scope;
+
+  if (info.Length() != 1 && info.Length() != 2) {
+    Nan::ThrowError("You must pass a key to getAsync().");
+    return;
+  }
+
+  GetOptions options;
+  if (!parseGetOptions(info[1], options, "getAsync")) {
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+  options.lazy = options.lazy && !codecOptions.usesEnvelopes();
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Local<Promise::Resolver> resolver(newResolver());
+  queueGemfireWorker(new PromiseWorker<GetWorker>(
+      resolver, noCallback, regionPtr, gemfireKey(info[0], cachePtr), options, codecOptions));
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
+NAN_METHOD(Region::GetAllAsync) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0 || info.Length() > 2 || !info[0]->IsArray()) {
+    Nan::ThrowError("You must pass an array of keys to getAllAsync().");
+    return;
+  }
+
+  GetOptions options;
+  if (!parseGetOptions(info[1], options, "getAllAsync")) {
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  ValueCodecOptions codecOptions(regionCodecOptions(regionPtr));
+  options.lazy = options.lazy && !codecOptions.usesEnvelopes();
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  VectorOfCacheableKeyPtr gemfireKeysPtr(gemfireKeys(Local<Array>::Cast(info[0]), cachePtr));
+
+  Local<Promise::Resolver> resolver(newResolver());
+  queueGemfireWorker(new PromiseWorker<GetAllWorker>(
+      resolver, regionPtr, gemfireKeysPtr, options, codecOptions, noCallback));
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
+NAN_METHOD(Region::PutAsync) {
+  Nan::HandleScope scope;
+
+  if (info.Length() != 2) {
+    Nan::ThrowError("You must pass a key and value to putAsync().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Local<Promise::Resolver> resolver(newResolver());
+  PromiseWorker<PutWorker> * worker = new PromiseWorker<PutWorker>(
+      resolver, Local<Object>(), regionPtr, cachePtr, gemfireKey(info[0], cachePtr),
+      regionCodecOptions(regionPtr), noCallback);
+  if (!worker->stagingBuffer.stage(info[1])) {
+    delete worker;
+    return;
+  }
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
+NAN_METHOD(Region::PutAllAsync) {
+  Nan::HandleScope scope;
+
+  if (info.Length() != 1 || !info[0]->IsObject()) {
+    Nan::ThrowError("You must pass an object to putAllAsync().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Local<Promise::Resolver> resolver(newResolver());
+  PromiseWorker<PutAllWorker> * worker = new PromiseWorker<PutAllWorker>(
+      resolver, Local<Object>(), regionPtr, cachePtr, regionCodecOptions(regionPtr), noCallback);
+  if (!worker->stagingBuffer.stageEntries(info[0]->ToObject())) {
+    delete worker;
+    return;
+  }
+  queueGemfireWorker(worker);
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
+NAN_METHOD(Region::RemoveAsync) {
+  Nan::HandleScope scope;
+
+  if (info.Length() != 1) {
+    Nan::ThrowError("You must pass a key to removeAsync().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  CachePtr cachePtr(getCacheFromRegion(region));
+  if (cachePtr == NULLPTR) {
+    return;
+  }
+
+  Local<Promise::Resolver> resolver(newResolver());
+  queueGemfireWorker(new PromiseWorker<RemoveWorker>(
+      resolver, Local<Object>(), regionPtr, gemfireKey(info[0], cachePtr), noCallback));
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
 NAN_METHOD(Region::ExecuteFunction) {
   Nan::HandleScope scope;
 
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   RegionPtr regionPtr(region->regionPtr);
 
-  CachePtr cachePtr(getCacheFromRegion(region->regionPtr));
+  CachePtr cachePtr(getCacheFromRegion(region));
   if (cachePtr == NULLPTR) {
     return;
   }
@@ -613,6 +1677,15 @@ NAN_GETTER(Region::Name) {
   info.GetReturnValue().Set(Nan::New(regionPtr->getName()).ToLocalChecked());
 }
 
+NAN_GETTER(Region::FullPath) {
+  Nan::HandleScope scope;
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  RegionPtr regionPtr(region->regionPtr);
+
+  info.GetReturnValue().Set(Nan::New(regionPtr->getFullPath()).ToLocalChecked());
+}
+
 NAN_GETTER(Region::Attributes) {
   Nan::HandleScope scope;
 
@@ -688,6 +1761,55 @@ NAN_GETTER(Region::Attributes) {
   info.GetReturnValue().Set(returnValue);
 }
 
+NAN_GETTER(Region::Codec) {
+  Nan::HandleScope scope;
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  ValueCodec codec(regionCodecOptions(region->regionPtr).codec);
+  info.GetReturnValue().Set(Nan::New(valueCodecName(codec)).ToLocalChecked());
+}
+
+NAN_METHOD(Region::SetCodec) {
+  Nan::HandleScope scope;
+
+  ValueCodec codec;
+  if (info.Length() != 1 || !info[0]->IsString() || !parseValueCodec(*Nan::Utf8String(info[0]), codec)) {
+    Nan::ThrowError("You must pass 'pdx' or 'msgpack' as the codec to setCodec().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  ValueCodecOptions codecOptions(regionCodecOptions(region->regionPtr));
+  codecOptions.codec = codec;
+  ValueCodecRegistry::getInstance()->set(region->regionPtr->getFullPath(), codecOptions);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+NAN_GETTER(Region::CompressionThreshold) {
+  Nan::HandleScope scope;
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  info.GetReturnValue().Set(Nan::New<Uint32>(regionCodecOptions(region->regionPtr).compressionThreshold));
+}
+
+NAN_METHOD(Region::SetCompressionThreshold) {
+  Nan::HandleScope scope;
+
+  if (info.Length() != 1 || !info[0]->IsNumber() || !(info[0]->NumberValue() >= 0) ||
+      info[0]->NumberValue() > UINT32_MAX) {
+    Nan::ThrowError("You must pass a number of bytes to setCompressionThreshold().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  ValueCodecOptions codecOptions(regionCodecOptions(region->regionPtr));
+  codecOptions.compressionThreshold = static_cast<uint32_t>(info[0]->NumberValue());
+  ValueCodecRegistry::getInstance()->set(region->regionPtr->getFullPath(), codecOptions);
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
 template <typename T>
 class AbstractQueryWorker : public GemfireWorker {
  public:
@@ -784,7 +1906,7 @@ NAN_METHOD(Region::Query) {
   Nan::Callback * callback = new Nan::Callback(info[1].As<Function>());
 
   T * worker = new T(region->regionPtr, queryPredicate, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -829,7 +1951,7 @@ NAN_METHOD(Region::ServerKeys) {
   Nan::Callback * callback = new Nan::Callback(info[0].As<Function>());
 
   ServerKeysWorker * worker = new ServerKeysWorker(region->regionPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 }
 
 class KeysWorker : public GemfireWorker {
@@ -872,7 +1994,7 @@ NAN_METHOD(Region::Keys) {
   Nan::Callback * callback = new Nan::Callback(info[0].As<Function>());
 
   KeysWorker * worker = new KeysWorker(region->regionPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 }
 
 NAN_METHOD(Region::RegisterAllKeys) {
@@ -901,23 +2023,27 @@ class ValuesWorker : public GemfireWorker {
  public:
   ValuesWorker(
       const RegionPtr & regionPtr,
+      ValueCodecOptions codecOptions,
       Nan::Callback * callback) :
     GemfireWorker(callback),
-    regionPtr(regionPtr) {}
+    regionPtr(regionPtr),
+    decodedValue(codecOptions) {}
 
   void ExecuteGemfireWork() {
     valuesVectorPtr = new VectorOfCacheable();
     regionPtr->values(*valuesVectorPtr);
+    decodedValue.decode(valuesVectorPtr);
   }
 
   void HandleOKCallback() {
-    Local<Value> argv[2] = { Nan::Undefined(), v8Value(valuesVectorPtr) };
+    Local<Value> argv[2] = { Nan::Undefined(), decodedValue.v8Value() };
     Nan::Call(*callback, 2, argv);
   }
 
  private:
   RegionPtr regionPtr;
   VectorOfCacheablePtr valuesVectorPtr;
+  DecodedValue decodedValue;
 };
 
 NAN_METHOD(Region::Values) {
@@ -936,34 +2062,38 @@ NAN_METHOD(Region::Values) {
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   Nan::Callback * callback = new Nan::Callback(info[0].As<Function>());
 
-  ValuesWorker * worker = new ValuesWorker(region->regionPtr, callback);
-  Nan::AsyncQueueWorker(worker);
+  ValuesWorker * worker =
+    new ValuesWorker(region->regionPtr, regionCodecOptions(region->regionPtr), callback);
+  queueGemfireWorker(worker);
 }
 
 class EntriesWorker : public GemfireWorker {
  public:
   EntriesWorker(
       const RegionPtr & regionPtr,
+      ValueCodecOptions codecOptions,
       Nan::Callback * callback,
       bool recursive = true) :
     GemfireWorker(callback),
     regionPtr(regionPtr),
-    recursive(recursive) {}
+    recursive(recursive),
+    decodedValue(codecOptions) {}
 
   void ExecuteGemfireWork() {
-    regionEntryVector = new VectorOfRegionEntry();
-    regionPtr->entries(*regionEntryVector, recursive);
+    regionPtr->entries(regionEntryVector, recursive);
+    decodedValue.decode(regionEntryVector);
   }
 
   void HandleOKCallback() {
-    Local<Value> argv[2] = { Nan::Undefined(), v8Value(*regionEntryVector) };
+    Local<Value> argv[2] = { Nan::Undefined(), decodedValue.v8Value() };
     Nan::Call(*callback, 2, argv);
   }
 
  private:
   RegionPtr regionPtr;
-  VectorOfRegionEntry* regionEntryVector;
+  VectorOfRegionEntry regionEntryVector;
   bool recursive;
+  DecodedValue decodedValue;
 };
 
 
@@ -983,8 +2113,30 @@ NAN_METHOD(Region::Entries) {
   Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
   Nan::Callback * callback = new Nan::Callback(info[0].As<Function>());
 
-  EntriesWorker * worker = new EntriesWorker(region->regionPtr, callback, true);
-  Nan::AsyncQueueWorker(worker);
+  EntriesWorker * worker =
+    new EntriesWorker(region->regionPtr, regionCodecOptions(region->regionPtr), callback, true);
+  queueGemfireWorker(worker);
+}
+
+NAN_METHOD(Region::OpenCursor) {
+  Nan::HandleScope scope;
+
+  RegionCursor::Source source;
+  if (info.Length() == 0 || !info[0]->IsString() ||
+      !RegionCursor::parseSource(*Nan::Utf8String(info[0]), source)) {
+    Nan::ThrowError("You must pass \"keys\", \"serverKeys\", \"values\" or \"entries\" to openCursor().");
+    return;
+  }
+
+  double batchSize = info[1]->IsUndefined() ? defaultCursorBatchSize : Nan::To<double>(info[1]).FromJust();
+  if (!info[1]->IsUndefined() && (!info[1]->IsNumber() || !(batchSize >= 1))) {
+    Nan::ThrowError("You must pass a positive batch size to openCursor().");
+    return;
+  }
+
+  Region * region = Nan::ObjectWrap::Unwrap<Region>(info.Holder());
+  info.GetReturnValue().Set(RegionCursor::NewInstance(
+      region->regionPtr, source, static_cast<size_t>(batchSize), regionCodecOptions(region->regionPtr)));
 }
 
 class DestroyRegionWorker : public GemfireEventedWorker {
@@ -1023,7 +2175,7 @@ NAN_METHOD(Region::DestroyRegion) {
 
   Nan::Callback * callback = getCallback(info[0]);
   DestroyRegionWorker * worker = new DestroyRegionWorker(info.Holder(), region, callback, false);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -1040,7 +2192,7 @@ NAN_METHOD(Region::LocalDestroyRegion) {
 
   Nan::Callback * callback = getCallback(info[0]);
   DestroyRegionWorker * worker = new DestroyRegionWorker(info.Holder(), region, callback);
-  Nan::AsyncQueueWorker(worker);
+  queueGemfireWorker(worker);
 
   info.GetReturnValue().Set(info.Holder());
 }
@@ -1056,6 +2208,15 @@ NAN_MODULE_INIT(Region::Init){
   Nan::SetPrototypeMethod(constructorTemplate, "clear", Region::Clear);
   Nan::SetPrototypeMethod(constructorTemplate, "put", Region::Put);
   Nan::SetPrototypeMethod(constructorTemplate, "putSync",Region::PutSync);
+  Nan::SetPrototypeMethod(constructorTemplate, "update", Region::Update);
+  Nan::SetPrototypeMethod(constructorTemplate, "putIfAbsent", Region::PutIfAbsent);
+  Nan::SetPrototypeMethod(constructorTemplate, "putIfAbsentSync", Region::PutIfAbsentSync);
+  Nan::SetPrototypeMethod(constructorTemplate, "replace", Region::Replace);
+  Nan::SetPrototypeMethod(constructorTemplate, "replaceSync", Region::ReplaceSync);
+  Nan::SetPrototypeMethod(constructorTemplate, "removeIfEquals", Region::RemoveIfEquals);
+  Nan::SetPrototypeMethod(constructorTemplate, "removeIfEqualsSync", Region::RemoveIfEqualsSync);
+  Nan::SetPrototypeMethod(constructorTemplate, "increment", Region::Increment);
+  Nan::SetPrototypeMethod(constructorTemplate, "incrementSync", Region::IncrementSync);
   Nan::SetPrototypeMethod(constructorTemplate, "get", Region::Get);
   Nan::SetPrototypeMethod(constructorTemplate, "getSync",Region::GetSync);
   Nan::SetPrototypeMethod(constructorTemplate, "getAll", Region::GetAll);
@@ -1063,6 +2224,10 @@ NAN_MODULE_INIT(Region::Init){
   Nan::SetPrototypeMethod(constructorTemplate, "entries", Region::Entries);
   Nan::SetPrototypeMethod(constructorTemplate, "putAll", Region::PutAll);
   Nan::SetPrototypeMethod(constructorTemplate, "putAllSync", Region::PutAllSync);
+  Nan::SetPrototypeMethod(constructorTemplate, "putJSON", Region::PutJSON);
+  Nan::SetPrototypeMethod(constructorTemplate, "getJSON", Region::GetJSON);
+  Nan::SetPrototypeMethod(constructorTemplate, "getAllJSON", Region::GetAllJSON);
+  Nan::SetPrototypeMethod(constructorTemplate, "putAllJSON", Region::PutAllJSON);
   Nan::SetPrototypeMethod(constructorTemplate, "remove", Region::Remove);
   Nan::SetPrototypeMethod(constructorTemplate, "query",  Region::Query<QueryWorker>);
   Nan::SetPrototypeMethod(constructorTemplate, "selectValue",  Region::Query<SelectValueWorker>);
@@ -1076,9 +2241,23 @@ NAN_MODULE_INIT(Region::Init){
   Nan::SetPrototypeMethod(constructorTemplate, "unregisterAllKeys",  Region::UnregisterAllKeys);
   Nan::SetPrototypeMethod(constructorTemplate, "destroyRegion", Region::DestroyRegion);
   Nan::SetPrototypeMethod(constructorTemplate, "localDestroyRegion",  Region::LocalDestroyRegion);
+  Nan::SetPrototypeMethod(constructorTemplate, "openCursor", Region::OpenCursor);
+  Nan::SetPrototypeMethod(constructorTemplate, "getAsync", Region::GetAsync);
+  Nan::SetPrototypeMethod(constructorTemplate, "getAllAsync", Region::GetAllAsync);
+  Nan::SetPrototypeMethod(constructorTemplate, "putAsync", Region::PutAsync);
+  Nan::SetPrototypeMethod(constructorTemplate, "putAllAsync", Region::PutAllAsync);
+  Nan::SetPrototypeMethod(constructorTemplate, "removeAsync", Region::RemoveAsync);
+  Nan::SetPrototypeMethod(constructorTemplate, "setCodec", Region::SetCodec);
+  Nan::SetPrototypeMethod(constructorTemplate, "setCompressionThreshold", Region::SetCompressionThreshold);
 
   Nan::SetAccessor(constructorTemplate->InstanceTemplate(), Nan::New<String>("name").ToLocalChecked(),  Region::Name);
   Nan::SetAccessor(constructorTemplate->InstanceTemplate(), Nan::New<String>("attributes").ToLocalChecked(),  Region::Attributes);
+  Nan::SetAccessor(constructorTemplate->InstanceTemplate(), Nan::New<String>("fullPath").ToLocalChecked(),
+                   Region::FullPath);
+  Nan::SetAccessor(constructorTemplate->InstanceTemplate(), Nan::New<String>("codec").ToLocalChecked(),
+                   Region::Codec);
+  Nan::SetAccessor(constructorTemplate->InstanceTemplate(),
+                   Nan::New<String>("compressionThreshold").ToLocalChecked(), Region::CompressionThreshold);
 
   constructor().Reset(Nan::GetFunction(constructorTemplate).ToLocalChecked());
 
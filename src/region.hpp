@@ -4,6 +4,7 @@
 #include <v8.h>
 #include <nan.h>
 #include <node.h>
+#include <geode/Cache.hpp>
 #include <geode/Region.hpp>
 #include "region_event_registry.hpp"
 
@@ -25,14 +26,33 @@ class Region : public Nan::ObjectWrap {
   static NAN_METHOD(Clear);
   static NAN_METHOD(Put);
   static NAN_METHOD(PutSync);
+  static NAN_METHOD(Update);
+  static NAN_METHOD(PutIfAbsent);
+  static NAN_METHOD(PutIfAbsentSync);
+  static NAN_METHOD(Replace);
+  static NAN_METHOD(ReplaceSync);
+  static NAN_METHOD(RemoveIfEquals);
+  static NAN_METHOD(RemoveIfEqualsSync);
+  static NAN_METHOD(Increment);
+  static NAN_METHOD(IncrementSync);
   static NAN_METHOD(Get);
   static NAN_METHOD(GetSync);
   static NAN_METHOD(GetAll);
   static NAN_METHOD(GetAllSync);
   static NAN_METHOD(Entries);
+  static NAN_METHOD(OpenCursor);
   static NAN_METHOD(PutAll);
   static NAN_METHOD(PutAllSync);
+  static NAN_METHOD(PutJSON);
+  static NAN_METHOD(GetJSON);
+  static NAN_METHOD(GetAllJSON);
+  static NAN_METHOD(PutAllJSON);
   static NAN_METHOD(Remove);
+  static NAN_METHOD(GetAsync);
+  static NAN_METHOD(GetAllAsync);
+  static NAN_METHOD(PutAsync);
+  static NAN_METHOD(PutAllAsync);
+  static NAN_METHOD(RemoveAsync);
   static NAN_METHOD(ServerKeys);
   static NAN_METHOD(Keys);
   static NAN_METHOD(Values);
@@ -42,13 +62,20 @@ class Region : public Nan::ObjectWrap {
   static NAN_METHOD(DestroyRegion);
   static NAN_METHOD(LocalDestroyRegion);
   static NAN_METHOD(Inspect);
+  static NAN_METHOD(SetCodec);
+  static NAN_METHOD(SetCompressionThreshold);
   static NAN_GETTER(Name);
+  static NAN_GETTER(FullPath);
   static NAN_GETTER(Attributes);
+  static NAN_GETTER(Codec);
+  static NAN_GETTER(CompressionThreshold);
 
   template<typename T>
   static NAN_METHOD(Query);
 
   apache::geode::client::RegionPtr regionPtr;
+  // Set by getCacheFromRegion() the first time it is needed.
+  apache::geode::client::CachePtr cachePtr;
 
   private:
     static inline Nan::Persistent<v8::Function> & constructor() {
@@ -0,0 +1,214 @@
+#include "region_cursor.hpp"
+#include "gemfire_executor.hpp"
+#include "gemfire_worker.hpp"
+
+using namespace v8;
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+bool RegionCursor::parseSource(const std::string & sourceName, Source & source) {
+  if (sourceName == "keys") {
+    source = KEYS;
+  } else if (sourceName == "serverKeys") {
+    source = SERVER_KEYS;
+  } else if (sourceName == "values") {
+    source = VALUES;
+  } else if (sourceName == "entries") {
+    source = ENTRIES;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void RegionCursor::load() {
+  if (loaded) {
+    return;
+  }
+
+  switch (source) {
+    case KEYS:
+      regionPtr->keys(keys);
+      break;
+    case SERVER_KEYS:
+      regionPtr->serverKeys(keys);
+      break;
+    case VALUES:
+      regionPtr->values(values);
+      break;
+    case ENTRIES:
+      regionPtr->entries(entries, true);
+      break;
+  }
+  loaded = true;
+}
+
+size_t RegionCursor::size() const {
+  switch (source) {
+    case VALUES:
+      return values.size();
+    case ENTRIES:
+      return entries.size();
+    default:
+      return keys.size();
+  }
+}
+
+bool RegionCursor::decodeNextBatch(DecodedValue & decodedValue) {
+  // A cursor closed before its first batch never reads the region.
+  if (closed) {
+    release();
+    return false;
+  }
+
+  load();
+
+  size_t end = position + batchSize < size() ? position + batchSize : size();
+  if (position == end) {
+    release();
+    return false;
+  }
+
+  // Items are cleared as they are handed out, so that their GemFire objects can be freed.
+  if (source == ENTRIES) {
+    VectorOfRegionEntry batch;
+    for (size_t i = position; i < end; i++) {
+      batch.push_back(entries[i]);
+      entries[i] = NULLPTR;
+    }
+    decodedValue.decode(batch);
+  } else {
+    VectorOfCacheablePtr batchPtr(new VectorOfCacheable());
+    for (size_t i = position; i < end; i++) {
+      if (source == VALUES) {
+        batchPtr->push_back(values[i]);
+        values[i] = NULLPTR;
+      } else {
+        batchPtr->push_back(CacheablePtr(keys[i]));
+        keys[i] = NULLPTR;
+      }
+    }
+    decodedValue.decode(batchPtr);
+  }
+
+  position = end;
+  return true;
+}
+
+void RegionCursor::release() {
+  keys.clear();
+  values.clear();
+  entries.clear();
+  closed = true;
+}
+
+void RegionCursor::batchDone() {
+  busy = false;
+  if (closeRequested) {
+    release();
+  }
+}
+
+class CursorBatchWorker : public GemfireWorker {
+ public:
+  CursorBatchWorker(const Local<Object> & cursorObject, RegionCursor * cursor, Nan::Callback * callback) :
+      GemfireWorker(callback),
+      cursor(cursor),
+      // Keys are never stored through a codec.
+      decodedValue(cursor->source == RegionCursor::VALUES || cursor->source == RegionCursor::ENTRIES ?
+                   cursor->codecOptions : ValueCodecOptions()),
+      decoded(false) {
+    SaveToPersistent("cursor", cursorObject);
+    cursor->busy = true;
+  }
+
+  void ExecuteGemfireWork() {
+    decoded = cursor->decodeNextBatch(decodedValue);
+  }
+
+  void HandleOKCallback() {
+    Nan::HandleScope scope;
+    cursor->batchDone();
+    Local<Value> argv[2] = {
+      Nan::Undefined(),
+      decoded ? decodedValue.v8Value() : Nan::Null()
+    };
+    Nan::Call(*callback, 2, argv);
+  }
+
+  void HandleErrorCallback() {
+    cursor->batchDone();
+    GemfireWorker::HandleErrorCallback();
+  }
+
+ private:
+  RegionCursor * cursor;
+  DecodedValue decodedValue;
+  bool decoded;
+};
+
+NAN_MODULE_INIT(RegionCursor::Init) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> constructorTemplate = Nan::New<FunctionTemplate>();
+
+  constructorTemplate->SetClassName(Nan::New("RegionCursor").ToLocalChecked());
+  constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
+
+  Nan::SetPrototypeMethod(constructorTemplate, "next", RegionCursor::Next);
+  Nan::SetPrototypeMethod(constructorTemplate, "close", RegionCursor::Close);
+
+  constructor().Reset(Nan::GetFunction(constructorTemplate).ToLocalChecked());
+
+  Nan::Set(target, Nan::New("RegionCursor").ToLocalChecked(),
+           Nan::GetFunction(constructorTemplate).ToLocalChecked());
+}
+
+Local<Object> RegionCursor::NewInstance(const RegionPtr & regionPtr, Source source, size_t batchSize,
+                                        const ValueCodecOptions & codecOptions) {
+  Nan::EscapableHandleScope scope;
+  const unsigned int argc = 0;
+  Local<Value> argv[argc] = {};
+  Local<Object> instance(Nan::New(RegionCursor::constructor())->NewInstance(argc, argv));
+  RegionCursor * cursor = new RegionCursor(regionPtr, source, batchSize, codecOptions);
+  cursor->Wrap(instance);
+
+  return scope.Escape(instance);
+}
+
+NAN_METHOD(RegionCursor::Next) {
+  Nan::HandleScope scope;
+
+  if (info.Length() == 0 || !info[0]->IsFunction()) {
+    Nan::ThrowError("You must pass a function as the callback to next().");
+    return;
+  }
+
+  RegionCursor * cursor = Nan::ObjectWrap::Unwrap<RegionCursor>(info.Holder());
+  if (cursor->busy) {
+    Nan::ThrowError("You must wait for the previous batch before calling next().");
+    return;
+  }
+
+  Nan::Callback * callback = new Nan::Callback(info[0].As<Function>());
+  queueGemfireWorker(new CursorBatchWorker(info.Holder(), cursor, callback));
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+// Frees the remaining items. A batch being decoded is still passed to its callback.
+NAN_METHOD(RegionCursor::Close) {
+  Nan::HandleScope scope;
+
+  RegionCursor * cursor = Nan::ObjectWrap::Unwrap<RegionCursor>(info.Holder());
+  if (cursor->busy) {
+    cursor->closeRequested = true;
+  } else {
+    cursor->release();
+  }
+
+  info.GetReturnValue().Set(info.Holder());
+}
+
+}  // namespace node_gemfire
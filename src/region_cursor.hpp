@@ -0,0 +1,84 @@
+#ifndef __REGION_CURSOR_HPP__
+#define __REGION_CURSOR_HPP__
+
+#include <v8.h>
+#include <nan.h>
+#include <geode/GeodeCppCache.hpp>
+#include <cstddef>
+#include <string>
+#include "decoded_value.hpp"
+#include "value_codec.hpp"
+
+namespace node_gemfire {
+
+// Hands out the keys, server keys, values or entries of a region in batches. GemFire returns them
+// as one vector, which is fetched on the worker thread by the first next(); each later next()
+// decodes only the following batch on the worker thread, and lets go of the GemFire objects it
+// decoded. Only one batch is decoded at a time, so a slow consumer holds up the cursor instead of
+// piling up JavaScript objects.
+class RegionCursor : public Nan::ObjectWrap {
+ public:
+  enum Source {
+    KEYS,
+    SERVER_KEYS,
+    VALUES,
+    ENTRIES
+  };
+
+  static bool parseSource(const std::string & sourceName, Source & source);
+
+  RegionCursor(const apache::geode::client::RegionPtr & regionPtr, Source source, size_t batchSize,
+               const ValueCodecOptions & codecOptions) :
+    regionPtr(regionPtr),
+    source(source),
+    batchSize(batchSize),
+    codecOptions(codecOptions),
+    loaded(false),
+    busy(false),
+    closed(false),
+    closeRequested(false),
+    position(0) {}
+
+  static NAN_MODULE_INIT(Init);
+  static v8::Local<v8::Object> NewInstance(const apache::geode::client::RegionPtr & regionPtr,
+                                           Source source, size_t batchSize,
+                                           const ValueCodecOptions & codecOptions);
+
+  static NAN_METHOD(Next);
+  static NAN_METHOD(Close);
+
+ private:
+  friend class CursorBatchWorker;
+
+  // Called on the worker thread while busy. Returns false once every item has been handed out.
+  bool decodeNextBatch(DecodedValue & decodedValue);
+  void load();
+  void release();
+  // Called on the JavaScript thread once a batch has been decoded.
+  void batchDone();
+  size_t size() const;
+
+  apache::geode::client::RegionPtr regionPtr;
+  Source source;
+  size_t batchSize;
+  ValueCodecOptions codecOptions;
+
+  bool loaded;
+  bool busy;
+  bool closed;
+  // Set by close() while a batch is being decoded; only touched on the JavaScript thread.
+  bool closeRequested;
+  size_t position;
+  apache::geode::client::VectorOfCacheableKey keys;
+  apache::geode::client::VectorOfCacheable values;
+  apache::geode::client::VectorOfRegionEntry entries;
+
+  static inline Nan::Persistent<v8::Function> & constructor() {
+    static Nan::Persistent<v8::Function> my_constructor;
+    return my_constructor;
+  }
+};
+
+}  // namespace node_gemfire
+
+#endif
@@ -0,0 +1,105 @@
+#include "schema_registry.hpp"
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+namespace node_gemfire {
+
+namespace {
+
+struct SchemaFieldTypeName {
+  const char * name;
+  SchemaFieldType type;
+};
+
+const SchemaFieldTypeName schemaFieldTypeNames[] = {
+  { "boolean", BOOLEAN_FIELD },
+  { "byte", BYTE_FIELD },
+  { "short", SHORT_FIELD },
+  { "int", INT_FIELD },
+  { "long", LONG_FIELD },
+  { "float", FLOAT_FIELD },
+  { "double", DOUBLE_FIELD },
+  { "string", STRING_FIELD },
+  { "date", DATE_FIELD },
+  { "object", OBJECT_FIELD },
+  { "boolean[]", BOOLEAN_ARRAY_FIELD },
+  { "byte[]", BYTE_ARRAY_FIELD },
+  { "short[]", SHORT_ARRAY_FIELD },
+  { "int[]", INT_ARRAY_FIELD },
+  { "long[]", LONG_ARRAY_FIELD },
+  { "float[]", FLOAT_ARRAY_FIELD },
+  { "double[]", DOUBLE_ARRAY_FIELD },
+  { "string[]", STRING_ARRAY_FIELD },
+  { "object[]", OBJECT_ARRAY_FIELD }
+};
+
+const size_t schemaFieldTypeCount = sizeof(schemaFieldTypeNames) / sizeof(schemaFieldTypeNames[0]);
+
+std::vector<const char *> fieldNamesOf(const std::vector<PdxSchema::Field> & fields) {
+  std::vector<const char *> names;
+  names.reserve(fields.size());
+  for (size_t i = 0; i < fields.size(); i++) {
+    names.push_back(fields[i].name.c_str());
+  }
+  return names;
+}
+
+}  // namespace
+
+bool parseSchemaFieldType(const std::string & typeName, SchemaFieldType & type) {
+  for (size_t i = 0; i < schemaFieldTypeCount; i++) {
+    if (typeName == schemaFieldTypeNames[i].name) {
+      type = schemaFieldTypeNames[i].type;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char * schemaFieldTypeName(SchemaFieldType type) {
+  for (size_t i = 0; i < schemaFieldTypeCount; i++) {
+    if (schemaFieldTypeNames[i].type == type) {
+      return schemaFieldTypeNames[i].name;
+    }
+  }
+  return "unknown";
+}
+
+PdxSchema::PdxSchema(const std::string & className, const std::vector<Field> & fields) :
+  className(className),
+  fields(fields),
+  fieldNames(new InternedFieldNames(fieldNamesOf(fields))) {}
+
+SchemaRegistry * SchemaRegistry::getInstance() {
+  // Deliberately never destroyed, like the FieldNameCache, because schemas hold Persistent handles.
+  static SchemaRegistry * instance = new SchemaRegistry();
+  return instance;
+}
+
+Local<Symbol> SchemaRegistry::symbol() {
+  static Nan::Persistent<Symbol> * schemaSymbol = NULL;
+
+  if (schemaSymbol == NULL) {
+    Local<Symbol> v8Symbol(
+        Symbol::For(Isolate::GetCurrent(), Nan::New("gemfire.schema").ToLocalChecked()));
+    schemaSymbol = new Nan::Persistent<Symbol>(v8Symbol);
+  }
+
+  return Nan::New(*schemaSymbol);
+}
+
+void SchemaRegistry::add(const PdxSchemaPtr & schema) {
+  schemas[schema->className] = schema;
+}
+
+PdxSchemaPtr SchemaRegistry::find(const std::string & className) const {
+  std::unordered_map<std::string, PdxSchemaPtr>::const_iterator iterator(schemas.find(className));
+  if (iterator == schemas.end()) {
+    return PdxSchemaPtr();
+  }
+  return iterator->second;
+}
+
+}  // namespace node_gemfire
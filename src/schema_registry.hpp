@@ -0,0 +1,82 @@
+#ifndef __SCHEMA_REGISTRY_HPP__
+#define __SCHEMA_REGISTRY_HPP__
+
+#include <v8.h>
+#include <nan.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "field_name_cache.hpp"
+
+namespace node_gemfire {
+
+enum SchemaFieldType {
+  BOOLEAN_FIELD,
+  BYTE_FIELD,
+  SHORT_FIELD,
+  INT_FIELD,
+  LONG_FIELD,
+  FLOAT_FIELD,
+  DOUBLE_FIELD,
+  STRING_FIELD,
+  DATE_FIELD,
+  OBJECT_FIELD,
+  BOOLEAN_ARRAY_FIELD,
+  BYTE_ARRAY_FIELD,
+  SHORT_ARRAY_FIELD,
+  INT_ARRAY_FIELD,
+  LONG_ARRAY_FIELD,
+  FLOAT_ARRAY_FIELD,
+  DOUBLE_ARRAY_FIELD,
+  STRING_ARRAY_FIELD,
+  OBJECT_ARRAY_FIELD
+};
+
+// Parses a type name given to cache.registerSchema(), such as "long" or "string[]".
+bool parseSchemaFieldType(const std::string & typeName, SchemaFieldType & type);
+const char * schemaFieldTypeName(SchemaFieldType type);
+
+// The field plan of a registered schema. Objects tagged with the schema's name are written with
+// the typed PdxInstanceFactory methods, in this field order, instead of as OBJECT fields.
+class PdxSchema {
+ public:
+  struct Field {
+    Field(const std::string & name, SchemaFieldType type) :
+      name(name),
+      type(type) {}
+
+    std::string name;
+    SchemaFieldType type;
+  };
+
+  PdxSchema(const std::string & className, const std::vector<Field> & fields);
+
+  const std::string className;
+  const std::vector<Field> fields;
+  // The field names as V8 strings, for reading the fields of tagged objects.
+  const InternedFieldNamesPtr fieldNames;
+};
+
+typedef std::shared_ptr<const PdxSchema> PdxSchemaPtr;
+
+// Only ever touched from the JavaScript thread; staged values hold on to the schemas they use.
+class SchemaRegistry {
+ public:
+  static SchemaRegistry * getInstance();
+
+  // The value of Symbol.for("gemfire.schema"), under which an object names its schema.
+  static v8::Local<v8::Symbol> symbol();
+
+  void add(const PdxSchemaPtr & schema);
+  PdxSchemaPtr find(const std::string & className) const;
+
+  bool empty() const { return schemas.empty(); }
+
+ private:
+  std::unordered_map<std::string, PdxSchemaPtr> schemas;
+};
+
+}  // namespace node_gemfire
+
+#endif
@@ -0,0 +1,1240 @@
+#include "staging_buffer.hpp"
+#include <nan.h>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "conversions.hpp"
+#include "string_conversions.hpp"
+
+using namespace v8;
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+bool isPrimitiveArray(const Local<Value> & v8Value) {
+  return v8Value->IsUint8Array() ||
+    v8Value->IsInt16Array() ||
+    v8Value->IsInt32Array() ||
+    v8Value->IsFloat32Array() ||
+#if NODE_GEMFIRE_HAS_BIGINT
+    v8Value->IsBigInt64Array() ||
+#endif
+    v8Value->IsFloat64Array();
+}
+
+uint8_t * StagingBuffer::reserve(size_t byteLength, size_t alignment) {
+  size_t offset = bytes.size();
+  offset += (alignment - offset % alignment) % alignment;
+  bytes.resize(offset + byteLength);
+  return bytes.data() + offset;
+}
+
+const uint8_t * StagingBuffer::consume(size_t byteLength, size_t alignment) {
+  cursor += (alignment - cursor % alignment) % alignment;
+  const uint8_t * data = bytes.data() + cursor;
+  cursor += byteLength;
+  return data;
+}
+
+bool StagingBuffer::stage(const Local<Value> & v8Value) {
+  if (v8Value->IsString() || v8Value->IsStringObject()) {
+    stageString(v8Value->ToString());
+  } else if (v8Value->IsBoolean()) {
+    stageBoolean(v8Value->ToBoolean()->Value());
+  } else if (v8Value->IsNumber() || v8Value->IsNumberObject()) {
+    stageNumber(v8Value->ToNumber()->Value());
+  } else if (v8Value->IsDate()) {
+    write<uint8_t>(DATE);
+    write<double>(Local<Date>::Cast(v8Value)->NumberValue());
+  } else if (v8Value->IsArray()) {
+    Local<Array> v8Array(Local<Array>::Cast(v8Value));
+    uint32_t length = v8Array->Length();
+    stageArrayStart(length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!stage(v8Array->Get(i))) {
+        return false;
+      }
+    }
+  } else if (isPrimitiveArray(v8Value)) {
+    return stageArrayBufferView(Local<ArrayBufferView>::Cast(v8Value));
+  } else if (v8Value->IsBooleanObject()) {
+    write<uint8_t>(BOOLEAN);
+#if (NODE_MODULE_VERSION > 0x000B)
+    write<uint8_t>(BooleanObject::Cast(*v8Value)->ValueOf());
+#else
+    write<uint8_t>(BooleanObject::Cast(*v8Value)->BooleanValue());
+#endif
+  } else if (v8Value->IsFunction()) {
+    Nan::ThrowError("Unable to serialize to GemFire; functions are not supported.");
+    return false;
+  } else if (v8Value->IsObject()) {
+    return stageObject(v8Value->ToObject());
+#if NODE_GEMFIRE_HAS_BIGINT
+  } else if (v8Value->IsBigInt()) {
+    bool lossless;
+    int64_t value = v8Value.As<BigInt>()->Int64Value(&lossless);
+    if (!lossless) {
+      Nan::ThrowRangeError("Unable to serialize to GemFire; BigInt does not fit in a 64 bit integer.");
+      return false;
+    }
+    write<uint8_t>(INT64);
+    write<int64_t>(value);
+#endif
+  } else if (v8Value->IsUndefined()) {
+    write<uint8_t>(UNDEFINED_VALUE);
+  } else if (v8Value->IsNull()) {
+    stageNull();
+  } else {
+    std::string errorMessage("Unable to serialize to GemFire; unknown JavaScript object: ");
+    errorMessage.append(*Nan::Utf8String(v8Value->ToDetailString()));
+    Nan::ThrowError(errorMessage.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+bool StagingBuffer::stageObject(const Local<Object> & v8Object) {
+  Nan::HandleScope scope;
+
+  // Looking up the schema tag costs a property access, so it is only done once a schema exists.
+  if (!SchemaRegistry::getInstance()->empty()) {
+    Local<Value> schemaName(Nan::Get(v8Object, SchemaRegistry::symbol()).ToLocalChecked());
+    if (!schemaName->IsUndefined()) {
+      return stageSchemaObject(v8Object, schemaName);
+    }
+  }
+
+  Local<Array> v8Keys(v8Object->GetOwnPropertyNames());
+  unsigned int length = v8Keys->Length();
+
+  std::vector<Local<Value> > v8Values;
+  v8Values.reserve(length);
+  std::string shapeKey;
+
+  for (unsigned int i = 0; i < length; i++) {
+    Local<Value> v8Key(v8Keys->Get(i));
+    Local<Value> v8Value(v8Object->Get(v8Key));
+    Nan::Utf8String fieldName(v8Key);
+    PdxTypeCache::appendToShapeKey(shapeKey, *fieldName, fieldName.length(),
+                                   v8Value->IsArray() && !v8Value->IsString());
+    v8Values.push_back(v8Value);
+  }
+
+  stageObjectStart(shapeKey);
+
+  for (unsigned int i = 0; i < length; i++) {
+    if (!stage(v8Values[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// Lone surrogates are kept as three byte sequences, which V8 reads back as U+FFFD.
+void appendUtf8(std::vector<uint8_t> & utf8, uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    utf8.push_back(codePoint);
+  } else if (codePoint < 0x800) {
+    utf8.push_back(0xC0 | (codePoint >> 6));
+    utf8.push_back(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    utf8.push_back(0xE0 | (codePoint >> 12));
+    utf8.push_back(0x80 | ((codePoint >> 6) & 0x3F));
+    utf8.push_back(0x80 | (codePoint & 0x3F));
+  } else {
+    utf8.push_back(0xF0 | (codePoint >> 18));
+    utf8.push_back(0x80 | ((codePoint >> 12) & 0x3F));
+    utf8.push_back(0x80 | ((codePoint >> 6) & 0x3F));
+    utf8.push_back(0x80 | (codePoint & 0x3F));
+  }
+}
+
+bool schemaFieldError(const PdxSchema & schema, size_t index) {
+  std::string errorMessage("Unable to serialize to GemFire; field '");
+  errorMessage += schema.fields[index].name;
+  errorMessage += "' of schema '";
+  errorMessage += schema.className;
+  errorMessage += "' must be of type ";
+  errorMessage += schemaFieldTypeName(schema.fields[index].type);
+  errorMessage += '.';
+  Nan::ThrowTypeError(errorMessage.c_str());
+  return false;
+}
+
+// Accepts integral Numbers, and BigInts where supported, within [minimum, maximum].
+bool schemaInteger(const Local<Value> & v8Value, int64_t minimum, int64_t maximum, int64_t & value) {
+  if (v8Value->IsNumber()) {
+    double number = v8Value->NumberValue();
+    if (number != std::trunc(number) ||
+        number < static_cast<double>(minimum) ||
+        number > static_cast<double>(maximum) ||
+        number == 9223372036854775808.0) {
+      return false;
+    }
+    value = static_cast<int64_t>(number);
+    return true;
+  }
+
+#if NODE_GEMFIRE_HAS_BIGINT
+  if (v8Value->IsBigInt()) {
+    bool lossless;
+    value = v8Value.As<BigInt>()->Int64Value(&lossless);
+    return lossless && value >= minimum && value <= maximum;
+  }
+#endif
+
+  return false;
+}
+
+bool schemaIntegerRange(SchemaFieldType type, int64_t & minimum, int64_t & maximum) {
+  switch (type) {
+    case BYTE_FIELD:
+    case BYTE_ARRAY_FIELD:
+      minimum = INT8_MIN;
+      maximum = INT8_MAX;
+      return true;
+    case SHORT_FIELD:
+    case SHORT_ARRAY_FIELD:
+      minimum = INT16_MIN;
+      maximum = INT16_MAX;
+      return true;
+    case INT_FIELD:
+    case INT_ARRAY_FIELD:
+      minimum = INT32_MIN;
+      maximum = INT32_MAX;
+      return true;
+    case LONG_FIELD:
+    case LONG_ARRAY_FIELD:
+      minimum = INT64_MIN;
+      maximum = INT64_MAX;
+      return true;
+    default:
+      return false;
+  }
+}
+
+size_t schemaArrayElementSize(SchemaFieldType type) {
+  switch (type) {
+    case BOOLEAN_ARRAY_FIELD:
+    case BYTE_ARRAY_FIELD:
+      return sizeof(int8_t);
+    case SHORT_ARRAY_FIELD:
+      return sizeof(int16_t);
+    case INT_ARRAY_FIELD:
+      return sizeof(int32_t);
+    case FLOAT_ARRAY_FIELD:
+      return sizeof(float);
+    default:
+      return sizeof(int64_t);
+  }
+}
+
+// Typed arrays whose elements already have the Java representation are copied in one step.
+bool matchesTypedArray(SchemaFieldType type, const Local<Value> & v8Value) {
+  switch (type) {
+    case BYTE_ARRAY_FIELD:
+      return v8Value->IsUint8Array() || v8Value->IsInt8Array();
+    case SHORT_ARRAY_FIELD:
+      return v8Value->IsInt16Array();
+    case INT_ARRAY_FIELD:
+      return v8Value->IsInt32Array();
+    case FLOAT_ARRAY_FIELD:
+      return v8Value->IsFloat32Array();
+    case DOUBLE_ARRAY_FIELD:
+      return v8Value->IsFloat64Array();
+#if NODE_GEMFIRE_HAS_BIGINT
+    case LONG_ARRAY_FIELD:
+      return v8Value->IsBigInt64Array();
+#endif
+    default:
+      return false;
+  }
+}
+
+template<typename T>
+void writeArrayElement(uint8_t * data, uint32_t index, T value) {
+  memcpy(data + (index * sizeof(T)), &value, sizeof(T));
+}
+
+}  // namespace
+
+bool StagingBuffer::stageSchemaObject(const Local<Object> & v8Object, const Local<Value> & schemaName) {
+  Nan::HandleScope scope;
+
+  PdxSchemaPtr schema;
+  if (schemaName->IsString()) {
+    schema = SchemaRegistry::getInstance()->find(*Nan::Utf8String(schemaName));
+  }
+
+  if (!schema) {
+    std::string errorMessage("Unable to serialize to GemFire; unknown schema: ");
+    errorMessage.append(*Nan::Utf8String(schemaName->ToDetailString()));
+    Nan::ThrowError(errorMessage.c_str());
+    return false;
+  }
+
+  write<uint8_t>(SCHEMA_OBJECT);
+  write<uint32_t>(schemas.size());
+  schemas.push_back(schema);
+
+  size_t length = schema->fields.size();
+  for (size_t i = 0; i < length; i++) {
+    Local<Value> v8Value(Nan::Get(v8Object, schema->fieldNames->get(i)).ToLocalChecked());
+    if (!stageSchemaField(*schema, i, v8Value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Missing (null or undefined) fields get the Java default of their type: false, zero, null, or an
+// empty array.
+bool StagingBuffer::stageSchemaField(const PdxSchema & schema, size_t index, const Local<Value> & v8Value) {
+  SchemaFieldType type = schema.fields[index].type;
+  bool missing = v8Value->IsNull() || v8Value->IsUndefined();
+
+  switch (type) {
+    case BOOLEAN_FIELD:
+      if (!missing && !v8Value->IsBoolean()) {
+        return schemaFieldError(schema, index);
+      }
+      write<uint8_t>(!missing && v8Value->BooleanValue());
+      return true;
+    case BYTE_FIELD:
+    case SHORT_FIELD:
+    case INT_FIELD:
+    case LONG_FIELD: {
+      int64_t minimum, maximum;
+      schemaIntegerRange(type, minimum, maximum);
+      int64_t value = 0;
+      if (!missing && !schemaInteger(v8Value, minimum, maximum, value)) {
+        return schemaFieldError(schema, index);
+      }
+      write<int64_t>(value);
+      return true;
+    }
+    case FLOAT_FIELD:
+    case DOUBLE_FIELD:
+      if (!missing && !v8Value->IsNumber()) {
+        return schemaFieldError(schema, index);
+      }
+      write<double>(missing ? 0 : v8Value->NumberValue());
+      return true;
+    case STRING_FIELD:
+      if (missing) {
+        stageNull();
+      } else if (v8Value->IsString()) {
+        stageString(v8Value.As<String>());
+      } else {
+        return schemaFieldError(schema, index);
+      }
+      return true;
+    case DATE_FIELD: {
+      if (!missing && !v8Value->IsDate()) {
+        return schemaFieldError(schema, index);
+      }
+      // An invalid Date has no time to store, and is written as null.
+      double milliseconds = missing ? 0 : v8Value.As<Date>()->ValueOf();
+      bool present = !missing && !std::isnan(milliseconds);
+      write<uint8_t>(present);
+      if (present) {
+        write<double>(milliseconds);
+      }
+      return true;
+    }
+    case OBJECT_FIELD:
+      return stage(v8Value);
+    default:
+      return stageSchemaArray(schema, index, v8Value);
+  }
+}
+
+bool StagingBuffer::stageSchemaArray(const PdxSchema & schema, size_t index, const Local<Value> & v8Value) {
+  SchemaFieldType type = schema.fields[index].type;
+
+  if (v8Value->IsNull() || v8Value->IsUndefined()) {
+    write<uint32_t>(0);
+    return true;
+  }
+
+  size_t elementSize = schemaArrayElementSize(type);
+
+  if (matchesTypedArray(type, v8Value)) {
+    Local<ArrayBufferView> v8ArrayBufferView(v8Value.As<ArrayBufferView>());
+    size_t byteLength = v8ArrayBufferView->ByteLength();
+    write<uint32_t>(byteLength / elementSize);
+    v8ArrayBufferView->CopyContents(reserve(byteLength, sizeof(uint64_t)), byteLength);
+    return true;
+  }
+
+  if (!v8Value->IsArray()) {
+    return schemaFieldError(schema, index);
+  }
+
+  Local<Array> v8Array(v8Value.As<Array>());
+  uint32_t length = v8Array->Length();
+  write<uint32_t>(length);
+
+  if (type == STRING_ARRAY_FIELD || type == OBJECT_ARRAY_FIELD) {
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> element(v8Array->Get(i));
+      if (type == OBJECT_ARRAY_FIELD) {
+        if (!stage(element)) {
+          return false;
+        }
+      } else if (element->IsString()) {
+        stageString(element.As<String>());
+      } else {
+        return schemaFieldError(schema, index);
+      }
+    }
+    return true;
+  }
+
+  uint8_t * data = reserve(length * elementSize, sizeof(uint64_t));
+  int64_t minimum, maximum;
+  bool isInteger = schemaIntegerRange(type, minimum, maximum);
+
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> element(v8Array->Get(i));
+
+    if (isInteger) {
+      int64_t value;
+      if (!schemaInteger(element, minimum, maximum, value)) {
+        return schemaFieldError(schema, index);
+      }
+      switch (type) {
+        case BYTE_ARRAY_FIELD:
+          writeArrayElement<int8_t>(data, i, value);
+          break;
+        case SHORT_ARRAY_FIELD:
+          writeArrayElement<int16_t>(data, i, value);
+          break;
+        case INT_ARRAY_FIELD:
+          writeArrayElement<int32_t>(data, i, value);
+          break;
+        default:
+          writeArrayElement<int64_t>(data, i, value);
+      }
+    } else if (type == BOOLEAN_ARRAY_FIELD) {
+      if (!element->IsBoolean()) {
+        return schemaFieldError(schema, index);
+      }
+      writeArrayElement<uint8_t>(data, i, element->BooleanValue());
+    } else {
+      if (!element->IsNumber()) {
+        return schemaFieldError(schema, index);
+      }
+      if (type == FLOAT_ARRAY_FIELD) {
+        writeArrayElement<float>(data, i, element->NumberValue());
+      } else {
+        writeArrayElement<double>(data, i, element->NumberValue());
+      }
+    }
+  }
+  return true;
+}
+
+bool StagingBuffer::stageEntries(const Local<Object> & v8Object) {
+  Nan::HandleScope scope;
+
+  if (v8Object->IsMap()) {
+    // AsArray() flattens the entries into [key, value, key, value, ...].
+    Local<Array> v8Entries(v8Object.As<v8::Map>()->AsArray());
+    uint32_t length = v8Entries->Length() / 2;
+
+    stageEntriesStart(length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!stageKey(v8Entries->Get(2 * i)) || !stage(v8Entries->Get(2 * i + 1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (v8Object->IsArray()) {
+    Local<Array> v8Pairs(v8Object.As<Array>());
+    uint32_t length = v8Pairs->Length();
+
+    stageEntriesStart(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> v8Pair(v8Pairs->Get(i));
+      if (!v8Pair->IsArray() || v8Pair.As<Array>()->Length() != 2) {
+        Nan::ThrowError("Unable to serialize to GemFire; entries must be [key, value] pairs.");
+        return false;
+      }
+
+      Local<Array> v8Entry(v8Pair.As<Array>());
+      if (!stageKey(v8Entry->Get(0)) || !stage(v8Entry->Get(1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Local<Array> v8Keys(v8Object->GetOwnPropertyNames());
+  uint32_t length = v8Keys->Length();
+
+  stageEntriesStart(length);
+  for (uint32_t i = 0; i < length; i++) {
+    Local<String> v8Key(v8Keys->Get(i)->ToString());
+    stageString(v8Key);
+    if (!stage(v8Object->Get(v8Key))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Keys are staged the way gemfireKey() converts them, which uses the key encoding for Numbers
+// rather than the number encoding of values.
+bool StagingBuffer::stageKey(const Local<Value> & v8Key) {
+  if (v8Key->IsNull() || v8Key->IsUndefined()) {
+    Nan::ThrowError("Invalid GemFire key.");
+    return false;
+  }
+
+  if (v8Key->IsNumber()) {
+    stageNumber(v8Key->NumberValue(), keyEncoding);
+    return true;
+  }
+  return stage(v8Key);
+}
+
+void StagingBuffer::stageNull() {
+  write<uint8_t>(NULL_VALUE);
+}
+
+void StagingBuffer::stageBoolean(bool value) {
+  write<uint8_t>(BOOLEAN);
+  write<uint8_t>(value);
+}
+
+void StagingBuffer::stageDouble(double value) {
+  write<uint8_t>(DOUBLE);
+  write<double>(value);
+}
+
+void StagingBuffer::stageNumber(double value) {
+  stageNumber(value, numberEncoding);
+}
+
+void StagingBuffer::stageNumber(double value, NumberEncoding encoding) {
+  if (encoding == NUMBER_AS_COMPACT) {
+    switch (compactNumberType(value)) {
+      case COMPACT_INT32:
+        write<uint8_t>(INT32);
+        write<int32_t>(static_cast<int32_t>(value));
+        return;
+      case COMPACT_INT64:
+        write<uint8_t>(INT64);
+        write<int64_t>(static_cast<int64_t>(value));
+        return;
+      default:
+        break;
+    }
+  }
+
+  stageDouble(value);
+}
+
+// The text is expected to be valid UTF-8, except that lone surrogates may be encoded as three byte
+// sequences, as JSON escapes allow.
+void StagingBuffer::stageUtf8String(const char * data, size_t length) {
+  const uint8_t * utf8 = reinterpret_cast<const uint8_t *>(data);
+
+  if (isAscii(utf8, length)) {
+    write<uint8_t>(ONE_BYTE_STRING);
+    write<uint32_t>(length);
+    memcpy(reserve(length, 1), utf8, length);
+    return;
+  }
+
+  std::vector<uint16_t> & twoByte = utf16Scratch;
+  twoByte.clear();
+  for (size_t i = 0; i < length;) {
+    uint32_t codePoint;
+    uint8_t lead = utf8[i];
+    if (lead < 0x80) {
+      codePoint = lead;
+      i += 1;
+    } else if (lead < 0xE0) {
+      codePoint = ((lead & 0x1F) << 6) | (utf8[i + 1] & 0x3F);
+      i += 2;
+    } else if (lead < 0xF0) {
+      codePoint = ((lead & 0x0F) << 12) | ((utf8[i + 1] & 0x3F) << 6) | (utf8[i + 2] & 0x3F);
+      i += 3;
+    } else {
+      codePoint = ((lead & 0x07) << 18) | ((utf8[i + 1] & 0x3F) << 12) |
+        ((utf8[i + 2] & 0x3F) << 6) | (utf8[i + 3] & 0x3F);
+      i += 4;
+    }
+
+    if (codePoint >= 0x10000) {
+      codePoint -= 0x10000;
+      twoByte.push_back(0xD800 + (codePoint >> 10));
+      twoByte.push_back(0xDC00 + (codePoint & 0x3FF));
+    } else {
+      twoByte.push_back(codePoint);
+    }
+  }
+
+  uint32_t twoByteLength = twoByte.size();
+  write<uint8_t>(TWO_BYTE_STRING);
+  write<uint32_t>(twoByteLength);
+  memcpy(reserve(twoByteLength * sizeof(uint16_t), sizeof(uint16_t)), twoByte.data(),
+         twoByteLength * sizeof(uint16_t));
+}
+
+void StagingBuffer::stageArrayStart(uint32_t length) {
+  write<uint8_t>(ARRAY);
+  write<uint32_t>(length);
+}
+
+void StagingBuffer::stageObjectStart(const std::string & shapeKey) {
+  // The descriptor is resolved while staging so that building never has to compile a PDX type.
+  write<uint8_t>(OBJECT);
+  write<uint32_t>(descriptors.size());
+  descriptors.push_back(PdxTypeCache::getInstance()->find(shapeKey));
+}
+
+void StagingBuffer::stageEntriesStart(uint32_t length) {
+  write<uint8_t>(ENTRIES);
+  write<uint32_t>(length);
+}
+
+void StagingBuffer::stageString(const Local<String> & v8String) {
+  uint32_t length = v8String->Length();
+
+  if (v8String->IsOneByte()) {
+    write<uint8_t>(ONE_BYTE_STRING);
+    write<uint32_t>(length);
+    uint8_t * oneByte = reserve(length, 1);
+    v8String->WriteOneByte(oneByte, 0, length, String::NO_NULL_TERMINATION);
+    return;
+  }
+
+  write<uint8_t>(TWO_BYTE_STRING);
+  write<uint32_t>(length);
+  uint16_t * twoByte = reinterpret_cast<uint16_t *>(reserve(length * sizeof(uint16_t), sizeof(uint16_t)));
+  v8String->Write(twoByte, 0, length, String::NO_NULL_TERMINATION);
+}
+
+// Buffers and typed arrays are copied with a single memcpy; the copy is 8 byte aligned so that the
+// Cacheable arrays can be created straight from it.
+bool StagingBuffer::stageArrayBufferView(const Local<ArrayBufferView> & v8ArrayBufferView) {
+  uint8_t tag;
+  size_t elementSize;
+
+  if (v8ArrayBufferView->IsUint8Array()) {
+    tag = BYTES;
+    elementSize = sizeof(uint8_t);
+  } else if (v8ArrayBufferView->IsInt16Array()) {
+    tag = INT16_ARRAY;
+    elementSize = sizeof(int16_t);
+  } else if (v8ArrayBufferView->IsInt32Array()) {
+    tag = INT32_ARRAY;
+    elementSize = sizeof(int32_t);
+  } else if (v8ArrayBufferView->IsFloat32Array()) {
+    tag = FLOAT_ARRAY;
+    elementSize = sizeof(float);
+  } else if (v8ArrayBufferView->IsFloat64Array()) {
+    tag = DOUBLE_ARRAY;
+    elementSize = sizeof(double);
+#if NODE_GEMFIRE_HAS_BIGINT
+  } else if (v8ArrayBufferView->IsBigInt64Array()) {
+    tag = INT64_ARRAY;
+    elementSize = sizeof(int64_t);
+#endif
+  } else {
+    Nan::ThrowError("Unable to serialize to GemFire; unsupported typed array.");
+    return false;
+  }
+
+  size_t byteLength = v8ArrayBufferView->ByteLength();
+  write<uint8_t>(tag);
+  write<uint32_t>(byteLength / elementSize);
+  uint8_t * data = reserve(byteLength, sizeof(uint64_t));
+  v8ArrayBufferView->CopyContents(data, byteLength);
+  return true;
+}
+
+CacheablePtr StagingBuffer::build(const CachePtr & cachePtr, const ValueCodecOptions & options) {
+  cursor = 0;
+  return buildStored(cachePtr, options);
+}
+
+HashMapOfCacheablePtr StagingBuffer::buildHashMap(const CachePtr & cachePtr,
+                                                  const ValueCodecOptions & options) {
+  cursor = 0;
+  if (read<uint8_t>() != ENTRIES) {
+    return NULLPTR;
+  }
+
+  uint32_t length = read<uint32_t>();
+  HashMapOfCacheablePtr hashMapPtr(new HashMapOfCacheable(length));
+  for (uint32_t i = 0; i < length; i++) {
+    CacheableKeyPtr keyPtr(buildKey(cachePtr));
+    CacheablePtr valuePtr(buildStored(cachePtr, options));
+
+    if (keyPtr == NULLPTR || valuePtr == NULLPTR) {
+      return NULLPTR;
+    }
+
+    hashMapPtr->insert(keyPtr, valuePtr);
+  }
+  return hashMapPtr;
+}
+
+// The value as the region stores it: encoded for the msgpack codec, and compressed once it reaches
+// the compression threshold.
+CacheablePtr StagingBuffer::buildStored(const CachePtr & cachePtr, const ValueCodecOptions & options) {
+  if (options.codec == MESSAGE_PACK_CODEC) {
+    return buildEncoded(options.compressionThreshold);
+  }
+  return compressValue(buildValue(cachePtr), options.compressionThreshold);
+}
+
+// Keys are never encoded or compressed. Values that are not CacheableKeys, such as arrays, build
+// NULLPTR.
+CacheableKeyPtr StagingBuffer::buildKey(const CachePtr & cachePtr) {
+  CacheablePtr valuePtr(buildValue(cachePtr));
+  if (valuePtr == NULLPTR) {
+    return NULLPTR;
+  }
+  return CacheableKeyPtr(dynamic_cast<CacheableKey *>(valuePtr.ptr()));
+}
+
+CacheableStringPtr StagingBuffer::buildString(uint8_t tag) {
+  uint32_t length = read<uint32_t>();
+
+  if (tag == ONE_BYTE_STRING) {
+    const uint8_t * oneByte = consume(length, 1);
+    if (isAscii(oneByte, length)) {
+      return CacheableString::create(reinterpret_cast<const char *>(oneByte), length);
+    }
+
+    // Latin-1 characters above 0x7F are not valid in an ASCII CacheableString.
+    wideScratch.resize(length + 1);
+    for (uint32_t i = 0; i < length; i++) {
+      wideScratch[i] = oneByte[i];
+    }
+    return CacheableString::create(wideScratch.data(), length);
+  }
+
+  const uint16_t * twoByte = reinterpret_cast<const uint16_t *>(consume(length * sizeof(uint16_t),
+                                                                        sizeof(uint16_t)));
+  if (isAscii(twoByte, length)) {
+    narrowScratch.resize(length + 1);
+    for (uint32_t i = 0; i < length; i++) {
+      narrowScratch[i] = static_cast<char>(twoByte[i]);
+    }
+    return CacheableString::create(narrowScratch.data(), length);
+  }
+
+  wideScratch.resize(length + 1);
+  for (uint32_t i = 0; i < length; i++) {
+    wideScratch[i] = twoByte[i];
+  }
+  return CacheableString::create(wideScratch.data(), length);
+}
+
+void StagingBuffer::buildSchemaField(const PdxInstanceFactoryPtr & pdxInstanceFactory,
+                                     const PdxSchema::Field & field,
+                                     const CachePtr & cachePtr) {
+  const char * name = field.name.c_str();
+
+  switch (field.type) {
+    case BOOLEAN_FIELD:
+      pdxInstanceFactory->writeBoolean(name, read<uint8_t>() != 0);
+      return;
+    case BYTE_FIELD:
+      pdxInstanceFactory->writeByte(name, static_cast<int8_t>(read<int64_t>()));
+      return;
+    case SHORT_FIELD:
+      pdxInstanceFactory->writeShort(name, static_cast<int16_t>(read<int64_t>()));
+      return;
+    case INT_FIELD:
+      pdxInstanceFactory->writeInt(name, static_cast<int32_t>(read<int64_t>()));
+      return;
+    case LONG_FIELD:
+      pdxInstanceFactory->writeLong(name, read<int64_t>());
+      return;
+    case FLOAT_FIELD:
+      pdxInstanceFactory->writeFloat(name, static_cast<float>(read<double>()));
+      return;
+    case DOUBLE_FIELD:
+      pdxInstanceFactory->writeDouble(name, read<double>());
+      return;
+    case STRING_FIELD: {
+      uint8_t tag = read<uint8_t>();
+      if (tag == NULL_VALUE) {
+        pdxInstanceFactory->writeString(name, static_cast<const char *>(NULL));
+        return;
+      }
+      CacheableStringPtr stringPtr(buildString(tag));
+      if (stringPtr->isWideString()) {
+        pdxInstanceFactory->writeWideString(name, stringPtr->asWChar());
+      } else {
+        pdxInstanceFactory->writeString(name, stringPtr->asChar());
+      }
+      return;
+    }
+    case DATE_FIELD: {
+      CacheableDatePtr datePtr(NULLPTR);
+      if (read<uint8_t>() != 0) {
+        std::chrono::milliseconds dur(static_cast<int64_t>(read<double>()));
+        std::chrono::time_point<std::chrono::system_clock> dt(dur);
+        datePtr = CacheableDate::create(dt);
+      }
+      pdxInstanceFactory->writeDate(name, datePtr);
+      return;
+    }
+    case OBJECT_FIELD:
+      pdxInstanceFactory->writeObject(name, buildValue(cachePtr));
+      return;
+    case BOOLEAN_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length, sizeof(uint64_t));
+      std::unique_ptr<bool[]> values(new bool[length + 1]);
+      for (uint32_t i = 0; i < length; i++) {
+        values[i] = data[i] != 0;
+      }
+      pdxInstanceFactory->writeBooleanArray(name, values.get(), length);
+      return;
+    }
+    case BYTE_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      int8_t * data = reinterpret_cast<int8_t *>(const_cast<uint8_t *>(consume(length, sizeof(uint64_t))));
+      pdxInstanceFactory->writeByteArray(name, data, length);
+      return;
+    }
+    case SHORT_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      int16_t * data = reinterpret_cast<int16_t *>(
+          const_cast<uint8_t *>(consume(length * sizeof(int16_t), sizeof(uint64_t))));
+      pdxInstanceFactory->writeShortArray(name, data, length);
+      return;
+    }
+    case INT_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      int32_t * data = reinterpret_cast<int32_t *>(
+          const_cast<uint8_t *>(consume(length * sizeof(int32_t), sizeof(uint64_t))));
+      pdxInstanceFactory->writeIntArray(name, data, length);
+      return;
+    }
+    case LONG_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      int64_t * data = reinterpret_cast<int64_t *>(
+          const_cast<uint8_t *>(consume(length * sizeof(int64_t), sizeof(uint64_t))));
+      pdxInstanceFactory->writeLongArray(name, data, length);
+      return;
+    }
+    case FLOAT_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      float * data = reinterpret_cast<float *>(
+          const_cast<uint8_t *>(consume(length * sizeof(float), sizeof(uint64_t))));
+      pdxInstanceFactory->writeFloatArray(name, data, length);
+      return;
+    }
+    case DOUBLE_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      double * data = reinterpret_cast<double *>(
+          const_cast<uint8_t *>(consume(length * sizeof(double), sizeof(uint64_t))));
+      pdxInstanceFactory->writeDoubleArray(name, data, length);
+      return;
+    }
+    case STRING_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      std::vector<CacheableStringPtr> strings;
+      strings.reserve(length);
+      bool isWide = false;
+      for (uint32_t i = 0; i < length; i++) {
+        strings.push_back(buildString(read<uint8_t>()));
+        isWide = isWide || strings.back()->isWideString();
+      }
+
+      if (!isWide) {
+        std::vector<char *> values(length + 1, NULL);
+        for (uint32_t i = 0; i < length; i++) {
+          values[i] = const_cast<char *>(strings[i]->asChar());
+        }
+        pdxInstanceFactory->writeStringArray(name, values.data(), length);
+        return;
+      }
+
+      // One wide element makes the whole array wide; ASCII elements widen trivially.
+      std::vector<std::wstring> wideStrings(length);
+      std::vector<wchar_t *> values(length + 1, NULL);
+      for (uint32_t i = 0; i < length; i++) {
+        if (strings[i]->isWideString()) {
+          wideStrings[i].assign(strings[i]->asWChar(), strings[i]->length());
+        } else {
+          const char * narrow = strings[i]->asChar();
+          wideStrings[i].assign(narrow, narrow + strings[i]->length());
+        }
+        values[i] = const_cast<wchar_t *>(wideStrings[i].c_str());
+      }
+      pdxInstanceFactory->writeWideStringArray(name, values.data(), length);
+      return;
+    }
+    case OBJECT_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      CacheableObjectArrayPtr objectArrayPtr(CacheableObjectArray::create());
+      for (uint32_t i = 0; i < length; i++) {
+        objectArrayPtr->push_back(buildValue(cachePtr));
+      }
+      pdxInstanceFactory->writeObjectArray(name, objectArrayPtr);
+      return;
+    }
+  }
+
+  throw IllegalStateException("Corrupt staging buffer.");
+}
+
+CacheablePtr StagingBuffer::buildValue(const CachePtr & cachePtr) {
+  uint8_t tag = read<uint8_t>();
+
+  switch (tag) {
+    case NULL_VALUE:
+      return NULLPTR;
+    case UNDEFINED_VALUE:
+      return CacheableUndefined::create();
+    case BOOLEAN:
+      return CacheableBoolean::create(read<uint8_t>() != 0);
+    case DOUBLE:
+      return CacheableDouble::create(read<double>());
+    case INT32:
+      return CacheableInt32::create(read<int32_t>());
+    case INT64:
+      return CacheableInt64::create(read<int64_t>());
+    case DATE: {
+      long int millisecondsSinceEpoch = read<double>();
+      std::chrono::milliseconds dur(millisecondsSinceEpoch);
+      std::chrono::time_point<std::chrono::system_clock> dt(dur);
+      return CacheableDate::create(dt);
+    }
+    case ONE_BYTE_STRING:
+    case TWO_BYTE_STRING:
+      return buildString(tag);
+    case ARRAY: {
+      CacheableArrayListPtr arrayListPtr(CacheableArrayList::create());
+      uint32_t length = read<uint32_t>();
+      for (uint32_t i = 0; i < length; i++) {
+        arrayListPtr->push_back(buildValue(cachePtr));
+      }
+      return arrayListPtr;
+    }
+    case OBJECT: {
+      const PdxTypeDescriptorPtr & descriptor(descriptors[read<uint32_t>()]);
+      PdxInstanceFactoryPtr pdxInstanceFactory =
+        cachePtr->createPdxInstanceFactory(descriptor->className.c_str());
+      size_t length = descriptor->fields.size();
+      for (size_t i = 0; i < length; i++) {
+        CacheablePtr cacheablePtr(buildValue(cachePtr));
+        pdxInstanceFactory->writeObject(descriptor->fields[i].name.c_str(), cacheablePtr);
+      }
+      return pdxInstanceFactory->create();
+    }
+    case SCHEMA_OBJECT: {
+      const PdxSchemaPtr & schema(schemas[read<uint32_t>()]);
+      PdxInstanceFactoryPtr pdxInstanceFactory =
+        cachePtr->createPdxInstanceFactory(schema->className.c_str());
+      size_t length = schema->fields.size();
+      for (size_t i = 0; i < length; i++) {
+        buildSchemaField(pdxInstanceFactory, schema->fields[i], cachePtr);
+      }
+      return pdxInstanceFactory->create();
+    }
+    case BYTES: {
+      uint32_t length = read<uint32_t>();
+      return CacheableBytes::create(consume(length, sizeof(uint64_t)), length);
+    }
+    case INT16_ARRAY: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length * sizeof(int16_t), sizeof(uint64_t));
+      return CacheableInt16Array::create(reinterpret_cast<const int16_t *>(data), length);
+    }
+    case INT32_ARRAY: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length * sizeof(int32_t), sizeof(uint64_t));
+      return CacheableInt32Array::create(reinterpret_cast<const int32_t *>(data), length);
+    }
+    case FLOAT_ARRAY: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length * sizeof(float), sizeof(uint64_t));
+      return CacheableFloatArray::create(reinterpret_cast<const float *>(data), length);
+    }
+    case DOUBLE_ARRAY: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length * sizeof(double), sizeof(uint64_t));
+      return CacheableDoubleArray::create(reinterpret_cast<const double *>(data), length);
+    }
+    case INT64_ARRAY: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length * sizeof(int64_t), sizeof(uint64_t));
+      return CacheableInt64Array::create(reinterpret_cast<const int64_t *>(data), length);
+    }
+  }
+
+  throw IllegalStateException("Corrupt staging buffer.");
+}
+
+// A value of a region with the msgpack codec: the envelope header and the MessagePack encoding of
+// the staged value. Objects become maps keyed by their property names, with no PDX type at all.
+CacheablePtr StagingBuffer::buildEncoded(uint32_t compressionThreshold) {
+  // A null value is as invalid as it is for buildValue().
+  if (bytes[cursor] == NULL_VALUE) {
+    cursor++;
+    return NULLPTR;
+  }
+
+  encodedScratch.clear();
+  appendEnvelopeHeader(encodedScratch, MESSAGE_PACK_ENVELOPE);
+  MessagePackWriter writer(encodedScratch);
+  encodeValue(writer);
+
+  CacheablePtr compressedPtr(compressEnvelope(MESSAGE_PACK_ENVELOPE,
+                                              encodedScratch.data() + envelopeHeaderLength,
+                                              encodedScratch.size() - envelopeHeaderLength,
+                                              compressionThreshold));
+  if (compressedPtr != NULLPTR) {
+    return compressedPtr;
+  }
+  return CacheableBytes::create(encodedScratch.data(), encodedScratch.size());
+}
+
+// MessagePack readers give back integers as Numbers, so integral values are always written in the
+// shortest integer form, whatever the number encoding.
+void StagingBuffer::encodeNumber(MessagePackWriter & writer, double value) {
+  if (compactNumberType(value) == COMPACT_INT32) {
+    writer.writeInteger(static_cast<int32_t>(value));
+  } else {
+    writer.writeDouble(value);
+  }
+}
+
+void StagingBuffer::encodeString(MessagePackWriter & writer, uint8_t tag) {
+  uint32_t length = read<uint32_t>();
+
+  if (tag == ONE_BYTE_STRING) {
+    const uint8_t * oneByte = consume(length, 1);
+    if (isAscii(oneByte, length)) {
+      writer.writeStringHeader(length);
+      writer.writeBytes(oneByte, length);
+      return;
+    }
+
+    utf8Scratch.clear();
+    for (uint32_t i = 0; i < length; i++) {
+      appendUtf8(utf8Scratch, oneByte[i]);
+    }
+  } else {
+    const uint16_t * twoByte = reinterpret_cast<const uint16_t *>(consume(length * sizeof(uint16_t),
+                                                                          sizeof(uint16_t)));
+    utf8Scratch.clear();
+    for (uint32_t i = 0; i < length; i++) {
+      uint32_t codeUnit = twoByte[i];
+      if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF && i + 1 < length &&
+          twoByte[i + 1] >= 0xDC00 && twoByte[i + 1] <= 0xDFFF) {
+        codeUnit = 0x10000 + ((codeUnit - 0xD800) << 10) + (twoByte[i + 1] - 0xDC00);
+        i++;
+      }
+      appendUtf8(utf8Scratch, codeUnit);
+    }
+  }
+
+  writer.writeStringHeader(utf8Scratch.size());
+  writer.writeBytes(utf8Scratch.data(), utf8Scratch.size());
+}
+
+void StagingBuffer::encodeTypedArray(MessagePackWriter & writer, MessagePackExtension extension,
+                                     size_t elementSize) {
+  uint32_t length = read<uint32_t>();
+  const uint8_t * data = consume(length * elementSize, sizeof(uint64_t));
+  writer.writeExtensionHeader(extension, length * elementSize);
+  writer.writeBytes(data, length * elementSize);
+}
+
+void StagingBuffer::encodeSchemaField(MessagePackWriter & writer, const PdxSchema::Field & field) {
+  switch (field.type) {
+    case BOOLEAN_FIELD:
+      writer.writeBoolean(read<uint8_t>() != 0);
+      return;
+    case BYTE_FIELD:
+    case SHORT_FIELD:
+    case INT_FIELD:
+      writer.writeInteger(static_cast<int32_t>(read<int64_t>()));
+      return;
+    case LONG_FIELD:
+      writer.writeInt64(read<int64_t>());
+      return;
+    case FLOAT_FIELD:
+      writer.writeDouble(static_cast<float>(read<double>()));
+      return;
+    case DOUBLE_FIELD:
+      writer.writeDouble(read<double>());
+      return;
+    case STRING_FIELD: {
+      uint8_t tag = read<uint8_t>();
+      if (tag == NULL_VALUE) {
+        writer.writeNil();
+      } else {
+        encodeString(writer, tag);
+      }
+      return;
+    }
+    case DATE_FIELD:
+      if (read<uint8_t>() != 0) {
+        writer.writeDate(read<double>());
+      } else {
+        writer.writeNil();
+      }
+      return;
+    case OBJECT_FIELD:
+      encodeValue(writer);
+      return;
+    case BOOLEAN_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      const uint8_t * data = consume(length, sizeof(uint64_t));
+      writer.writeArrayHeader(length);
+      for (uint32_t i = 0; i < length; i++) {
+        writer.writeBoolean(data[i] != 0);
+      }
+      return;
+    }
+    case BYTE_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      writer.writeBinaryHeader(length);
+      writer.writeBytes(consume(length, sizeof(uint64_t)), length);
+      return;
+    }
+    case SHORT_ARRAY_FIELD:
+      encodeTypedArray(writer, INT16_ARRAY_EXTENSION, sizeof(int16_t));
+      return;
+    case INT_ARRAY_FIELD:
+      encodeTypedArray(writer, INT32_ARRAY_EXTENSION, sizeof(int32_t));
+      return;
+    case LONG_ARRAY_FIELD:
+      encodeTypedArray(writer, INT64_ARRAY_EXTENSION, sizeof(int64_t));
+      return;
+    case FLOAT_ARRAY_FIELD:
+      encodeTypedArray(writer, FLOAT_ARRAY_EXTENSION, sizeof(float));
+      return;
+    case DOUBLE_ARRAY_FIELD:
+      encodeTypedArray(writer, DOUBLE_ARRAY_EXTENSION, sizeof(double));
+      return;
+    case STRING_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      writer.writeArrayHeader(length);
+      for (uint32_t i = 0; i < length; i++) {
+        encodeString(writer, read<uint8_t>());
+      }
+      return;
+    }
+    case OBJECT_ARRAY_FIELD: {
+      uint32_t length = read<uint32_t>();
+      writer.writeArrayHeader(length);
+      for (uint32_t i = 0; i < length; i++) {
+        encodeValue(writer);
+      }
+      return;
+    }
+  }
+
+  throw IllegalStateException("Corrupt staging buffer.");
+}
+
+void StagingBuffer::encodeValue(MessagePackWriter & writer) {
+  uint8_t tag = read<uint8_t>();
+
+  switch (tag) {
+    case NULL_VALUE:
+      writer.writeNil();
+      return;
+    case UNDEFINED_VALUE:
+      writer.writeExtensionHeader(UNDEFINED_EXTENSION, 0);
+      return;
+    case BOOLEAN:
+      writer.writeBoolean(read<uint8_t>() != 0);
+      return;
+    case DOUBLE:
+      encodeNumber(writer, read<double>());
+      return;
+    case INT32:
+      writer.writeInteger(read<int32_t>());
+      return;
+    case INT64:
+      writer.writeInt64(read<int64_t>());
+      return;
+    case DATE:
+      writer.writeDate(read<double>());
+      return;
+    case ONE_BYTE_STRING:
+    case TWO_BYTE_STRING:
+      encodeString(writer, tag);
+      return;
+    case ARRAY: {
+      uint32_t length = read<uint32_t>();
+      writer.writeArrayHeader(length);
+      for (uint32_t i = 0; i < length; i++) {
+        encodeValue(writer);
+      }
+      return;
+    }
+    case OBJECT: {
+      const PdxTypeDescriptorPtr & descriptor(descriptors[read<uint32_t>()]);
+      size_t length = descriptor->fields.size();
+      writer.writeMapHeader(length);
+      for (size_t i = 0; i < length; i++) {
+        const std::string & name(descriptor->fields[i].name);
+        writer.writeStringHeader(name.length());
+        writer.writeBytes(name.data(), name.length());
+        encodeValue(writer);
+      }
+      return;
+    }
+    case SCHEMA_OBJECT: {
+      const PdxSchemaPtr & schema(schemas[read<uint32_t>()]);
+      size_t length = schema->fields.size();
+      writer.writeMapHeader(length);
+      for (size_t i = 0; i < length; i++) {
+        const std::string & name(schema->fields[i].name);
+        writer.writeStringHeader(name.length());
+        writer.writeBytes(name.data(), name.length());
+        encodeSchemaField(writer, schema->fields[i]);
+      }
+      return;
+    }
+    case BYTES: {
+      uint32_t length = read<uint32_t>();
+      writer.writeBinaryHeader(length);
+      writer.writeBytes(consume(length, sizeof(uint64_t)), length);
+      return;
+    }
+    case INT16_ARRAY:
+      encodeTypedArray(writer, INT16_ARRAY_EXTENSION, sizeof(int16_t));
+      return;
+    case INT32_ARRAY:
+      encodeTypedArray(writer, INT32_ARRAY_EXTENSION, sizeof(int32_t));
+      return;
+    case FLOAT_ARRAY:
+      encodeTypedArray(writer, FLOAT_ARRAY_EXTENSION, sizeof(float));
+      return;
+    case DOUBLE_ARRAY:
+      encodeTypedArray(writer, DOUBLE_ARRAY_EXTENSION, sizeof(double));
+      return;
+    case INT64_ARRAY:
+      encodeTypedArray(writer, INT64_ARRAY_EXTENSION, sizeof(int64_t));
+      return;
+  }
+
+  throw IllegalStateException("Corrupt staging buffer.");
+}
+
+}  // namespace node_gemfire
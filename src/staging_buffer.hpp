@@ -0,0 +1,142 @@
+#ifndef __STAGING_BUFFER_HPP__
+#define __STAGING_BUFFER_HPP__
+
+#include <v8.h>
+#include <geode/GeodeCppCache.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "conversions.hpp"
+#include "message_pack.hpp"
+#include "pdx_type_cache.hpp"
+#include "schema_registry.hpp"
+#include "value_codec.hpp"
+
+namespace node_gemfire {
+
+// A flat, V8-free copy of a JavaScript value made of tagged scalars, strings and nesting markers.
+// stage() walks the value once on the JavaScript thread and resolves the PDX type of every object;
+// build() creates the PdxInstances and Cacheables from it on any thread, usually a worker's, or
+// encodes it for a region with a value codec.
+class StagingBuffer {
+ public:
+  // Construct on the JavaScript thread; the number encodings are taken from conversionOptions().
+  StagingBuffer() :
+    numberEncoding(conversionOptions().numberEncoding),
+    keyEncoding(conversionOptions().keyEncoding),
+    cursor(0) {}
+
+  // Returns false, with a JavaScript exception pending, if the value cannot be stored in GemFire.
+  bool stage(const v8::Local<v8::Value> & v8Value);
+  // Stages the keys and values of a putAll(): the own properties of an object, as String keys, or
+  // the entries of a Map or of an array of [key, value] pairs, with keys of any type.
+  bool stageEntries(const v8::Local<v8::Object> & v8Object);
+
+  // Stage values that do not come from V8, such as parsed JSON. Containers are started with their
+  // length (or PDX shape) and then followed by that many staged values.
+  void stageNull();
+  void stageBoolean(bool value);
+  void stageDouble(double value);
+  // Stages a JavaScript Number, as a double or as an integer depending on the number encoding.
+  void stageNumber(double value);
+  void stageUtf8String(const char * data, size_t length);
+  void stageArrayStart(uint32_t length);
+  void stageObjectStart(const std::string & shapeKey);
+  void stageEntriesStart(uint32_t length);
+
+  apache::geode::client::CacheablePtr build(const apache::geode::client::CachePtr & cachePtr,
+                                            const ValueCodecOptions & options = ValueCodecOptions());
+  // Returns NULLPTR if any of the staged entries has a null value or a key that cannot be a key.
+  apache::geode::client::HashMapOfCacheablePtr buildHashMap(
+      const apache::geode::client::CachePtr & cachePtr,
+      const ValueCodecOptions & options = ValueCodecOptions());
+
+  size_t byteLength() const {
+    return bytes.size();
+  }
+
+ private:
+  enum Tag {
+    NULL_VALUE,
+    UNDEFINED_VALUE,
+    BOOLEAN,
+    DOUBLE,
+    INT32,
+    INT64,
+    DATE,
+    ONE_BYTE_STRING,
+    TWO_BYTE_STRING,
+    ARRAY,
+    OBJECT,
+    SCHEMA_OBJECT,
+    ENTRIES,
+    BYTES,
+    INT16_ARRAY,
+    INT32_ARRAY,
+    FLOAT_ARRAY,
+    DOUBLE_ARRAY,
+    INT64_ARRAY
+  };
+
+  template<typename T>
+  void write(const T & value) {
+    size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    memcpy(&bytes[offset], &value, sizeof(T));
+  }
+
+  template<typename T>
+  T read() {
+    T value;
+    memcpy(&value, &bytes[cursor], sizeof(T));
+    cursor += sizeof(T);
+    return value;
+  }
+
+  uint8_t * reserve(size_t byteLength, size_t alignment);
+  const uint8_t * consume(size_t byteLength, size_t alignment);
+
+  bool stageObject(const v8::Local<v8::Object> & v8Object);
+  bool stageKey(const v8::Local<v8::Value> & v8Key);
+  void stageNumber(double value, NumberEncoding encoding);
+  bool stageSchemaObject(const v8::Local<v8::Object> & v8Object, const v8::Local<v8::Value> & schemaName);
+  bool stageSchemaField(const PdxSchema & schema, size_t index, const v8::Local<v8::Value> & v8Value);
+  bool stageSchemaArray(const PdxSchema & schema, size_t index, const v8::Local<v8::Value> & v8Value);
+  void stageString(const v8::Local<v8::String> & v8String);
+  bool stageArrayBufferView(const v8::Local<v8::ArrayBufferView> & v8ArrayBufferView);
+
+  apache::geode::client::CacheablePtr buildValue(const apache::geode::client::CachePtr & cachePtr);
+  apache::geode::client::CacheableStringPtr buildString(uint8_t tag);
+  apache::geode::client::CacheableKeyPtr buildKey(const apache::geode::client::CachePtr & cachePtr);
+  void buildSchemaField(const apache::geode::client::PdxInstanceFactoryPtr & pdxInstanceFactory,
+                        const PdxSchema::Field & field,
+                        const apache::geode::client::CachePtr & cachePtr);
+
+  apache::geode::client::CacheablePtr buildStored(const apache::geode::client::CachePtr & cachePtr,
+                                                  const ValueCodecOptions & options);
+  apache::geode::client::CacheablePtr buildEncoded(uint32_t compressionThreshold);
+  void encodeValue(MessagePackWriter & writer);
+  void encodeNumber(MessagePackWriter & writer, double value);
+  void encodeString(MessagePackWriter & writer, uint8_t tag);
+  void encodeTypedArray(MessagePackWriter & writer, MessagePackExtension extension, size_t elementSize);
+  void encodeSchemaField(MessagePackWriter & writer, const PdxSchema::Field & field);
+
+  std::vector<uint8_t> bytes;
+  std::vector<PdxTypeDescriptorPtr> descriptors;
+  std::vector<PdxSchemaPtr> schemas;
+  std::vector<char> narrowScratch;
+  std::vector<wchar_t> wideScratch;
+  std::vector<uint16_t> utf16Scratch;
+  std::vector<uint8_t> utf8Scratch;
+  std::vector<uint8_t> encodedScratch;
+  NumberEncoding numberEncoding;
+  NumberEncoding keyEncoding;
+  size_t cursor;
+};
+
+bool isPrimitiveArray(const v8::Local<v8::Value> & v8Value);
+
+}  // namespace node_gemfire
+
+#endif
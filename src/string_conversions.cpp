@@ -0,0 +1,85 @@
+#include "string_conversions.hpp"
+#include <nan.h>
+#include <vector>
+
+using namespace v8;
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+// Strings are only converted on the JavaScript thread, and CacheableString and V8 both copy out of
+// these buffers, so one grow-only buffer per element type replaces a heap allocation per string.
+template<typename T>
+T * scratchBuffer(size_t length) {
+  static std::vector<T> buffer;
+  if (buffer.size() < length + 1) {
+    buffer.resize(length + 1);
+  }
+  buffer[length] = 0;
+  return buffer.data();
+}
+
+CacheableStringPtr gemfireString(const Local<String> & v8String) {
+  int length = v8String->Length();
+
+  if (v8String->IsOneByte()) {
+    uint8_t * oneByte = scratchBuffer<uint8_t>(length);
+    v8String->WriteOneByte(oneByte, 0, length, String::NO_NULL_TERMINATION);
+
+    if (isAscii(oneByte, length)) {
+      return CacheableString::create(reinterpret_cast<const char *>(oneByte), length);
+    }
+
+    // Latin-1 characters above 0x7F are not valid in an ASCII CacheableString.
+    wchar_t * wide = scratchBuffer<wchar_t>(length);
+    for (int i = 0; i < length; i++) {
+      wide[i] = oneByte[i];
+    }
+    return CacheableString::create(wide, length);
+  }
+
+  uint16_t * twoByte = scratchBuffer<uint16_t>(length);
+  v8String->Write(twoByte, 0, length, String::NO_NULL_TERMINATION);
+
+  if (isAscii(twoByte, length)) {
+    char * narrow = scratchBuffer<char>(length);
+    for (int i = 0; i < length; i++) {
+      narrow[i] = static_cast<char>(twoByte[i]);
+    }
+    return CacheableString::create(narrow, length);
+  }
+
+  wchar_t * wide = scratchBuffer<wchar_t>(length);
+  for (int i = 0; i < length; i++) {
+    wide[i] = twoByte[i];
+  }
+  return CacheableString::create(wide, length);
+}
+
+Local<String> v8String(const CacheableStringPtr & cacheableStringPtr) {
+  Nan::EscapableHandleScope scope;
+
+  int length = cacheableStringPtr->length();
+
+  if (cacheableStringPtr->isWideString()) {
+    const wchar_t * wide = cacheableStringPtr->asWChar();
+    uint16_t * twoByte = scratchBuffer<uint16_t>(length);
+    for (int i = 0; i < length; i++) {
+      twoByte[i] = wide[i];
+    }
+    return scope.Escape(Nan::New<String>(twoByte, length).ToLocalChecked());
+  }
+
+  const char * narrow = cacheableStringPtr->asChar();
+  if (isAscii(narrow, length)) {
+    return scope.Escape(String::NewFromOneByte(Isolate::GetCurrent(),
+                                               reinterpret_cast<const uint8_t *>(narrow),
+                                               NewStringType::kNormal,
+                                               length).ToLocalChecked());
+  }
+
+  // Anything else in a narrow string came from a UTF-8 source.
+  return scope.Escape(Nan::New<String>(narrow, length).ToLocalChecked());
+}
+
+}  // namespace node_gemfire
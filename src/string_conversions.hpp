@@ -0,0 +1,61 @@
+#ifndef __STRING_CONVERSIONS_HPP__
+#define __STRING_CONVERSIONS_HPP__
+
+#include <v8.h>
+#include <geode/CacheableString.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace node_gemfire {
+
+// Word-at-a-time scans for anything outside 7-bit ASCII. Eight bytes or four UTF-16 code units
+// are checked per iteration.
+inline bool isAscii(const uint8_t * data, size_t length) {
+  static const uint64_t highBits = 0x8080808080808080ULL;
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & highBits) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
+    if (data[i] & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool isAscii(const char * data, size_t length) {
+  return isAscii(reinterpret_cast<const uint8_t *>(data), length);
+}
+
+inline bool isAscii(const uint16_t * data, size_t length) {
+  static const uint64_t highBits = 0xFF80FF80FF80FF80ULL;
+
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & highBits) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
+    if (data[i] & 0xFF80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+apache::geode::client::CacheableStringPtr gemfireString(const v8::Local<v8::String> & v8String);
+v8::Local<v8::String> v8String(const apache::geode::client::CacheableStringPtr & cacheableStringPtr);
+
+}  // namespace node_gemfire
+
+#endif
@@ -0,0 +1,222 @@
+#include "value_codec.hpp"
+#include <geode/DataInput.hpp>
+#include <geode/DataOutput.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lz4.hpp"
+
+using namespace apache::geode::client;
+
+namespace node_gemfire {
+
+namespace {
+
+const uint8_t envelopeMagic[] = { 'N', 'G', 'F' };
+// The format byte and uncompressed length that start an LZ4_ENVELOPE payload.
+const size_t compressedHeaderLength = 5;
+// LZ4 cannot expand a compressed byte into more than 255 bytes, so a larger uncompressed length in
+// the header means the value is corrupt, or is a Buffer that only happens to look like an envelope.
+const uint64_t maxExpansionRatio = 255;
+
+}  // namespace
+
+bool parseValueCodec(const std::string & codecName, ValueCodec & codec) {
+  if (codecName == "pdx") {
+    codec = PDX_CODEC;
+  } else if (codecName == "msgpack") {
+    codec = MESSAGE_PACK_CODEC;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char * valueCodecName(ValueCodec codec) {
+  return codec == MESSAGE_PACK_CODEC ? "msgpack" : "pdx";
+}
+
+void appendEnvelopeHeader(std::vector<uint8_t> & output, EnvelopeFormat format) {
+  output.insert(output.end(), envelopeMagic, envelopeMagic + sizeof(envelopeMagic));
+  output.push_back(static_cast<uint8_t>(format));
+}
+
+bool openEnvelope(const CacheablePtr & storedPtr, std::vector<uint8_t> & scratch,
+                  const uint8_t * & messagePack, size_t & messagePackLength, CacheablePtr & valuePtr) {
+  if (storedPtr == NULLPTR || storedPtr->typeId() != GeodeTypeIds::CacheableBytes) {
+    return false;
+  }
+
+  CacheableBytesPtr bytesPtr(static_cast<CacheableBytesPtr>(storedPtr));
+  const uint8_t * data = bytesPtr->value();
+  size_t length = bytesPtr->length();
+  if (length < envelopeHeaderLength || memcmp(data, envelopeMagic, sizeof(envelopeMagic)) != 0) {
+    return false;
+  }
+
+  uint8_t format = data[sizeof(envelopeMagic)];
+  data += envelopeHeaderLength;
+  length -= envelopeHeaderLength;
+
+  if (format == LZ4_ENVELOPE) {
+    if (length < compressedHeaderLength) {
+      throw IllegalStateException("Corrupt compressed value.");
+    }
+
+    uint64_t start = uv_hrtime();
+    format = data[0];
+    uint32_t uncompressedLength = data[1] | (data[2] << 8) | (data[3] << 16) |
+      (static_cast<uint32_t>(data[4]) << 24);
+    if (uncompressedLength > (length - compressedHeaderLength) * maxExpansionRatio) {
+      throw IllegalStateException("Corrupt compressed value.");
+    }
+    scratch.resize(uncompressedLength);
+    if (!lz4Decompress(data + compressedHeaderLength, length - compressedHeaderLength,
+                       scratch.data(), uncompressedLength)) {
+      throw IllegalStateException("Corrupt compressed value.");
+    }
+    CompressionStats::getInstance()->recordDecompression(uv_hrtime() - start);
+
+    data = scratch.data();
+    length = uncompressedLength;
+
+    if (format == SERIALIZED_ENVELOPE) {
+      DataInput dataInput(data, static_cast<int32_t>(length));
+      dataInput.readObject(valuePtr);
+      messagePack = NULL;
+      return true;
+    }
+  }
+
+  if (format == BYTES_ENVELOPE) {
+    valuePtr = CacheableBytes::create(data, static_cast<int32_t>(length));
+    messagePack = NULL;
+    return true;
+  }
+
+  if (format != MESSAGE_PACK_ENVELOPE) {
+    return false;
+  }
+
+  messagePack = data;
+  messagePackLength = length;
+  return true;
+}
+
+CacheablePtr compressEnvelope(EnvelopeFormat format, const uint8_t * data, size_t length,
+                              uint32_t threshold) {
+  if (threshold == 0 || length < threshold) {
+    return NULLPTR;
+  }
+
+  uint64_t start = uv_hrtime();
+
+  std::vector<uint8_t> output;
+  output.reserve(envelopeHeaderLength + compressedHeaderLength + lz4CompressBound(length));
+  appendEnvelopeHeader(output, LZ4_ENVELOPE);
+  output.push_back(static_cast<uint8_t>(format));
+  for (int shift = 0; shift < 32; shift += 8) {
+    output.push_back(static_cast<uint8_t>(length >> shift));
+  }
+  lz4Compress(data, length, output);
+
+  if (output.size() >= length) {
+    CompressionStats::getInstance()->recordSkipped();
+    return NULLPTR;
+  }
+
+  CacheablePtr compressedPtr(CacheableBytes::create(output.data(), output.size()));
+  CompressionStats::getInstance()->recordCompression(length, output.size(), uv_hrtime() - start);
+  return compressedPtr;
+}
+
+CacheablePtr compressValue(const CacheablePtr & valuePtr, uint32_t threshold) {
+  if (threshold == 0 || valuePtr == NULLPTR) {
+    return valuePtr;
+  }
+
+  DataOutput dataOutput;
+  dataOutput.writeObject(valuePtr);
+  CacheablePtr compressedPtr(compressEnvelope(SERIALIZED_ENVELOPE, dataOutput.getBuffer(),
+                                              dataOutput.getBufferLength(), threshold));
+  if (compressedPtr != NULLPTR) {
+    return compressedPtr;
+  }
+  if (valuePtr->typeId() != GeodeTypeIds::CacheableBytes) {
+    return valuePtr;
+  }
+
+  // Buffers are stored as they are, unless they start with the envelope magic.
+  CacheableBytesPtr bytesPtr(static_cast<CacheableBytesPtr>(valuePtr));
+  size_t length = bytesPtr->length();
+  if (length < sizeof(envelopeMagic) ||
+      memcmp(bytesPtr->value(), envelopeMagic, sizeof(envelopeMagic)) != 0) {
+    return valuePtr;
+  }
+
+  std::vector<uint8_t> output;
+  output.reserve(envelopeHeaderLength + length);
+  appendEnvelopeHeader(output, BYTES_ENVELOPE);
+  output.insert(output.end(), bytesPtr->value(), bytesPtr->value() + length);
+  return CacheableBytes::create(output.data(), static_cast<int32_t>(output.size()));
+}
+
+ValueCodecRegistry * ValueCodecRegistry::getInstance() {
+  static ValueCodecRegistry instance;
+  return &instance;
+}
+
+void ValueCodecRegistry::set(const std::string & regionPath, const ValueCodecOptions & options) {
+  if (!options.usesEnvelopes()) {
+    regionOptions.erase(regionPath);
+  } else {
+    regionOptions[regionPath] = options;
+  }
+}
+
+ValueCodecOptions ValueCodecRegistry::get(const RegionPtr & regionPtr) const {
+  if (regionOptions.empty()) {
+    return ValueCodecOptions();
+  }
+
+  std::unordered_map<std::string, ValueCodecOptions>::const_iterator iterator(
+      regionOptions.find(regionPtr->getFullPath()));
+  return iterator == regionOptions.end() ? ValueCodecOptions() : iterator->second;
+}
+
+CompressionStats * CompressionStats::getInstance() {
+  static CompressionStats instance;
+  return &instance;
+}
+
+void CompressionStats::recordCompression(size_t uncompressedLength, size_t compressedLength,
+                                         uint64_t nanoseconds) {
+  uv_mutex_lock(&mutex);
+  totals.compressedValues++;
+  totals.uncompressedBytes += uncompressedLength;
+  totals.compressedBytes += compressedLength;
+  totals.compressNanoseconds += nanoseconds;
+  uv_mutex_unlock(&mutex);
+}
+
+void CompressionStats::recordSkipped() {
+  uv_mutex_lock(&mutex);
+  totals.skippedValues++;
+  uv_mutex_unlock(&mutex);
+}
+
+void CompressionStats::recordDecompression(uint64_t nanoseconds) {
+  uv_mutex_lock(&mutex);
+  totals.decompressedValues++;
+  totals.decompressNanoseconds += nanoseconds;
+  uv_mutex_unlock(&mutex);
+}
+
+CompressionStats::Totals CompressionStats::getTotals() {
+  uv_mutex_lock(&mutex);
+  Totals snapshot(totals);
+  uv_mutex_unlock(&mutex);
+  return snapshot;
+}
+
+}  // namespace node_gemfire
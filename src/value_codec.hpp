@@ -0,0 +1,133 @@
+#ifndef __VALUE_CODEC_HPP__
+#define __VALUE_CODEC_HPP__
+
+#include <geode/GeodeCppCache.hpp>
+#include <uv.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node_gemfire {
+
+// How a region stores its values. PDX_CODEC is the default field-by-field PdxInstance mapping;
+// MESSAGE_PACK_CODEC stores every value as one CacheableBytes holding an envelope header followed
+// by the MessagePack encoding of the value. Encoded values cannot be queried on the server.
+enum ValueCodec {
+  PDX_CODEC,
+  MESSAGE_PACK_CODEC
+};
+
+bool parseValueCodec(const std::string & codecName, ValueCodec & codec);
+const char * valueCodecName(ValueCodec codec);
+
+struct ValueCodecOptions {
+  ValueCodecOptions() :
+    codec(PDX_CODEC),
+    compressionThreshold(0) {}
+
+  // Whether stored values may be envelopes that have to be opened on the way out.
+  bool usesEnvelopes() const {
+    return codec != PDX_CODEC || compressionThreshold > 0;
+  }
+
+  ValueCodec codec;
+  // Serialized values of at least this many bytes are stored LZ4 compressed; 0 turns this off.
+  uint32_t compressionThreshold;
+};
+
+// Envelope: the bytes "NGF" and a format byte, so that encoded values can be told apart from
+// Buffers that were put before the codec was switched on. An LZ4_ENVELOPE payload is the format of
+// the compressed value, its uncompressed length as a little-endian uint32, and an LZ4 block.
+// SERIALIZED_ENVELOPE, a value in GemFire's own serialization, only occurs inside LZ4_ENVELOPE.
+// BYTES_ENVELOPE escapes a Buffer that starts like an envelope itself; its payload is the Buffer.
+const size_t envelopeHeaderLength = 4;
+
+enum EnvelopeFormat {
+  MESSAGE_PACK_ENVELOPE = 1,
+  LZ4_ENVELOPE = 2,
+  SERIALIZED_ENVELOPE = 3,
+  BYTES_ENVELOPE = 4
+};
+
+void appendEnvelopeHeader(std::vector<uint8_t> & output, EnvelopeFormat format);
+
+// Opens a value stored through a codec. Returns false for values without an envelope. MessagePack
+// is returned in messagePack, which may point into scratch once decompressed; compressed PDX and
+// other serialized values are deserialized into valuePtr, and escaped Buffers are copied into it.
+// Only stored values are envelopes, so what is returned must not be opened again. Throws
+// IllegalStateException if corrupt.
+bool openEnvelope(const apache::geode::client::CacheablePtr & storedPtr, std::vector<uint8_t> & scratch,
+                  const uint8_t * & messagePack, size_t & messagePackLength,
+                  apache::geode::client::CacheablePtr & valuePtr);
+
+// Wraps a MessagePack payload, or a Cacheable after serializing it, in an LZ4 envelope if it is
+// at least threshold bytes long and compresses. When it is left uncompressed compressEnvelope()
+// returns NULLPTR and compressValue() returns valuePtr itself, unless it is a Buffer that would be
+// mistaken for an envelope, which is escaped in a BYTES_ENVELOPE.
+apache::geode::client::CacheablePtr compressEnvelope(EnvelopeFormat format, const uint8_t * data,
+                                                     size_t length, uint32_t threshold);
+apache::geode::client::CacheablePtr compressValue(const apache::geode::client::CacheablePtr & valuePtr,
+                                                  uint32_t threshold);
+
+// The codec options of each region, by full path, since Region wrappers are created afresh by
+// getRegion(). Only ever touched from the JavaScript thread; workers are handed the options when
+// they are queued.
+class ValueCodecRegistry {
+ public:
+  static ValueCodecRegistry * getInstance();
+
+  void set(const std::string & regionPath, const ValueCodecOptions & options);
+  ValueCodecOptions get(const apache::geode::client::RegionPtr & regionPtr) const;
+
+ private:
+  std::unordered_map<std::string, ValueCodecOptions> regionOptions;
+};
+
+// Totals for the compression stage, updated from worker threads.
+class CompressionStats {
+ public:
+  struct Totals {
+    Totals() :
+      compressedValues(0),
+      skippedValues(0),
+      uncompressedBytes(0),
+      compressedBytes(0),
+      compressNanoseconds(0),
+      decompressedValues(0),
+      decompressNanoseconds(0) {}
+
+    uint64_t compressedValues;
+    // Values over the threshold that did not get smaller and were stored uncompressed.
+    uint64_t skippedValues;
+    uint64_t uncompressedBytes;
+    uint64_t compressedBytes;
+    uint64_t compressNanoseconds;
+    uint64_t decompressedValues;
+    uint64_t decompressNanoseconds;
+  };
+
+  CompressionStats() {
+    uv_mutex_init(&mutex);
+  }
+
+  ~CompressionStats() {
+    uv_mutex_destroy(&mutex);
+  }
+
+  static CompressionStats * getInstance();
+
+  void recordCompression(size_t uncompressedLength, size_t compressedLength, uint64_t nanoseconds);
+  void recordSkipped();
+  void recordDecompression(uint64_t nanoseconds);
+  Totals getTotals();
+
+ private:
+  Totals totals;
+  uv_mutex_t mutex;
+};
+
+}  // namespace node_gemfire
+
+#endif